@@ -0,0 +1,453 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "benchUtil.h"
+#include "streamGenerators.h"
+#include "microBenchmarks.h"
+
+#include "muxingSettings.h"
+#include "muxingContext.h"
+#include "input/meta/metaFiles.h"
+
+/** \~english
+ * \brief Number of pictures of the generated IGS PNG set.
+ */
+#define BENCH_IGS_NB_PICTURES  8
+
+/* ### Benchmarked streams : ############################################### */
+
+typedef enum {
+  BENCH_TRACK_H264,
+  BENCH_TRACK_AC3,
+  BENCH_TRACK_EAC3,
+  BENCH_TRACK_LPCM,
+  BENCH_TRACK_PGS,
+
+  BENCH_NB_TRACKS
+} BenchTrackId;
+
+static const struct {
+  const char * name;      /**< Run name.                                     */
+  const lbc * filename;   /**< Generated stream filename.                    */
+  const char * codec;     /**< META track codec identifier.                  */
+} benchTracks[BENCH_NB_TRACKS] = {
+  [BENCH_TRACK_H264] = {"h264",  lbc_str("h264.264"),  "V_MPEG4/ISO/AVC"},
+  [BENCH_TRACK_AC3]  = {"ac3",   lbc_str("ac3.ac3"),   "A_AC3"},
+  [BENCH_TRACK_EAC3] = {"eac3",  lbc_str("eac3.ac3"),  "A_AC3"},
+  [BENCH_TRACK_LPCM] = {"lpcm",  lbc_str("lpcm.wav"),  "A_LPCM"},
+  [BENCH_TRACK_PGS]  = {"pgs",   lbc_str("pgs.sup"),   "M_HDMV/PGS"}
+};
+
+/** \~english
+ * \brief Name of the run muxing all the generated streams together.
+ */
+#define BENCH_COMBINED_NAME  "combined"
+
+static lbc * buildTrackPath(
+  const lbc * dir,
+  BenchTrackId id
+)
+{
+  lbc * path;
+
+  if (
+    lbc_asprintf(
+      &path, "%" PRI_LBCS "/%" PRI_LBCS, dir, benchTracks[id].filename
+    ) < 0
+  )
+    LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
+  return path;
+}
+
+static lbc * buildRunPath(
+  const lbc * dir,
+  const char * name,
+  const lbc * extension
+)
+{
+  lbc * path, * convName;
+  int ret;
+
+  if (NULL == (convName = lbc_utf8_convto((unsigned char *) name)))
+    return NULL;
+  ret = lbc_asprintf(
+    &path, "%" PRI_LBCS "/%" PRI_LBCS "%" PRI_LBCS, dir, convName, extension
+  );
+  free(convName);
+
+  if (ret < 0)
+    LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
+  return path;
+}
+
+/* ### Generation : ######################################################## */
+
+static int writeMetaFile(
+  const lbc * dir,
+  const char * name,
+  const bool tracks[BENCH_NB_TRACKS]
+)
+{
+  lbc * metaPath;
+  FILE * fd;
+  unsigned i;
+
+  if (NULL == (metaPath = buildRunPath(dir, name, lbc_str(".meta"))))
+    return -1;
+
+  if (NULL == (fd = lbc_fopen(metaPath, "w"))) {
+    LIBBLU_ERROR(
+      "Unable to create META file '%" PRI_LBCS "', %s (errno: %d).\n",
+      metaPath,
+      strerror(errno),
+      errno
+    );
+    free(metaPath);
+    return -1;
+  }
+  free(metaPath);
+
+  /* Tracks are written in the same directory as the META file, against
+  which paths are resolved. */
+  fprintf(fd, "MUXOPT\n");
+  for (i = 0; i < BENCH_NB_TRACKS; i++) {
+    if (tracks[i])
+      fprintf(
+        fd, "%s, \"%" PRI_LBCS "\"\n",
+        benchTracks[i].codec, benchTracks[i].filename
+      );
+  }
+
+  if (fclose(fd) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Unable to write META file, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+  return 0;
+}
+
+static int generateTrack(
+  const lbc * dir,
+  BenchTrackId id,
+  uint64_t seed
+)
+{
+  LibbluBenchAc3Settings ac3Settings = LIBBLU_BENCH_AC3_DEFAULT_SETTINGS;
+  lbc * path;
+  int ret;
+
+  if (NULL == (path = buildTrackPath(dir, id)))
+    return -1;
+
+  lbc_printf("Generating '%" PRI_LBCS "'...\n", path);
+  fflush(stdout);
+
+  ret = -1;
+  switch (id) {
+    case BENCH_TRACK_H264:
+      ret = writeH264StreamLibbluBench(
+        path, LIBBLU_BENCH_H264_DEFAULT_SETTINGS, seed
+      );
+      break;
+
+    case BENCH_TRACK_AC3:
+      ret = writeAc3StreamLibbluBench(path, ac3Settings, seed);
+      break;
+
+    case BENCH_TRACK_EAC3:
+      ac3Settings.eac3 = true;
+      ret = writeAc3StreamLibbluBench(path, ac3Settings, seed);
+      break;
+
+    case BENCH_TRACK_LPCM:
+      ret = writeLpcmWavLibbluBench(
+        path, LIBBLU_BENCH_LPCM_DEFAULT_SETTINGS, seed
+      );
+      break;
+
+    case BENCH_TRACK_PGS:
+      ret = writePgsSupLibbluBench(
+        path, LIBBLU_BENCH_PGS_DEFAULT_SETTINGS, seed
+      );
+      break;
+
+    case BENCH_NB_TRACKS:
+      break;
+  }
+
+  free(path);
+  return ret;
+}
+
+static int generateIgsPicturesSet(
+  const lbc * dir,
+  uint64_t seed
+)
+{
+  LibbluBenchRandom rand;
+  unsigned i;
+
+  initLibbluBenchRandom(&rand, seed);
+
+  lbc_printf("Generating IGS pictures set...\n");
+  for (i = 0; i < BENCH_IGS_NB_PICTURES; i++) {
+    lbc * path;
+    int ret;
+
+    if (lbc_asprintf(&path, "%" PRI_LBCS "/igs_page_%02u.png", dir, i) < 0)
+      LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+    ret = writePngPictureLibbluBench(
+      path,
+      LIBBLU_BENCH_HDMV_PIC_WIDTH,
+      LIBBLU_BENCH_HDMV_PIC_HEIGHT,
+      &rand
+    );
+    free(path);
+
+    if (ret < 0)
+      return -1;
+  }
+
+  return 0;
+}
+
+static int generateBenchmarkData(
+  const lbc * dir,
+  uint64_t seed
+)
+{
+  bool tracks[BENCH_NB_TRACKS];
+  unsigned i;
+
+  for (i = 0; i < BENCH_NB_TRACKS; i++) {
+    if (generateTrack(dir, i, seed + i) < 0)
+      return -1;
+
+    memset(tracks, 0, sizeof(tracks));
+    tracks[i] = true;
+    if (writeMetaFile(dir, benchTracks[i].name, tracks) < 0)
+      return -1;
+  }
+
+  /* Combined run, using the AC-3 + E-AC-3 stream rather than the AC-3 one. */
+  memset(tracks, 1, sizeof(tracks));
+  tracks[BENCH_TRACK_AC3] = false;
+  if (writeMetaFile(dir, BENCH_COMBINED_NAME, tracks) < 0)
+    return -1;
+
+  return generateIgsPicturesSet(dir, seed + BENCH_NB_TRACKS);
+}
+
+/* ### End-to-end throughput : ############################################# */
+
+static int initMuxBenchmarkSettings(
+  LibbluMuxingSettings * settings,
+  const lbc * metaPath,
+  const lbc * outputPath,
+  bool forceRebuildScripts
+)
+{
+  if (initLibbluMuxingSettings(settings, outputPath, NULL) < 0)
+    return -1;
+  LIBBLU_MUX_SETTINGS_SET_OPTION(
+    settings,
+    forceRebuildScripts,
+    forceRebuildScripts
+  );
+
+  if (parseMetaFile(metaPath, settings) < 0) {
+    cleanLibbluMuxingSettings(*settings);
+    return -1;
+  }
+
+  return 0;
+}
+
+static int runMuxBenchmark(
+  const lbc * dir,
+  const char * name,
+  uint64_t inputSize
+)
+{
+  LibbluMuxingSettings settings;
+  LibbluMuxingContextPtr ctx;
+  BitstreamWriterPtr output;
+  lbc * metaPath, * outputPath;
+  char runName[64];
+  double start, duration;
+
+  ctx = NULL, output = NULL, outputPath = NULL;
+  if (NULL == (metaPath = buildRunPath(dir, name, lbc_str(".meta"))))
+    return -1;
+  if (NULL == (outputPath = buildRunPath(dir, name, lbc_str(".m2ts"))))
+    goto free_return;
+
+  /* Elementary streams parsing and ESMS scripts generation. */
+  if (initMuxBenchmarkSettings(&settings, metaPath, outputPath, true) < 0)
+    goto free_return;
+  settings.options.disableTStdBufVerifier = true;
+
+  start = getTimeLibbluBench();
+  if (NULL == (ctx = createLibbluMuxingContext(settings)))
+    goto free_return;
+  duration = getTimeLibbluBench() - start;
+  destroyLibbluMuxingContext(ctx);
+  ctx = NULL;
+
+  snprintf(runName, sizeof(runName), "esms/%s", name);
+  printResultLibbluBench(runName, 1, duration, inputSize);
+
+  /* Multiplexing, from generated scripts, with T-STD buffer verification. */
+  if (initMuxBenchmarkSettings(&settings, metaPath, outputPath, false) < 0)
+    goto free_return;
+  if (NULL == (ctx = createLibbluMuxingContext(settings)))
+    goto free_return;
+  if (NULL == (output = createNullBitstreamWriter(IO_VBUF_SIZE)))
+    goto free_return;
+
+  start = getTimeLibbluBench();
+  while (dataRemainingLibbluMuxingContext(ctx)) {
+    if (muxNextPacketLibbluMuxingContext(ctx, output) < 0)
+      goto free_return;
+  }
+  duration = getTimeLibbluBench() - start;
+
+  snprintf(runName, sizeof(runName), "mux/%s", name);
+  printMuxResultLibbluBench(
+    runName, duration,
+    ctx->nbBytesWritten,
+    ctx->nbTsPacketsMuxed
+  );
+
+  closeBitstreamWriter(output);
+  destroyLibbluMuxingContext(ctx);
+  free(outputPath);
+  free(metaPath);
+  return 0;
+
+free_return:
+  closeBitstreamWriter(output);
+  destroyLibbluMuxingContext(ctx);
+  free(outputPath);
+  free(metaPath);
+  return -1;
+}
+
+static int getTrackSize(
+  const lbc * dir,
+  BenchTrackId id,
+  uint64_t * size
+)
+{
+  lbc * path;
+  int64_t fileSize;
+  int ret;
+
+  if (NULL == (path = buildTrackPath(dir, id)))
+    return -1;
+  ret = getFileSize(path, &fileSize);
+  free(path);
+
+  if (ret < 0)
+    return -1;
+  *size = (uint64_t) fileSize;
+  return 0;
+}
+
+static int runMuxBenchmarks(
+  const lbc * dir
+)
+{
+  uint64_t size, combinedSize;
+  unsigned i;
+
+  combinedSize = 0;
+  for (i = 0; i < BENCH_NB_TRACKS; i++) {
+    if (getTrackSize(dir, i, &size) < 0)
+      return -1;
+    if (runMuxBenchmark(dir, benchTracks[i].name, size) < 0)
+      return -1;
+    if (BENCH_TRACK_AC3 != i)
+      combinedSize += size;
+  }
+
+  return runMuxBenchmark(dir, BENCH_COMBINED_NAME, combinedSize);
+}
+
+/* ### Main : ############################################################## */
+
+static void printUsage(
+  const char * prgm
+)
+{
+  printf(
+    "Usage: %s <command> <directory> [seed]\n"
+    "\n"
+    "Commands:\n"
+    "  generate  Write synthetic streams, META files and an IGS PNG set.\n"
+    "  micro     Run hot-paths micro-benchmarks (directory is used for\n"
+    "            temporary files).\n"
+    "  mux       Run end-to-end throughput measures on generated streams.\n"
+    "  all       Generate streams then run all benchmarks.\n"
+    "\n"
+    "Supplied directory must exist. Results are printed on stdout.\n",
+    prgm
+  );
+}
+
+int main(
+  int argc,
+  char ** argv
+)
+{
+  const char * command;
+  lbc * dir;
+  uint64_t seed;
+  bool generate, micro, mux;
+  int ret;
+
+  if (argc < 3 || 4 < argc) {
+    printUsage(argv[0]);
+    return -1;
+  }
+
+  command = argv[1];
+  generate = micro = mux = false;
+  if (!strcmp(command, "generate"))
+    generate = true;
+  else if (!strcmp(command, "micro"))
+    micro = true;
+  else if (!strcmp(command, "mux"))
+    mux = true;
+  else if (!strcmp(command, "all"))
+    generate = micro = mux = true;
+  else {
+    printUsage(argv[0]);
+    return -1;
+  }
+
+  seed = LIBBLU_BENCH_DEFAULT_SEED;
+  if (4 == argc)
+    seed = strtoull(argv[3], NULL, 0);
+
+  if (NULL == (dir = lbc_locale_convto(argv[2])))
+    return -1;
+
+  ret = 0;
+  if (generate)
+    ret = generateBenchmarkData(dir, seed);
+  if (0 <= ret && micro)
+    ret = runMicroBenchmarksLibbluBench(dir, seed);
+  if (0 <= ret && mux)
+    ret = runMuxBenchmarks(dir);
+
+  free(dir);
+  return (ret < 0) ? -1 : 0;
+}
@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+
+#include "benchUtil.h"
+
+void fillLibbluBenchRandom(
+  LibbluBenchRandom * rand,
+  uint8_t * dst,
+  size_t size
+)
+{
+  uint64_t value;
+  size_t i;
+
+  for (i = 0; i + 8 <= size; i += 8) {
+    value = nextLibbluBenchRandom(rand);
+    memcpy(&dst[i], &value, 8);
+  }
+  if (i < size) {
+    value = nextLibbluBenchRandom(rand);
+    memcpy(&dst[i], &value, size - i);
+  }
+}
+
+double getTimeLibbluBench(
+  void
+)
+{
+  double time;
+
+  if (lb_get_monotonic_time(&time) < 0)
+    return 0.0;
+  return time;
+}
+
+void printResultLibbluBench(
+  const char * name,
+  uint64_t iterations,
+  double duration,
+  uint64_t bytes
+)
+{
+  double perIteration;
+
+  perIteration = (0 < iterations) ? duration / iterations : 0.0;
+
+  if (0 < bytes && 0.0 < duration)
+    printf(
+      "%-32s %10" PRIu64 " iter %12.3f us/iter %10.2f MB/s\n",
+      name,
+      iterations,
+      perIteration * 1e6,
+      bytes / duration / 1e6
+    );
+  else
+    printf(
+      "%-32s %10" PRIu64 " iter %12.3f us/iter\n",
+      name,
+      iterations,
+      perIteration * 1e6
+    );
+  fflush(stdout);
+}
+
+void printMuxResultLibbluBench(
+  const char * name,
+  double duration,
+  uint64_t bytes,
+  uint64_t nbPackets
+)
+{
+  if (duration <= 0.0)
+    duration = 1e-9;
+
+  printf(
+    "%-32s %10.3f s %10.2f MB/s %12.0f packets/s\n",
+    name,
+    duration,
+    bytes / duration / 1e6,
+    nbPackets / duration
+  );
+  fflush(stdout);
+}
@@ -0,0 +1,121 @@
+/** \~english
+ * \file benchUtil.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Benchmarks common utilities.
+ *
+ * Timing, deterministic pseudo-random generation and results reporting
+ * shared by the stream generators, the micro-benchmarks and the end-to-end
+ * throughput runs.
+ */
+
+#ifndef __LIBBLU_MUXER__BENCH__BENCH_UTIL_H__
+#define __LIBBLU_MUXER__BENCH__BENCH_UTIL_H__
+
+#include "util.h"
+
+/** \~english
+ * \brief Default generators seed, results are reproducible between runs.
+ */
+#define LIBBLU_BENCH_DEFAULT_SEED  0x4C6942426C75ULL
+
+/** \~english
+ * \brief Minimal duration of a micro-benchmark measure in seconds.
+ *
+ * Measured function is repeated until this duration is reached.
+ */
+#define LIBBLU_BENCH_MIN_DURATION  0.5
+
+/* ### Pseudo-random generator : ########################################### */
+
+/** \~english
+ * \brief Deterministic pseudo-random generator (xorshift64*).
+ */
+typedef struct {
+  uint64_t state;
+} LibbluBenchRandom;
+
+static inline void initLibbluBenchRandom(
+  LibbluBenchRandom * rand,
+  uint64_t seed
+)
+{
+  rand->state = (0 != seed) ? seed : LIBBLU_BENCH_DEFAULT_SEED;
+}
+
+static inline uint64_t nextLibbluBenchRandom(
+  LibbluBenchRandom * rand
+)
+{
+  rand->state ^= rand->state >> 12;
+  rand->state ^= rand->state << 25;
+  rand->state ^= rand->state >> 27;
+  return rand->state * 0x2545F4914F6CDD1DULL;
+}
+
+/** \~english
+ * \brief Return a pseudo-random value in range [0, max).
+ */
+static inline uint32_t rangeLibbluBenchRandom(
+  LibbluBenchRandom * rand,
+  uint32_t max
+)
+{
+  return (uint32_t) ((nextLibbluBenchRandom(rand) >> 32) % max);
+}
+
+void fillLibbluBenchRandom(
+  LibbluBenchRandom * rand,
+  uint8_t * dst,
+  size_t size
+);
+
+/* ### Timing : ############################################################ */
+
+/** \~english
+ * \brief Return current monotonic wall-clock time in seconds.
+ *
+ * On failure, a zero value is returned.
+ */
+double getTimeLibbluBench(
+  void
+);
+
+/* ### Results reporting : ################################################# */
+
+/** \~english
+ * \brief Print a benchmark result line.
+ *
+ * \param name Benchmark name.
+ * \param iterations Number of measured iterations.
+ * \param duration Measure duration in seconds.
+ * \param bytes Number of bytes processed by all iterations (or 0).
+ *
+ * Results are printed on stdout as space-separated columns: name,
+ * iterations, duration per iteration and throughput in MB/s.
+ */
+void printResultLibbluBench(
+  const char * name,
+  uint64_t iterations,
+  double duration,
+  uint64_t bytes
+);
+
+/** \~english
+ * \brief Print an end-to-end throughput result line.
+ *
+ * \param name Run name.
+ * \param duration Run duration in seconds.
+ * \param bytes Number of output bytes.
+ * \param nbPackets Number of muxed transport packets.
+ */
+void printMuxResultLibbluBench(
+  const char * name,
+  double duration,
+  uint64_t bytes,
+  uint64_t nbPackets
+);
+
+#endif
@@ -0,0 +1,463 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+
+#include "microBenchmarks.h"
+
+#include "streamHeap.h"
+#include "codec/ac3/ac3_parser.h"
+#include "codec/hdmv/common/hdmv_palette_gen.h"
+#include "tStdVerifier/bdavStd.h"
+#include "streamGenerators.h"
+
+/** \~english
+ * \brief Number of operations performed between two timing checks for
+ * very short operations.
+ */
+#define BENCH_OPS_PER_CHECK  1024
+
+/** \~english
+ * \brief Repeat the following block until the minimal measure duration is
+ * reached.
+ *
+ * \param it Iterations counter (uint64_t).
+ * \param start Measure start time (double).
+ * \param duration Measure duration (double).
+ */
+#define BENCH_LOOP(it, start, duration)                                       \
+  for (                                                                       \
+    it = 0, start = getTimeLibbluBench(), duration = 0.0;                     \
+    duration < LIBBLU_BENCH_MIN_DURATION;                                     \
+    it++, duration = getTimeLibbluBench() - start                             \
+  )
+
+/* ### BitstreamReader : ################################################### */
+
+static int writeReaderBenchFile(
+  const lbc * filepath,
+  LibbluBenchRandom * rand
+)
+{
+  BitstreamWriterPtr output;
+  uint8_t * data;
+
+  if (NULL == (data = (uint8_t *) malloc(LIBBLU_BENCH_READER_FILE_SIZE)))
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  fillLibbluBenchRandom(rand, data, LIBBLU_BENCH_READER_FILE_SIZE);
+
+  if (NULL == (output = createBitstreamWriter(filepath, IO_VBUF_SIZE)))
+    goto free_return;
+  if (writeBytes(output, data, LIBBLU_BENCH_READER_FILE_SIZE) < 0)
+    goto free_return;
+  closeBitstreamWriter(output);
+
+  free(data);
+  return 0;
+
+free_return:
+  closeBitstreamWriter(output);
+  free(data);
+  return -1;
+}
+
+typedef enum {
+  READER_BENCH_BYTES,
+  READER_BENCH_BYTE,
+  READER_BENCH_BITS,
+  READER_BENCH_VALUE
+} ReaderBenchMode;
+
+static int readFileReaderBench(
+  const lbc * filepath,
+  ReaderBenchMode mode
+)
+{
+  static uint8_t chunk[64 * 1024];
+
+  BitstreamReaderPtr input;
+  uint64_t i, nbReads;
+  uint32_t value;
+  uint8_t byte;
+
+  if (NULL == (input = createBitstreamReader(filepath, IO_VBUF_SIZE)))
+    return -1;
+
+  switch (mode) {
+    case READER_BENCH_BYTES:
+      nbReads = LIBBLU_BENCH_READER_FILE_SIZE / sizeof(chunk);
+      for (i = 0; i < nbReads; i++) {
+        if (readBytes(input, chunk, sizeof(chunk)) < 0)
+          goto free_return;
+      }
+      break;
+
+    case READER_BENCH_BYTE:
+      for (i = 0; i < LIBBLU_BENCH_READER_FILE_SIZE; i++) {
+        if (readByte(input, &byte) < 0)
+          goto free_return;
+      }
+      break;
+
+    case READER_BENCH_BITS:
+      /* 13-bit fields, never aligned on bytes boundaries */
+      nbReads = (uint64_t) LIBBLU_BENCH_READER_FILE_SIZE * 8 / 13;
+      for (i = 0; i < nbReads; i++) {
+        if (readBits(input, &value, 13) < 0)
+          goto free_return;
+      }
+      break;
+
+    case READER_BENCH_VALUE:
+      nbReads = LIBBLU_BENCH_READER_FILE_SIZE / 4;
+      for (i = 0; i < nbReads; i++) {
+        if (readValueBigEndian(input, 4, &value) < 0)
+          goto free_return;
+      }
+  }
+
+  closeBitstreamReader(input);
+  return 0;
+
+free_return:
+  closeBitstreamReader(input);
+  return -1;
+}
+
+static int runBitstreamReaderBenchmarks(
+  const lbc * workDir,
+  LibbluBenchRandom * rand
+)
+{
+  static const struct {
+    const char * name;
+    ReaderBenchMode mode;
+  } benchs[] = {
+    {"reader/readBytes(64KiB)",    READER_BENCH_BYTES},
+    {"reader/readByte",            READER_BENCH_BYTE},
+    {"reader/readBits(13)",        READER_BENCH_BITS},
+    {"reader/readValueBigEndian",  READER_BENCH_VALUE}
+  };
+
+  lbc * filepath;
+  uint64_t it;
+  double start, duration;
+  unsigned i;
+
+  if (lbc_asprintf(&filepath, "%" PRI_LBCS "/reader.bin", workDir) < 0)
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  if (writeReaderBenchFile(filepath, rand) < 0)
+    goto free_return;
+
+  for (i = 0; i < ARRAY_SIZE(benchs); i++) {
+    BENCH_LOOP(it, start, duration) {
+      if (readFileReaderBench(filepath, benchs[i].mode) < 0)
+        goto free_return;
+    }
+    printResultLibbluBench(
+      benchs[i].name, it, duration,
+      it * LIBBLU_BENCH_READER_FILE_SIZE
+    );
+  }
+
+  lbc_remove(filepath);
+  free(filepath);
+  return 0;
+
+free_return:
+  lbc_remove(filepath);
+  free(filepath);
+  return -1;
+}
+
+/* ### CRC : ############################################################### */
+
+static int runCrcBenchmarks(
+  LibbluBenchRandom * rand
+)
+{
+  static const struct {
+    const char * name;
+    CrcParam param;
+  } benchs[] = {
+    {"crc/ac3(table)",       AC3_CRC_PARAMS},
+    {"crc/truehd(bitwise)",  TRUE_HD_MAJOR_SYNC_CRC_PARAMS}
+  };
+
+  uint8_t * data;
+  uint64_t it;
+  double start, duration;
+  uint32_t crc;
+  unsigned i;
+  size_t j;
+
+  if (NULL == (data = (uint8_t *) malloc(LIBBLU_BENCH_CRC_BUFFER_SIZE)))
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  fillLibbluBenchRandom(rand, data, LIBBLU_BENCH_CRC_BUFFER_SIZE);
+
+  for (i = 0; i < ARRAY_SIZE(benchs); i++) {
+    CrcContext ctx = {0};
+
+    BENCH_LOOP(it, start, duration) {
+      if (initCrc(&ctx, benchs[i].param, 0) < 0)
+        goto free_return;
+      for (j = 0; j < LIBBLU_BENCH_CRC_BUFFER_SIZE; j++)
+        applyCrc(&ctx, data[j]);
+      endCrc(&ctx, &crc);
+    }
+    printResultLibbluBench(
+      benchs[i].name, it, duration,
+      it * LIBBLU_BENCH_CRC_BUFFER_SIZE
+    );
+  }
+
+  free(data);
+  return 0;
+
+free_return:
+  free(data);
+  return -1;
+}
+
+/* ### StreamHeap : ######################################################## */
+
+static int runStreamHeapBenchmark(
+  LibbluBenchRandom * rand
+)
+{
+  LibbluStream streams[LIBBLU_BENCH_HEAP_NB_STREAMS];
+  StreamHeapPtr heap;
+  uint64_t it;
+  double start, duration;
+  unsigned i;
+
+  if (NULL == (heap = createStreamHeap()))
+    return -1;
+
+  memset(streams, 0, sizeof(streams));
+  for (i = 0; i < LIBBLU_BENCH_HEAP_NB_STREAMS; i++) {
+    StreamHeapTimingInfos timer = {
+      .tsPt = rangeLibbluBenchRandom(rand, 27000),
+      .tsDuration = 1000 + rangeLibbluBenchRandom(rand, 100000)
+    };
+
+    if (addStreamHeap(heap, timer, &streams[i]) < 0)
+      goto free_return;
+  }
+
+  /* One iteration: pop the earliest stream and schedule its next packet */
+  BENCH_LOOP(it, start, duration) {
+    for (i = 0; i < BENCH_OPS_PER_CHECK; i++) {
+      StreamHeapTimingInfos timer;
+      LibbluStreamPtr stream;
+
+      extractStreamHeap(heap, &timer, &stream);
+      incrementTPTimestampStreamHeapTimingInfos(&timer);
+      if (addStreamHeap(heap, timer, stream) < 0)
+        goto free_return;
+    }
+  }
+  printResultLibbluBench(
+    "heap/extract+add(16 streams)",
+    it * BENCH_OPS_PER_CHECK, duration, 0
+  );
+
+  destroyStreamHeap(heap);
+  return 0;
+
+free_return:
+  destroyStreamHeap(heap);
+  return -1;
+}
+
+/* ### Buffering model : ################################################### */
+
+#define BENCH_BUF_MODEL_MUX_RATE  48000000
+#define BENCH_BUF_MODEL_INPUT_RATE  64000
+
+static int runBufferingModelBenchmark(
+  void
+)
+{
+  BufModelBuffersListPtr list;
+  BufModelNode root;
+  uint64_t it, stc, period;
+  double start, duration;
+  unsigned i;
+
+  if (NULL == (list = createBufModelBuffersList()))
+    return -1;
+  root = BUF_MODEL_NEW_NODE();
+
+  if (
+    createSystemBufferingChainBdavStd(
+      list, &root, 0, BENCH_BUF_MODEL_MUX_RATE
+    ) < 0
+  )
+    goto free_return;
+
+  /* System transport packets regularly injected below the leaking rates. */
+  period = MAIN_CLOCK_27MHZ * TP_SIZE * 8 / BENCH_BUF_MODEL_INPUT_RATE;
+  stc = 0;
+
+  BENCH_LOOP(it, start, duration) {
+    for (i = 0; i < BENCH_OPS_PER_CHECK; i++) {
+      stc += period;
+
+      if (
+        !checkBufModel(
+          root, stc, TP_SIZE * 8, BENCH_BUF_MODEL_MUX_RATE, NULL
+        )
+      )
+        LIBBLU_ERROR_FRETURN("Unexpected buffering model overflow.\n");
+      if (
+        addSystemFramesToBdavStd(
+          list, TP_HEADER_SIZE, TP_SIZE - TP_HEADER_SIZE
+        ) < 0
+      )
+        goto free_return;
+      if (
+        updateBufModel(
+          root, stc, TP_SIZE * 8, BENCH_BUF_MODEL_MUX_RATE, NULL
+        ) < 0
+      )
+        goto free_return;
+    }
+  }
+  printResultLibbluBench(
+    "t-std/check+update(TB,B)",
+    it * BENCH_OPS_PER_CHECK, duration, 0
+  );
+
+  destroyBufModel(root);
+  destroyBufModelBuffersList(list);
+  return 0;
+
+free_return:
+  destroyBufModel(root);
+  destroyBufModelBuffersList(list);
+  return -1;
+}
+
+/* ### HDMV pictures : ##################################################### */
+
+static int runHdmvPicturesBenchmarks(
+  LibbluBenchRandom * rand
+)
+{
+  const unsigned width = LIBBLU_BENCH_HDMV_PIC_WIDTH;
+  const unsigned height = LIBBLU_BENCH_HDMV_PIC_HEIGHT;
+  const size_t nbPixels = (size_t) width * height;
+
+  HdmvPicturesListPtr list;
+  HdmvPicturePtr pic;
+  HdmvPaletteDefinitionPtr pal;
+  uint32_t * rgba;
+  uint64_t it;
+  double start, duration;
+
+  pal = NULL;
+  if (NULL == (list = createHdmvPicturesList()))
+    return -1;
+  if (NULL == (rgba = (uint32_t *) malloc(nbPixels * sizeof(uint32_t))))
+    LIBBLU_ERROR_FRETURN("Memory allocation error.\n");
+
+  if (NULL == (pic = createHdmvPicture(0x0, width, height)))
+    goto free_return;
+  if (addHdmvPicturesList(list, pic) < 0) {
+    destroyHdmvPicture(pic);
+    goto free_return;
+  }
+
+  fillRgbaPictureLibbluBench(rgba, width, height, rand);
+  memcpy(getRgbaHandleHdmvPicture(pic), rgba, nbPixels * sizeof(uint32_t));
+
+  /* Colour quantisation (hexatree palette generation) */
+  BENCH_LOOP(it, start, duration) {
+    destroyHdmvPaletteDefinition(pal);
+    if (NULL == (pal = createHdmvPaletteDefinition(0x0)))
+      goto free_return;
+    if (buildPaletteListHdmvPalette(pal, list, 255, NULL) < 0)
+      goto free_return;
+  }
+  printResultLibbluBench(
+    "hdmv/quantisation(255 colours)", it, duration,
+    it * nbPixels * sizeof(uint32_t)
+  );
+
+  /* Palette mapping with Floyd-Steinberg dithering, RGBA data handle
+  request invalidates palletized data, forcing a new pass. */
+  if (setPaletteHdmvPicture(pic, pal, HDMV_PIC_CDM_FLOYD_STEINBERG) < 0)
+    goto free_return;
+  BENCH_LOOP(it, start, duration) {
+    memcpy(getRgbaHandleHdmvPicture(pic), rgba, nbPixels * sizeof(uint32_t));
+    if (NULL == getPalHdmvPicture(pic))
+      goto free_return;
+  }
+  printResultLibbluBench(
+    "hdmv/palette-mapping(dithering)", it, duration,
+    it * nbPixels * sizeof(uint32_t)
+  );
+
+  /* Same using wavefront dithering on all processors */
+  setDitherNbThreadsHdmvPicture(pic, 0);
+  BENCH_LOOP(it, start, duration) {
+    memcpy(getRgbaHandleHdmvPicture(pic), rgba, nbPixels * sizeof(uint32_t));
+    if (NULL == getPalHdmvPicture(pic))
+      goto free_return;
+  }
+  printResultLibbluBench(
+    "hdmv/palette-mapping(wavefront)", it, duration,
+    it * nbPixels * sizeof(uint32_t)
+  );
+
+  /* RLE compression of the palletized picture */
+  BENCH_LOOP(it, start, duration) {
+    getPalHandleHdmvPicture(pic); /* Invalidate RLE data */
+    if (NULL == getRleHdmvPicture(pic))
+      goto free_return;
+  }
+  printResultLibbluBench(
+    "hdmv/rle-compression", it, duration,
+    it * nbPixels
+  );
+
+  destroyHdmvPaletteDefinition(pal);
+  destroyHdmvPicturesList(list);
+  free(rgba);
+  return 0;
+
+free_return:
+  destroyHdmvPaletteDefinition(pal);
+  destroyHdmvPicturesList(list);
+  free(rgba);
+  return -1;
+}
+
+/* ### Micro-benchmarks : ################################################## */
+
+int runMicroBenchmarksLibbluBench(
+  const lbc * workDir,
+  uint64_t seed
+)
+{
+  LibbluBenchRandom rand;
+
+  initLibbluBenchRandom(&rand, seed);
+
+  if (runBitstreamReaderBenchmarks(workDir, &rand) < 0)
+    return -1;
+  if (runCrcBenchmarks(&rand) < 0)
+    return -1;
+  if (runStreamHeapBenchmark(&rand) < 0)
+    return -1;
+  if (runBufferingModelBenchmark() < 0)
+    return -1;
+  if (runHdmvPicturesBenchmarks(&rand) < 0)
+    return -1;
+
+  return 0;
+}
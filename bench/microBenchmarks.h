@@ -0,0 +1,59 @@
+/** \~english
+ * \file microBenchmarks.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Muxer hot-paths micro-benchmarks.
+ *
+ * Each measure repeats the tested operation until
+ * #LIBBLU_BENCH_MIN_DURATION is reached and reports the mean duration of
+ * an iteration and, when relevant, the processed data throughput.
+ */
+
+#ifndef __LIBBLU_MUXER__BENCH__MICRO_BENCHMARKS_H__
+#define __LIBBLU_MUXER__BENCH__MICRO_BENCHMARKS_H__
+
+#include "benchUtil.h"
+
+/** \~english
+ * \brief Size in bytes of the file used by BitstreamReader benchmarks.
+ */
+#define LIBBLU_BENCH_READER_FILE_SIZE  (16 * 1024 * 1024)
+
+/** \~english
+ * \brief Size in bytes of the buffer used by CRC benchmarks.
+ */
+#define LIBBLU_BENCH_CRC_BUFFER_SIZE  (1024 * 1024)
+
+/** \~english
+ * \brief Number of streams in the StreamHeap benchmark.
+ */
+#define LIBBLU_BENCH_HEAP_NB_STREAMS  16
+
+/** \~english
+ * \brief Dimensions of the HDMV pictures used by RLE and quantisation
+ * benchmarks (a typical IGS menu page background).
+ */
+#define LIBBLU_BENCH_HDMV_PIC_WIDTH  960
+#define LIBBLU_BENCH_HDMV_PIC_HEIGHT  540
+
+/** \~english
+ * \brief Run all micro-benchmarks.
+ *
+ * \param workDir Directory used to store temporary files.
+ * \param seed Pseudo-random generator seed.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Measured hot-paths are the BitstreamReader reading functions, the CRC
+ * computation (look-up table and bitwise variants), the StreamHeap
+ * scheduling, the T-STD buffering model update, HDMV pictures colour
+ * quantisation, palette mapping and RLE compression.
+ */
+int runMicroBenchmarksLibbluBench(
+  const lbc * workDir,
+  uint64_t seed
+);
+
+#endif
@@ -0,0 +1,1453 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "streamGenerators.h"
+
+#define GEN_WRITE_BUFFER_SIZE  (1024 * 1024)
+
+/* ### Bits buffer : ####################################################### */
+
+/** \~english
+ * \brief Growable MSB-first bits writing buffer.
+ */
+typedef struct {
+  uint8_t * data;
+  size_t allocatedSize;
+  size_t bitOffset;
+} GenBitsBuffer;
+
+static void initGenBitsBuffer(
+  GenBitsBuffer * buf
+)
+{
+  *buf = (GenBitsBuffer) {0};
+}
+
+static void cleanGenBitsBuffer(
+  GenBitsBuffer * buf
+)
+{
+  free(buf->data);
+}
+
+static void resetGenBitsBuffer(
+  GenBitsBuffer * buf
+)
+{
+  if (NULL != buf->data)
+    memset(buf->data, 0, (buf->bitOffset + 7) >> 3);
+  buf->bitOffset = 0;
+}
+
+static size_t sizeGenBitsBuffer(
+  const GenBitsBuffer * buf
+)
+{
+  return (buf->bitOffset + 7) >> 3;
+}
+
+static int reserveGenBitsBuffer(
+  GenBitsBuffer * buf,
+  size_t nbBits
+)
+{
+  size_t requiredSize, newSize;
+  uint8_t * newData;
+
+  requiredSize = ((buf->bitOffset + nbBits + 7) >> 3);
+  if (requiredSize <= buf->allocatedSize)
+    return 0;
+
+  newSize = MAX(1024, buf->allocatedSize);
+  while (newSize < requiredSize)
+    newSize *= 2;
+
+  if (NULL == (newData = (uint8_t *) realloc(buf->data, newSize)))
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  memset(newData + buf->allocatedSize, 0, newSize - buf->allocatedSize);
+
+  buf->data = newData;
+  buf->allocatedSize = newSize;
+  return 0;
+}
+
+static int putBits(
+  GenBitsBuffer * buf,
+  uint32_t value,
+  unsigned size
+)
+{
+  assert(size <= 32);
+
+  if (reserveGenBitsBuffer(buf, size) < 0)
+    return -1;
+
+  while (0 < size--) {
+    if ((value >> size) & 0x1)
+      buf->data[buf->bitOffset >> 3] |= 0x80 >> (buf->bitOffset & 0x7);
+    buf->bitOffset++;
+  }
+
+  return 0;
+}
+
+static int putBytes(
+  GenBitsBuffer * buf,
+  const uint8_t * data,
+  size_t size
+)
+{
+  size_t i;
+
+  if (0 == (buf->bitOffset & 0x7)) {
+    if (reserveGenBitsBuffer(buf, size * 8) < 0)
+      return -1;
+    memcpy(buf->data + (buf->bitOffset >> 3), data, size);
+    buf->bitOffset += size * 8;
+    return 0;
+  }
+
+  for (i = 0; i < size; i++) {
+    if (putBits(buf, data[i], 8) < 0)
+      return -1;
+  }
+  return 0;
+}
+
+static int putRandomBytes(
+  GenBitsBuffer * buf,
+  size_t size,
+  LibbluBenchRandom * rand
+)
+{
+  uint8_t block[256];
+
+  while (0 < size) {
+    size_t blockSize = MIN(size, sizeof(block));
+
+    fillLibbluBenchRandom(rand, block, blockSize);
+    if (putBytes(buf, block, blockSize) < 0)
+      return -1;
+    size -= blockSize;
+  }
+
+  return 0;
+}
+
+/** \~english
+ * \brief Write an unsigned Exp-Golomb code (ue(v)).
+ */
+static int putUe(
+  GenBitsBuffer * buf,
+  uint32_t value
+)
+{
+  unsigned nbBits;
+  uint32_t codeNum;
+
+  codeNum = value + 1;
+  for (nbBits = 0; (codeNum >> nbBits) > 1; nbBits++)
+    ;
+
+  if (putBits(buf, 0, nbBits) < 0)
+    return -1;
+  return putBits(buf, codeNum, nbBits + 1);
+}
+
+/** \~english
+ * \brief Write a signed Exp-Golomb code (se(v)).
+ */
+static int putSe(
+  GenBitsBuffer * buf,
+  int32_t value
+)
+{
+  if (0 < value)
+    return putUe(buf, 2 * value - 1);
+  return putUe(buf, -2 * value);
+}
+
+/** \~english
+ * \brief Write a stop one bit followed by zero bits up to byte alignment.
+ */
+static int putTrailingBits(
+  GenBitsBuffer * buf
+)
+{
+  if (putBits(buf, 0x1, 1) < 0)
+    return -1;
+  return putBits(buf, 0x0, (8 - (buf->bitOffset & 0x7)) & 0x7);
+}
+
+/* ### H.264 Annex-B : ##################################################### */
+
+#define H264_WIDTH_IN_MBS  120
+#define H264_HEIGHT_IN_MBS  68
+#define H264_NB_MBS  (H264_WIDTH_IN_MBS * H264_HEIGHT_IN_MBS)
+
+#define H264_NUM_UNITS_IN_TICK  1001
+#define H264_TIME_SCALE  48000
+
+#define H264_BIT_RATE  40000000
+#define H264_CPB_SIZE  30000000
+#define H264_INITIAL_CPB_REMOVAL_DELAY  45000  /* 0.5s in 90kHz ticks */
+
+/** \~english
+ * \brief Write a NAL unit with emulation prevention of supplied RBSP.
+ */
+static int writeH264NalUnit(
+  BitstreamWriterPtr output,
+  uint8_t nalRefIdc,
+  uint8_t nalUnitType,
+  const GenBitsBuffer * rbsp
+)
+{
+  static const uint8_t startCode[4] = {0x00, 0x00, 0x00, 0x01};
+  const uint8_t * data;
+  size_t i, start, size;
+  unsigned nbZeros;
+
+  if (writeBytes(output, startCode, 4) < 0)
+    return -1;
+  if (writeByte(output, (nalRefIdc << 5) | nalUnitType) < 0)
+    return -1;
+
+  data = rbsp->data;
+  size = sizeGenBitsBuffer(rbsp);
+  nbZeros = 0;
+
+  for (i = start = 0; i < size; i++) {
+    if (2 <= nbZeros && data[i] <= 0x03) {
+      /* emulation_prevention_three_byte */
+      if (writeBytes(output, &data[start], i - start) < 0)
+        return -1;
+      if (writeByte(output, 0x03) < 0)
+        return -1;
+      start = i;
+      nbZeros = 0;
+    }
+    nbZeros = (0x00 == data[i]) ? nbZeros + 1 : 0;
+  }
+
+  return writeBytes(output, &data[start], size - start);
+}
+
+static int buildH264HrdParameters(
+  GenBitsBuffer * rbsp
+)
+{
+  /* cpb_cnt_minus1 */
+  if (putUe(rbsp, 0) < 0)
+    return -1;
+  /* bit_rate_scale / cpb_size_scale (units of 64 and 16 bits) */
+  if (putBits(rbsp, 0, 4) < 0 || putBits(rbsp, 0, 4) < 0)
+    return -1;
+  /* bit_rate_value_minus1[0] */
+  if (putUe(rbsp, H264_BIT_RATE / 64 - 1) < 0)
+    return -1;
+  /* cpb_size_value_minus1[0] */
+  if (putUe(rbsp, H264_CPB_SIZE / 16 - 1) < 0)
+    return -1;
+  /* cbr_flag[0] */
+  if (putBits(rbsp, 0, 1) < 0)
+    return -1;
+  /* initial_cpb_removal_delay_length_minus1 / cpb_removal_delay_length_minus1
+    / dpb_output_delay_length_minus1 / time_offset_length */
+  if (putBits(rbsp, 23, 5) < 0 || putBits(rbsp, 23, 5) < 0)
+    return -1;
+  if (putBits(rbsp, 23, 5) < 0 || putBits(rbsp, 24, 5) < 0)
+    return -1;
+  return 0;
+}
+
+static int writeH264Sps(
+  BitstreamWriterPtr output,
+  GenBitsBuffer * rbsp
+)
+{
+  resetGenBitsBuffer(rbsp);
+
+  /* profile_idc (High), constraint_set flags, level_idc (4.1) */
+  putBits(rbsp, 100, 8);
+  putBits(rbsp, 0x00, 8);
+  putBits(rbsp, 41, 8);
+  putUe(rbsp, 0);  /* seq_parameter_set_id */
+  putUe(rbsp, 1);  /* chroma_format_idc (4:2:0) */
+  putUe(rbsp, 0);  /* bit_depth_luma_minus8 */
+  putUe(rbsp, 0);  /* bit_depth_chroma_minus8 */
+  putBits(rbsp, 0, 1);  /* qpprime_y_zero_transform_bypass_flag */
+  putBits(rbsp, 0, 1);  /* seq_scaling_matrix_present_flag */
+  putUe(rbsp, 0);  /* log2_max_frame_num_minus4 */
+  putUe(rbsp, 0);  /* pic_order_cnt_type */
+  putUe(rbsp, 4);  /* log2_max_pic_order_cnt_lsb_minus4 */
+  putUe(rbsp, 1);  /* max_num_ref_frames */
+  putBits(rbsp, 0, 1);  /* gaps_in_frame_num_value_allowed_flag */
+  putUe(rbsp, H264_WIDTH_IN_MBS - 1);
+  putUe(rbsp, H264_HEIGHT_IN_MBS - 1);
+  putBits(rbsp, 1, 1);  /* frame_mbs_only_flag */
+  putBits(rbsp, 1, 1);  /* direct_8x8_inference_flag */
+  putBits(rbsp, 1, 1);  /* frame_cropping_flag (1088 -> 1080 lines) */
+  putUe(rbsp, 0);
+  putUe(rbsp, 0);
+  putUe(rbsp, 0);
+  putUe(rbsp, 4);
+  putBits(rbsp, 1, 1);  /* vui_parameters_present_flag */
+
+  /* vui_parameters() */
+  putBits(rbsp, 1, 1);  /* aspect_ratio_info_present_flag */
+  putBits(rbsp, 1, 8);  /* aspect_ratio_idc (1:1) */
+  putBits(rbsp, 0, 1);  /* overscan_info_present_flag */
+  putBits(rbsp, 1, 1);  /* video_signal_type_present_flag */
+  putBits(rbsp, 2, 3);  /* video_format (NTSC) */
+  putBits(rbsp, 0, 1);  /* video_full_range_flag */
+  putBits(rbsp, 1, 1);  /* colour_description_present_flag */
+  putBits(rbsp, 1, 8);  /* colour_primaries (BT.709) */
+  putBits(rbsp, 1, 8);  /* transfer_characteristics (BT.709) */
+  putBits(rbsp, 1, 8);  /* matrix_coefficients (BT.709) */
+  putBits(rbsp, 0, 1);  /* chroma_loc_info_present_flag */
+  putBits(rbsp, 1, 1);  /* timing_info_present_flag */
+  putBits(rbsp, H264_NUM_UNITS_IN_TICK, 32);
+  putBits(rbsp, H264_TIME_SCALE, 32);
+  putBits(rbsp, 1, 1);  /* fixed_frame_rate_flag */
+  putBits(rbsp, 1, 1);  /* nal_hrd_parameters_present_flag */
+  buildH264HrdParameters(rbsp);
+  putBits(rbsp, 0, 1);  /* vcl_hrd_parameters_present_flag */
+  putBits(rbsp, 0, 1);  /* low_delay_hrd_flag */
+  putBits(rbsp, 1, 1);  /* pic_struct_present_flag */
+  putBits(rbsp, 0, 1);  /* bitstream_restriction_flag */
+
+  if (putTrailingBits(rbsp) < 0)
+    return -1;
+  return writeH264NalUnit(output, 3, 7, rbsp);
+}
+
+static int writeH264Pps(
+  BitstreamWriterPtr output,
+  GenBitsBuffer * rbsp
+)
+{
+  resetGenBitsBuffer(rbsp);
+
+  putUe(rbsp, 0);  /* pic_parameter_set_id */
+  putUe(rbsp, 0);  /* seq_parameter_set_id */
+  putBits(rbsp, 1, 1);  /* entropy_coding_mode_flag (CABAC) */
+  putBits(rbsp, 0, 1);  /* bottom_field_pic_order_in_frame_present_flag */
+  putUe(rbsp, 0);  /* num_slice_groups_minus1 */
+  putUe(rbsp, 0);  /* num_ref_idx_l0_default_active_minus1 */
+  putUe(rbsp, 0);  /* num_ref_idx_l1_default_active_minus1 */
+  putBits(rbsp, 0, 1);  /* weighted_pred_flag */
+  putBits(rbsp, 0, 2);  /* weighted_bipred_idc */
+  putSe(rbsp, 0);  /* pic_init_qp_minus26 */
+  putSe(rbsp, 0);  /* pic_init_qs_minus26 */
+  putSe(rbsp, 0);  /* chroma_qp_index_offset */
+  putBits(rbsp, 1, 1);  /* deblocking_filter_control_present_flag */
+  putBits(rbsp, 0, 1);  /* constrained_intra_pred_flag */
+  putBits(rbsp, 0, 1);  /* redundant_pic_cnt_present_flag */
+  putBits(rbsp, 1, 1);  /* transform_8x8_mode_flag */
+  putBits(rbsp, 0, 1);  /* pic_scaling_matrix_present_flag */
+  putSe(rbsp, 0);  /* second_chroma_qp_index_offset */
+
+  if (putTrailingBits(rbsp) < 0)
+    return -1;
+  return writeH264NalUnit(output, 3, 8, rbsp);
+}
+
+static int writeH264Aud(
+  BitstreamWriterPtr output,
+  GenBitsBuffer * rbsp,
+  bool idrPic
+)
+{
+  resetGenBitsBuffer(rbsp);
+
+  putBits(rbsp, (idrPic) ? 0 : 1, 3);  /* primary_pic_type */
+
+  if (putTrailingBits(rbsp) < 0)
+    return -1;
+  return writeH264NalUnit(output, 0, 9, rbsp);
+}
+
+/** \~english
+ * \brief Append a SEI message with supplied payload bits.
+ */
+static int putH264SeiMessage(
+  GenBitsBuffer * rbsp,
+  unsigned payloadType,
+  GenBitsBuffer * payload
+)
+{
+  /* Payload byte alignment (bit_equal_to_one, bit_equal_to_zero) */
+  if (0 != (payload->bitOffset & 0x7)) {
+    if (putTrailingBits(payload) < 0)
+      return -1;
+  }
+
+  if (putBits(rbsp, payloadType, 8) < 0)
+    return -1;
+  if (putBits(rbsp, sizeGenBitsBuffer(payload), 8) < 0)
+    return -1;
+  return putBytes(rbsp, payload->data, sizeGenBitsBuffer(payload));
+}
+
+static int writeH264Sei(
+  BitstreamWriterPtr output,
+  GenBitsBuffer * rbsp,
+  bool bufferingPeriod,
+  uint32_t cpbRemovalDelay
+)
+{
+  GenBitsBuffer payload;
+
+  resetGenBitsBuffer(rbsp);
+  initGenBitsBuffer(&payload);
+
+  if (bufferingPeriod) {
+    /* buffering_period() */
+    putUe(&payload, 0);  /* seq_parameter_set_id */
+    putBits(&payload, H264_INITIAL_CPB_REMOVAL_DELAY, 24);
+    putBits(&payload, 0, 24);  /* initial_cpb_removal_delay_offset */
+
+    if (putH264SeiMessage(rbsp, 0, &payload) < 0)
+      goto free_return;
+    resetGenBitsBuffer(&payload);
+  }
+
+  /* pic_timing() */
+  putBits(&payload, cpbRemovalDelay, 24);
+  putBits(&payload, 0, 24);  /* dpb_output_delay */
+  putBits(&payload, 0, 4);  /* pic_struct (frame) */
+  putBits(&payload, 0, 1);  /* clock_timestamp_flag[0] */
+
+  if (putH264SeiMessage(rbsp, 1, &payload) < 0)
+    goto free_return;
+  cleanGenBitsBuffer(&payload);
+
+  if (putTrailingBits(rbsp) < 0)
+    return -1;
+  return writeH264NalUnit(output, 0, 6, rbsp);
+
+free_return:
+  cleanGenBitsBuffer(&payload);
+  return -1;
+}
+
+static int writeH264Slice(
+  BitstreamWriterPtr output,
+  GenBitsBuffer * rbsp,
+  bool idrPic,
+  unsigned firstMb,
+  unsigned frameIdx,
+  unsigned idrPicId,
+  size_t payloadSize,
+  LibbluBenchRandom * rand
+)
+{
+  resetGenBitsBuffer(rbsp);
+
+  putUe(rbsp, firstMb);  /* first_mb_in_slice */
+  putUe(rbsp, (idrPic) ? 7 : 5);  /* slice_type (I or P, all slices) */
+  putUe(rbsp, 0);  /* pic_parameter_set_id */
+  putBits(rbsp, frameIdx & 0xF, 4);  /* frame_num */
+  if (idrPic)
+    putUe(rbsp, idrPicId);  /* idr_pic_id */
+  putBits(rbsp, (2 * frameIdx) & 0xFF, 8);  /* pic_order_cnt_lsb */
+  if (!idrPic) {
+    putBits(rbsp, 0, 1);  /* num_ref_idx_active_override_flag */
+    putBits(rbsp, 0, 1);  /* ref_pic_list_modification_flag_l0 */
+  }
+
+  /* dec_ref_pic_marking() */
+  if (idrPic) {
+    putBits(rbsp, 0, 1);  /* no_output_of_prior_pics_flag */
+    putBits(rbsp, 0, 1);  /* long_term_reference_flag */
+  }
+  else
+    putBits(rbsp, 0, 1);  /* adaptive_ref_pic_marking_mode_flag */
+  if (!idrPic)
+    putUe(rbsp, 0);  /* cabac_init_idc */
+
+  putSe(rbsp, 0);  /* slice_qp_delta */
+  putUe(rbsp, 0);  /* disable_deblocking_filter_idc */
+  putSe(rbsp, 0);  /* slice_alpha_c0_offset_div2 */
+  putSe(rbsp, 0);  /* slice_beta_offset_div2 */
+
+  /* slice_data(), pseudo-random content */
+  if (putRandomBytes(rbsp, payloadSize, rand) < 0)
+    return -1;
+  if (putTrailingBits(rbsp) < 0)
+    return -1;
+
+  return writeH264NalUnit(output, (idrPic) ? 3 : 2, (idrPic) ? 5 : 1, rbsp);
+}
+
+int writeH264StreamLibbluBench(
+  const lbc * filepath,
+  LibbluBenchH264Settings settings,
+  uint64_t seed
+)
+{
+  BitstreamWriterPtr output;
+  GenBitsBuffer rbsp;
+  LibbluBenchRandom rand;
+  unsigned frameIdx, gopIdx, sliceIdx;
+
+  assert(0 < settings.gopLength);
+  assert(0 < settings.nbSlices && settings.nbSlices <= H264_HEIGHT_IN_MBS);
+  assert(0 < settings.idrFrameSize && 0 < settings.frameSize);
+
+  if (NULL == (output = createBitstreamWriter(filepath, GEN_WRITE_BUFFER_SIZE)))
+    return -1;
+  initGenBitsBuffer(&rbsp);
+  initLibbluBenchRandom(&rand, seed);
+
+  for (gopIdx = 0; gopIdx * settings.gopLength < settings.nbFrames; gopIdx++) {
+    unsigned gopLength = MIN(
+      settings.gopLength,
+      settings.nbFrames - gopIdx * settings.gopLength
+    );
+
+    for (frameIdx = 0; frameIdx < gopLength; frameIdx++) {
+      bool idrPic = (0 == frameIdx);
+      uint32_t cpbRemovalDelay;
+      size_t frameSize;
+
+      /* Delay from the previous buffering period access unit, in ticks */
+      if (idrPic)
+        cpbRemovalDelay = (0 < gopIdx) ? 2 * settings.gopLength : 0;
+      else
+        cpbRemovalDelay = 2 * frameIdx;
+
+      frameSize = (idrPic) ? settings.idrFrameSize : settings.frameSize;
+      frameSize = frameSize * 3 / 4 + rangeLibbluBenchRandom(&rand, frameSize / 2 + 1);
+
+      if (writeH264Aud(output, &rbsp, idrPic) < 0)
+        goto free_return;
+      if (idrPic) {
+        if (writeH264Sps(output, &rbsp) < 0)
+          goto free_return;
+        if (writeH264Pps(output, &rbsp) < 0)
+          goto free_return;
+      }
+      if (writeH264Sei(output, &rbsp, idrPic, cpbRemovalDelay) < 0)
+        goto free_return;
+
+      for (sliceIdx = 0; sliceIdx < settings.nbSlices; sliceIdx++) {
+        int ret = writeH264Slice(
+          output,
+          &rbsp,
+          idrPic,
+          sliceIdx * (H264_NB_MBS / settings.nbSlices),
+          frameIdx,
+          gopIdx & 0xFF,
+          frameSize / settings.nbSlices,
+          &rand
+        );
+        if (ret < 0)
+          goto free_return;
+      }
+    }
+  }
+
+  /* End of sequence NAL unit */
+  resetGenBitsBuffer(&rbsp);
+  if (writeH264NalUnit(output, 0, 10, &rbsp) < 0)
+    goto free_return;
+
+  cleanGenBitsBuffer(&rbsp);
+  closeBitstreamWriter(output);
+  return 0;
+
+free_return:
+  cleanGenBitsBuffer(&rbsp);
+  closeBitstreamWriter(output);
+  LIBBLU_ERROR_RETURN("Unable to generate H.264 stream.\n");
+}
+
+/* ### AC-3 / E-AC-3 : ##################################################### */
+
+#define AC3_FRMSIZECOD_448_KBPS  0x1E
+#define AC3_FRAME_SIZE  1792  /* 448 kbps at 48 kHz, in bytes */
+#define EAC3_FRAME_SIZE  768  /* 192 kbps, 6 audio blocks per frame */
+
+/** \~english
+ * \brief Return AC-3 CRC (x^16 + x^15 + x^2 + 1, no reflection, initial
+ * value 0) of supplied data.
+ */
+static uint16_t computeAc3Crc(
+  const uint8_t * data,
+  size_t size
+)
+{
+  uint32_t crc;
+  size_t i;
+  unsigned j;
+
+  crc = 0;
+  for (i = 0; i < size; i++) {
+    crc ^= (uint32_t) data[i] << 8;
+    for (j = 0; j < 8; j++) {
+      crc <<= 1;
+      if (crc & 0x10000)
+        crc ^= 0x18005;
+    }
+  }
+
+  return crc & 0xFFFF;
+}
+
+/** \~english
+ * \brief Set the 'crc1' word of an AC-3 frame.
+ *
+ * 'crc1' is the first word of the 5/8 of the frame it protects and is
+ * chosen so the CRC of this part is zero. Since the CRC is linear,
+ * contributions of each 'crc1' bit to the CRC of the part are computed and
+ * the GF(2) linear system is solved by Gaussian elimination.
+ */
+static void setAc3FrameCrc1(
+  uint8_t * frame,
+  size_t frameSize
+)
+{
+  uint8_t * part = &frame[2];
+  size_t partSize = frameSize * 5 / 8 - 2;
+  uint32_t rows[16], target, crc1;
+  unsigned bit, col, i;
+
+  /* Contribution of each crc1 bit (column) */
+  part[0] = part[1] = 0x00;
+  target = computeAc3Crc(part, partSize);
+
+  for (bit = 0; bit < 16; bit++) {
+    uint16_t contrib;
+
+    part[0] = (0x8000 >> bit) >> 8;
+    part[1] = (0x8000 >> bit) & 0xFF;
+    contrib = computeAc3Crc(part, partSize) ^ target;
+
+    /* Store as augmented rows: row i holds coefficients of CRC bit i */
+    for (i = 0; i < 16; i++) {
+      if (0 == bit)
+        rows[i] = ((target >> i) & 0x1) << 16;
+      rows[i] |= (uint32_t) ((contrib >> i) & 0x1) << bit;
+    }
+  }
+
+  /* Gaussian elimination */
+  for (col = 0, i = 0; col < 16 && i < 16; col++) {
+    unsigned pivot, k;
+
+    for (pivot = i; pivot < 16 && !((rows[pivot] >> col) & 0x1); pivot++)
+      ;
+    if (16 <= pivot)
+      continue;
+
+    target = rows[pivot], rows[pivot] = rows[i], rows[i] = target;
+    for (k = 0; k < 16; k++) {
+      if (k != i && ((rows[k] >> col) & 0x1))
+        rows[k] ^= rows[i];
+    }
+    i++;
+  }
+
+  crc1 = 0;
+  for (i = 0; i < 16; i++) {
+    unsigned lead;
+
+    for (lead = 0; lead < 16 && !((rows[i] >> lead) & 0x1); lead++)
+      ;
+    if (lead < 16 && ((rows[i] >> 16) & 0x1))
+      crc1 |= 0x8000 >> lead;
+  }
+
+  part[0] = crc1 >> 8;
+  part[1] = crc1 & 0xFF;
+}
+
+/** \~english
+ * \brief Set the final 'crc2' word of an AC-3 frame.
+ *
+ * \param start Offset of the protected part, 'crc2' is placed at the end.
+ */
+static void setAc3FrameCrc2(
+  uint8_t * frame,
+  size_t frameSize,
+  size_t start
+)
+{
+  uint16_t crc2 = computeAc3Crc(&frame[start], frameSize - start - 2);
+
+  frame[frameSize - 2] = crc2 >> 8;
+  frame[frameSize - 1] = crc2 & 0xFF;
+}
+
+static int buildAc3Frame(
+  uint8_t * frame,
+  GenBitsBuffer * bsi,
+  LibbluBenchRandom * rand
+)
+{
+  size_t bsiSize;
+
+  resetGenBitsBuffer(bsi);
+  putBits(bsi, 0x0B77, 16);  /* syncword */
+  putBits(bsi, 0x0000, 16);  /* crc1, set later */
+  putBits(bsi, 0x0, 2);  /* fscod (48 kHz) */
+  putBits(bsi, AC3_FRMSIZECOD_448_KBPS, 6);
+
+  putBits(bsi, 8, 5);  /* bsid */
+  putBits(bsi, 0, 3);  /* bsmod */
+  putBits(bsi, 7, 3);  /* acmod (3/2) */
+  putBits(bsi, 0, 2);  /* cmixlev */
+  putBits(bsi, 0, 2);  /* surmixlev */
+  putBits(bsi, 1, 1);  /* lfeon */
+  putBits(bsi, 27, 5);  /* dialnorm */
+  putBits(bsi, 0, 1);  /* compre */
+  putBits(bsi, 0, 1);  /* langcode */
+  putBits(bsi, 0, 1);  /* audprodie */
+  putBits(bsi, 0, 1);  /* copyrightb */
+  putBits(bsi, 1, 1);  /* origbs */
+  putBits(bsi, 0, 1);  /* timecod1e */
+  putBits(bsi, 0, 1);  /* timecod2e */
+  putBits(bsi, 0, 1);  /* addbsie */
+  if (putBits(bsi, 0, (8 - (bsi->bitOffset & 0x7)) & 0x7) < 0)
+    return -1;
+
+  bsiSize = sizeGenBitsBuffer(bsi);
+  memcpy(frame, bsi->data, bsiSize);
+
+  /* audblk() and auxdata(), pseudo-random content */
+  fillLibbluBenchRandom(rand, &frame[bsiSize], AC3_FRAME_SIZE - bsiSize);
+
+  setAc3FrameCrc1(frame, AC3_FRAME_SIZE);
+  setAc3FrameCrc2(frame, AC3_FRAME_SIZE, AC3_FRAME_SIZE * 5 / 8);
+  return 0;
+}
+
+static int buildEac3DependentFrame(
+  uint8_t * frame,
+  GenBitsBuffer * bsi,
+  LibbluBenchRandom * rand
+)
+{
+  size_t bsiSize;
+
+  resetGenBitsBuffer(bsi);
+  putBits(bsi, 0x0B77, 16);  /* syncword */
+  putBits(bsi, 1, 2);  /* strmtyp (dependent substream) */
+  putBits(bsi, 0, 3);  /* substreamid */
+  putBits(bsi, EAC3_FRAME_SIZE / 2 - 1, 11);  /* frmsiz */
+  putBits(bsi, 0x0, 2);  /* fscod (48 kHz) */
+  putBits(bsi, 0x3, 2);  /* numblkscod (6 blocks) */
+  putBits(bsi, 2, 3);  /* acmod (2/0) */
+  putBits(bsi, 0, 1);  /* lfeon */
+  putBits(bsi, 16, 5);  /* bsid */
+  putBits(bsi, 27, 5);  /* dialnorm */
+  putBits(bsi, 0, 1);  /* compre */
+  putBits(bsi, 1, 1);  /* chanmape */
+  putBits(bsi, 0x0200, 16);  /* chanmap (Lrs/Rrs pair) */
+  putBits(bsi, 0, 1);  /* mixmdate */
+  putBits(bsi, 0, 1);  /* infomdate */
+  putBits(bsi, 0, 1);  /* addbsie */
+  if (putBits(bsi, 0, (8 - (bsi->bitOffset & 0x7)) & 0x7) < 0)
+    return -1;
+
+  bsiSize = sizeGenBitsBuffer(bsi);
+  memcpy(frame, bsi->data, bsiSize);
+  fillLibbluBenchRandom(rand, &frame[bsiSize], EAC3_FRAME_SIZE - bsiSize);
+
+  /* E-AC-3 CRC covers the whole frame after the syncword */
+  setAc3FrameCrc2(frame, EAC3_FRAME_SIZE, 2);
+  return 0;
+}
+
+int writeAc3StreamLibbluBench(
+  const lbc * filepath,
+  LibbluBenchAc3Settings settings,
+  uint64_t seed
+)
+{
+  BitstreamWriterPtr output;
+  GenBitsBuffer bsi;
+  LibbluBenchRandom rand;
+  uint8_t frame[AC3_FRAME_SIZE];
+  unsigned i;
+
+  if (NULL == (output = createBitstreamWriter(filepath, GEN_WRITE_BUFFER_SIZE)))
+    return -1;
+  initGenBitsBuffer(&bsi);
+  initLibbluBenchRandom(&rand, seed);
+
+  for (i = 0; i < settings.nbFrames; i++) {
+    if (buildAc3Frame(frame, &bsi, &rand) < 0)
+      goto free_return;
+    if (writeBytes(output, frame, AC3_FRAME_SIZE) < 0)
+      goto free_return;
+
+    if (settings.eac3) {
+      if (buildEac3DependentFrame(frame, &bsi, &rand) < 0)
+        goto free_return;
+      if (writeBytes(output, frame, EAC3_FRAME_SIZE) < 0)
+        goto free_return;
+    }
+  }
+
+  cleanGenBitsBuffer(&bsi);
+  closeBitstreamWriter(output);
+  return 0;
+
+free_return:
+  cleanGenBitsBuffer(&bsi);
+  closeBitstreamWriter(output);
+  LIBBLU_ERROR_RETURN("Unable to generate AC-3 stream.\n");
+}
+
+/* ### LPCM WAV : ########################################################## */
+
+static int writeUint32LittleEndian(
+  BitstreamWriterPtr output,
+  uint32_t value
+)
+{
+  uint8_t bytes[4] = {
+    value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24
+  };
+
+  return writeBytes(output, bytes, 4);
+}
+
+static int writeUint16LittleEndian(
+  BitstreamWriterPtr output,
+  uint16_t value
+)
+{
+  uint8_t bytes[2] = {value & 0xFF, value >> 8};
+
+  return writeBytes(output, bytes, 2);
+}
+
+int writeLpcmWavLibbluBench(
+  const lbc * filepath,
+  LibbluBenchLpcmSettings settings,
+  uint64_t seed
+)
+{
+  BitstreamWriterPtr output;
+  LibbluBenchRandom rand;
+  uint32_t blockAlign, dataSize;
+  uint64_t nbSamples, i;
+  unsigned ch, byte;
+
+  assert(16 == settings.bitDepth || 24 == settings.bitDepth);
+  assert(0 < settings.nbChannels && settings.nbChannels <= 8);
+
+  blockAlign = settings.nbChannels * settings.bitDepth / 8;
+  nbSamples = (uint64_t) settings.duration * settings.sampleRate;
+  dataSize = nbSamples * blockAlign;
+
+  if (NULL == (output = createBitstreamWriter(filepath, GEN_WRITE_BUFFER_SIZE)))
+    return -1;
+  initLibbluBenchRandom(&rand, seed);
+
+  /* RIFF header and 'fmt ' chunk (WAVE_FORMAT_PCM) */
+  if (writeBytes(output, (uint8_t *) "RIFF", 4) < 0)
+    goto free_return;
+  if (writeUint32LittleEndian(output, 36 + dataSize) < 0)
+    goto free_return;
+  if (writeBytes(output, (uint8_t *) "WAVEfmt ", 8) < 0)
+    goto free_return;
+  if (writeUint32LittleEndian(output, 16) < 0)
+    goto free_return;
+  if (writeUint16LittleEndian(output, 0x0001) < 0)
+    goto free_return;
+  if (writeUint16LittleEndian(output, settings.nbChannels) < 0)
+    goto free_return;
+  if (writeUint32LittleEndian(output, settings.sampleRate) < 0)
+    goto free_return;
+  if (writeUint32LittleEndian(output, settings.sampleRate * blockAlign) < 0)
+    goto free_return;
+  if (writeUint16LittleEndian(output, blockAlign) < 0)
+    goto free_return;
+  if (writeUint16LittleEndian(output, settings.bitDepth) < 0)
+    goto free_return;
+  if (writeBytes(output, (uint8_t *) "data", 4) < 0)
+    goto free_return;
+  if (writeUint32LittleEndian(output, dataSize) < 0)
+    goto free_return;
+
+  /* Samples: per channel triangle wave with a small noise, integer only to
+  remain reproducible. */
+  for (i = 0; i < nbSamples; i++) {
+    for (ch = 0; ch < settings.nbChannels; ch++) {
+      uint32_t period = 100 + 37 * ch;
+      int32_t phase = (int32_t) ((i * 2) % (2 * period)) - (int32_t) period;
+      int32_t sample;
+
+      sample = ((int32_t) period / 2 - ABS(phase)) * (0x3FFFFF / (int32_t) period);
+      sample += (int32_t) rangeLibbluBenchRandom(&rand, 0x1FF) - 0xFF;
+      sample >>= (24 - settings.bitDepth);
+
+      for (byte = 0; byte < settings.bitDepth / 8; byte++) {
+        if (writeByte(output, (sample >> (8 * byte)) & 0xFF) < 0)
+          goto free_return;
+      }
+    }
+  }
+
+  closeBitstreamWriter(output);
+  return 0;
+
+free_return:
+  closeBitstreamWriter(output);
+  LIBBLU_ERROR_RETURN("Unable to generate WAVE file.\n");
+}
+
+/* ### HDMV PGS : ########################################################## */
+
+#define PGS_VIDEO_WIDTH  1920
+#define PGS_VIDEO_HEIGHT  1080
+#define PGS_NB_COLORS  16
+#define PGS_MAX_SEGMENT_SIZE  0xFFFF
+
+/** \~english
+ * \brief HDMV run-length encode a line of palette indexes.
+ */
+static void encodeRleLine(
+  GenBitsBuffer * dst,
+  const uint8_t * line,
+  unsigned width
+)
+{
+  unsigned i, len;
+
+  for (i = 0; i < width; i += len) {
+    uint8_t px = line[i];
+
+    for (len = 1; i + len < width && line[i + len] == px && len < 16383; len++)
+      ;
+
+    if (0 == px) {
+      putBits(dst, 0x00, 8);
+      if (len <= 63)
+        putBits(dst, len, 8);
+      else
+        putBits(dst, 0x4000 | len, 16);
+    }
+    else if (len <= 3) {
+      unsigned j;
+
+      for (j = 0; j < len; j++)
+        putBits(dst, px, 8);
+    }
+    else {
+      putBits(dst, 0x00, 8);
+      if (len <= 63)
+        putBits(dst, 0x80 | len, 8);
+      else
+        putBits(dst, 0xC000 | len, 16);
+      putBits(dst, px, 8);
+    }
+  }
+
+  /* End of line */
+  putBits(dst, 0x0000, 16);
+}
+
+static int writePgsSegmentHeader(
+  BitstreamWriterPtr output,
+  uint32_t pts,
+  uint8_t type,
+  size_t size
+)
+{
+  if (writeBytes(output, (uint8_t *) "PG", 2) < 0)
+    return -1;
+  if (writeUint32(output, pts) < 0)
+    return -1;
+  if (writeUint32(output, 0) < 0) /* DTS, not transmitted */
+    return -1;
+  if (writeByte(output, type) < 0)
+    return -1;
+  return writeUint16(output, size);
+}
+
+static int writePgsSegment(
+  BitstreamWriterPtr output,
+  uint32_t pts,
+  uint8_t type,
+  const GenBitsBuffer * payload
+)
+{
+  size_t size = sizeGenBitsBuffer(payload);
+
+  if (writePgsSegmentHeader(output, pts, type, size) < 0)
+    return -1;
+  if (0 == size)
+    return 0;
+  return writeBytes(output, payload->data, size);
+}
+
+static void buildPgsWds(
+  GenBitsBuffer * seg,
+  LibbluBenchPgsSettings settings
+)
+{
+  resetGenBitsBuffer(seg);
+  putBits(seg, 1, 8);  /* number_of_windows */
+  putBits(seg, 0, 8);  /* window_id */
+  putBits(seg, (PGS_VIDEO_WIDTH - settings.width) / 2, 16);
+  putBits(seg, PGS_VIDEO_HEIGHT - settings.height - 60, 16);
+  putBits(seg, settings.width, 16);
+  putBits(seg, settings.height, 16);
+}
+
+static int writePgsDisplaySet(
+  BitstreamWriterPtr output,
+  LibbluBenchPgsSettings settings,
+  uint32_t pts,
+  unsigned compositionNumber,
+  const GenBitsBuffer * rle,
+  GenBitsBuffer * seg,
+  LibbluBenchRandom * rand
+)
+{
+  const uint8_t * rleData = rle->data;
+  size_t rleSize = sizeGenBitsBuffer(rle);
+  bool first;
+  unsigned i;
+
+  /* PCS, epoch start */
+  resetGenBitsBuffer(seg);
+  putBits(seg, PGS_VIDEO_WIDTH, 16);
+  putBits(seg, PGS_VIDEO_HEIGHT, 16);
+  putBits(seg, 0x10, 8);  /* frame_rate (23.976) */
+  putBits(seg, compositionNumber, 16);
+  putBits(seg, 0x80, 8);  /* composition_state (Epoch Start) */
+  putBits(seg, 0x00, 8);  /* palette_update_flag */
+  putBits(seg, 0, 8);  /* palette_id_ref */
+  putBits(seg, 1, 8);  /* number_of_composition_objects */
+  putBits(seg, 0, 16);  /* object_id_ref */
+  putBits(seg, 0, 8);  /* window_id_ref */
+  putBits(seg, 0x00, 8);  /* object_cropped_flag, forced_on_flag */
+  putBits(seg, (PGS_VIDEO_WIDTH - settings.width) / 2, 16);
+  putBits(seg, PGS_VIDEO_HEIGHT - settings.height - 60, 16);
+  if (writePgsSegment(output, pts, 0x16, seg) < 0)
+    return -1;
+
+  /* WDS */
+  buildPgsWds(seg, settings);
+  if (writePgsSegment(output, pts, 0x17, seg) < 0)
+    return -1;
+
+  /* PDS */
+  resetGenBitsBuffer(seg);
+  putBits(seg, 0, 8);  /* palette_id */
+  putBits(seg, 0, 8);  /* palette_version_number */
+  for (i = 0; i < PGS_NB_COLORS; i++) {
+    putBits(seg, i, 8);  /* palette_entry_id */
+    putBits(seg, 16 + rangeLibbluBenchRandom(rand, 220), 8);  /* Y */
+    putBits(seg, 16 + rangeLibbluBenchRandom(rand, 225), 8);  /* Cr */
+    putBits(seg, 16 + rangeLibbluBenchRandom(rand, 225), 8);  /* Cb */
+    putBits(seg, (0 == i) ? 0x00 : 0xFF, 8);  /* T */
+  }
+  if (writePgsSegment(output, pts, 0x14, seg) < 0)
+    return -1;
+
+  /* ODS, fragmented if required */
+  for (first = true; first || 0 < rleSize; first = false) {
+    size_t headerSize, fragmentSize;
+    bool last;
+
+    headerSize = (first) ? 11 : 4;
+    fragmentSize = MIN(rleSize, PGS_MAX_SEGMENT_SIZE - headerSize);
+    last = (fragmentSize == rleSize);
+
+    resetGenBitsBuffer(seg);
+    putBits(seg, 0, 16);  /* object_id */
+    putBits(seg, 0, 8);  /* object_version_number */
+    putBits(seg, (first ? 0x80 : 0x00) | (last ? 0x40 : 0x00), 8);
+    if (first) {
+      putBits(seg, sizeGenBitsBuffer(rle) + 4, 24);  /* object_data_length */
+      putBits(seg, settings.width, 16);
+      putBits(seg, settings.height, 16);
+    }
+    if (putBytes(seg, rleData, fragmentSize) < 0)
+      return -1;
+    if (writePgsSegment(output, pts, 0x15, seg) < 0)
+      return -1;
+
+    rleData += fragmentSize;
+    rleSize -= fragmentSize;
+  }
+
+  /* END */
+  resetGenBitsBuffer(seg);
+  if (writePgsSegment(output, pts, 0x80, seg) < 0)
+    return -1;
+
+  /* Clearing display set */
+  resetGenBitsBuffer(seg);
+  putBits(seg, PGS_VIDEO_WIDTH, 16);
+  putBits(seg, PGS_VIDEO_HEIGHT, 16);
+  putBits(seg, 0x10, 8);
+  putBits(seg, compositionNumber + 1, 16);
+  putBits(seg, 0x00, 8);  /* composition_state (Normal) */
+  putBits(seg, 0x00, 8);
+  putBits(seg, 0, 8);
+  putBits(seg, 0, 8);  /* number_of_composition_objects */
+  pts += settings.interval / 2;
+  if (writePgsSegment(output, pts, 0x16, seg) < 0)
+    return -1;
+
+  buildPgsWds(seg, settings);
+  if (writePgsSegment(output, pts, 0x17, seg) < 0)
+    return -1;
+
+  resetGenBitsBuffer(seg);
+  return writePgsSegment(output, pts, 0x80, seg);
+}
+
+int writePgsSupLibbluBench(
+  const lbc * filepath,
+  LibbluBenchPgsSettings settings,
+  uint64_t seed
+)
+{
+  BitstreamWriterPtr output;
+  GenBitsBuffer rle, seg;
+  LibbluBenchRandom rand;
+  uint8_t * line;
+  unsigned i, y, x;
+
+  assert(8 <= settings.width && settings.width <= PGS_VIDEO_WIDTH);
+  assert(8 <= settings.height && settings.height <= PGS_VIDEO_HEIGHT - 60);
+
+  if (NULL == (line = (uint8_t *) malloc(settings.width)))
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  if (NULL == (output = createBitstreamWriter(filepath, GEN_WRITE_BUFFER_SIZE))) {
+    free(line);
+    return -1;
+  }
+  initGenBitsBuffer(&rle);
+  initGenBitsBuffer(&seg);
+  initLibbluBenchRandom(&rand, seed);
+
+  for (i = 0; i < settings.nbDisplaySets; i++) {
+    /* Text-like object: random horizontal runs of opaque colours */
+    resetGenBitsBuffer(&rle);
+    for (y = 0; y < settings.height; y++) {
+      for (x = 0; x < settings.width; ) {
+        unsigned len = 1 + rangeLibbluBenchRandom(&rand, 24);
+        uint8_t px = 0;
+
+        if (rangeLibbluBenchRandom(&rand, 2))
+          px = 1 + rangeLibbluBenchRandom(&rand, PGS_NB_COLORS - 1);
+        for (len = MIN(len, settings.width - x); 0 < len; len--)
+          line[x++] = px;
+      }
+      encodeRleLine(&rle, line, settings.width);
+    }
+
+    int ret = writePgsDisplaySet(
+      output,
+      settings,
+      90000 + i * settings.interval,
+      2 * i,
+      &rle,
+      &seg,
+      &rand
+    );
+    if (ret < 0)
+      goto free_return;
+  }
+
+  free(line);
+  cleanGenBitsBuffer(&rle);
+  cleanGenBitsBuffer(&seg);
+  closeBitstreamWriter(output);
+  return 0;
+
+free_return:
+  free(line);
+  cleanGenBitsBuffer(&rle);
+  cleanGenBitsBuffer(&seg);
+  closeBitstreamWriter(output);
+  LIBBLU_ERROR_RETURN("Unable to generate PGS SUP file.\n");
+}
+
+/* ### PNG pictures : ###################################################### */
+
+static uint32_t mixRgba(
+  uint32_t a,
+  uint32_t b,
+  unsigned weight
+)
+{
+  uint32_t result = 0;
+  unsigned shift;
+
+  /* weight in range [0, 256], 256 means b */
+  for (shift = 0; shift < 32; shift += 8) {
+    uint32_t ca = (a >> shift) & 0xFF, cb = (b >> shift) & 0xFF;
+
+    result |= ((ca * (256 - weight) + cb * weight) >> 8) << shift;
+  }
+
+  return result;
+}
+
+void fillRgbaPictureLibbluBench(
+  uint32_t * rgba,
+  unsigned width,
+  unsigned height,
+  LibbluBenchRandom * rand
+)
+{
+  uint32_t topColor, bottomColor;
+  unsigned x, y, i, nbShapes;
+
+  /* Vertical semi-transparent gradient background */
+  topColor = (uint32_t) (nextLibbluBenchRandom(rand) & 0xFFFFFF00) | 0xC0;
+  bottomColor = (uint32_t) (nextLibbluBenchRandom(rand) & 0xFFFFFF00) | 0xE0;
+
+  for (y = 0; y < height; y++) {
+    uint32_t lineColor = mixRgba(topColor, bottomColor, y * 256 / height);
+
+    for (x = 0; x < width; x++)
+      rgba[y * width + x] = lineColor;
+  }
+
+  /* Buttons: rounded boxes with horizontal gradient and soft edges */
+  nbShapes = 3 + rangeLibbluBenchRandom(rand, 4);
+  for (i = 0; i < nbShapes; i++) {
+    unsigned bw = width / 4 + rangeLibbluBenchRandom(rand, width / 3 + 1);
+    unsigned bh = height / 8 + rangeLibbluBenchRandom(rand, height / 4 + 1);
+    unsigned bx = rangeLibbluBenchRandom(rand, width - MIN(bw, width - 1));
+    unsigned by = rangeLibbluBenchRandom(rand, height - MIN(bh, height - 1));
+    uint32_t left = (uint32_t) (nextLibbluBenchRandom(rand) | 0xFF);
+    uint32_t right = (uint32_t) (nextLibbluBenchRandom(rand) | 0xFF);
+    unsigned radius = MIN(bw, bh) / 3 + 1;
+
+    for (y = by; y < MIN(by + bh, height); y++) {
+      for (x = bx; x < MIN(bx + bw, width); x++) {
+        unsigned dx, dy, dist2, r2, weight;
+        uint32_t color;
+
+        /* Distance to rounded corner centre */
+        dx = (x < bx + radius) ? bx + radius - x
+          : (bx + bw - radius <= x) ? x - (bx + bw - radius) + 1 : 0;
+        dy = (y < by + radius) ? by + radius - y
+          : (by + bh - radius <= y) ? y - (by + bh - radius) + 1 : 0;
+        dist2 = dx * dx + dy * dy;
+        r2 = radius * radius;
+
+        if (r2 + 2 * radius < dist2)
+          continue; /* Outside */
+        weight = (dist2 <= r2) ? 256 : 128; /* Anti-aliased edge */
+
+        color = mixRgba(left, right, (x - bx) * 256 / bw);
+        rgba[y * width + x] = mixRgba(rgba[y * width + x], color, weight);
+      }
+    }
+  }
+
+  /* Light noise */
+  for (i = 0; i < width * height; i++) {
+    if (0 == rangeLibbluBenchRandom(rand, 8))
+      rgba[i] ^= (rangeLibbluBenchRandom(rand, 4) << 8);
+  }
+}
+
+void fillLowColoursRgbaPictureLibbluBench(
+  uint32_t * rgba,
+  unsigned width,
+  unsigned height,
+  LibbluBenchRandom * rand
+)
+{
+  uint32_t colours[LIBBLU_BENCH_PNG_NB_COLOURS];
+  unsigned x, y, i, nbShapes;
+
+  /* Background is semi-transparent, shapes are opaque. */
+  colours[0] = (uint32_t) (nextLibbluBenchRandom(rand) & 0xFFFFFF00) | 0xC0;
+  for (i = 1; i < LIBBLU_BENCH_PNG_NB_COLOURS; i++)
+    colours[i] = (uint32_t) (nextLibbluBenchRandom(rand) | 0xFF);
+
+  for (i = 0; i < width * height; i++)
+    rgba[i] = colours[0];
+
+  /* Buttons: flat rounded boxes with a bottom band, hard edges */
+  nbShapes = 3 + rangeLibbluBenchRandom(rand, 4);
+  for (i = 0; i < nbShapes; i++) {
+    unsigned bw = width / 4 + rangeLibbluBenchRandom(rand, width / 3 + 1);
+    unsigned bh = height / 8 + rangeLibbluBenchRandom(rand, height / 4 + 1);
+    unsigned bx = rangeLibbluBenchRandom(rand, width - MIN(bw, width - 1));
+    unsigned by = rangeLibbluBenchRandom(rand, height - MIN(bh, height - 1));
+    uint32_t fill = colours[1 + rangeLibbluBenchRandom(rand, LIBBLU_BENCH_PNG_NB_COLOURS - 1)];
+    uint32_t band = colours[1 + rangeLibbluBenchRandom(rand, LIBBLU_BENCH_PNG_NB_COLOURS - 1)];
+    unsigned radius = MIN(bw, bh) / 3 + 1;
+
+    for (y = by; y < MIN(by + bh, height); y++) {
+      for (x = bx; x < MIN(bx + bw, width); x++) {
+        unsigned dx, dy;
+
+        /* Distance to rounded corner centre */
+        dx = (x < bx + radius) ? bx + radius - x
+          : (bx + bw - radius <= x) ? x - (bx + bw - radius) + 1 : 0;
+        dy = (y < by + radius) ? by + radius - y
+          : (by + bh - radius <= y) ? y - (by + bh - radius) + 1 : 0;
+
+        if (radius * radius < dx * dx + dy * dy)
+          continue; /* Outside */
+        rgba[y * width + x] = (by + bh * 3 / 4 <= y) ? band : fill;
+      }
+    }
+  }
+}
+
+static uint32_t computePngCrc32(
+  uint32_t crc,
+  const uint8_t * data,
+  size_t size
+)
+{
+  static uint32_t table[256];
+  static bool tableInit = false;
+  size_t i;
+
+  if (!tableInit) {
+    uint32_t n, k, c;
+
+    for (n = 0; n < 256; n++) {
+      for (c = n, k = 0; k < 8; k++)
+        c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+      table[n] = c;
+    }
+    tableInit = true;
+  }
+
+  crc = ~crc;
+  for (i = 0; i < size; i++)
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+static int writePngChunk(
+  BitstreamWriterPtr output,
+  const char * type,
+  const uint8_t * data,
+  size_t size
+)
+{
+  uint32_t crc;
+
+  crc = computePngCrc32(0, (const uint8_t *) type, 4);
+  crc = computePngCrc32(crc, data, size);
+
+  if (writeUint32(output, size) < 0)
+    return -1;
+  if (writeBytes(output, (const uint8_t *) type, 4) < 0)
+    return -1;
+  if (0 < size && writeBytes(output, data, size) < 0)
+    return -1;
+  return writeUint32(output, crc);
+}
+
+int writePngPictureLibbluBench(
+  const lbc * filepath,
+  unsigned width,
+  unsigned height,
+  LibbluBenchRandom * rand
+)
+{
+  static const uint8_t signature[8] = {
+    0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'
+  };
+
+  BitstreamWriterPtr output;
+  GenBitsBuffer ihdr, raw, zlib;
+  uint32_t * rgba;
+  uint32_t adlerA, adlerB;
+  size_t off, size;
+  unsigned x, y;
+
+  if (NULL == (rgba = (uint32_t *) malloc(width * height * sizeof(uint32_t))))
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  fillLowColoursRgbaPictureLibbluBench(rgba, width, height, rand);
+
+  initGenBitsBuffer(&ihdr);
+  initGenBitsBuffer(&raw);
+  initGenBitsBuffer(&zlib);
+
+  /* IHDR: 8 bits RGBA, no interlace */
+  putBits(&ihdr, width, 32);
+  putBits(&ihdr, height, 32);
+  putBits(&ihdr, 8, 8);
+  putBits(&ihdr, 6, 8);
+  putBits(&ihdr, 0, 8);
+  putBits(&ihdr, 0, 8);
+  putBits(&ihdr, 0, 8);
+
+  /* Raw scanlines, filter type 0 */
+  for (y = 0; y < height; y++) {
+    putBits(&raw, 0, 8);
+    for (x = 0; x < width; x++)
+      putBits(&raw, rgba[y * width + x], 32);
+  }
+  free(rgba);
+
+  /* zlib stream of deflate stored blocks */
+  putBits(&zlib, 0x7801, 16);
+  size = sizeGenBitsBuffer(&raw);
+  for (off = 0; off < size || 0 == size; ) {
+    size_t blockSize = MIN(size - off, 0xFFFF);
+    bool final = (off + blockSize == size);
+
+    putBits(&zlib, final ? 0x01 : 0x00, 8);
+    putBits(&zlib, (blockSize & 0xFF) << 8 | (blockSize >> 8), 16);
+    putBits(&zlib, (~blockSize & 0xFF) << 8 | ((~blockSize >> 8) & 0xFF), 16);
+    if (putBytes(&zlib, raw.data + off, blockSize) < 0)
+      goto free_return;
+    off += blockSize;
+    if (final)
+      break;
+  }
+
+  adlerA = 1, adlerB = 0;
+  for (off = 0; off < size; off++) {
+    adlerA = (adlerA + raw.data[off]) % 65521;
+    adlerB = (adlerB + adlerA) % 65521;
+  }
+  if (putBits(&zlib, (adlerB << 16) | adlerA, 32) < 0)
+    goto free_return;
+
+  if (NULL == (output = createBitstreamWriter(filepath, GEN_WRITE_BUFFER_SIZE)))
+    goto free_return;
+
+  if (
+    writeBytes(output, signature, 8) < 0
+    || writePngChunk(output, "IHDR", ihdr.data, sizeGenBitsBuffer(&ihdr)) < 0
+    || writePngChunk(output, "IDAT", zlib.data, sizeGenBitsBuffer(&zlib)) < 0
+    || writePngChunk(output, "IEND", NULL, 0) < 0
+  ) {
+    closeBitstreamWriter(output);
+    goto free_return;
+  }
+
+  closeBitstreamWriter(output);
+  cleanGenBitsBuffer(&ihdr);
+  cleanGenBitsBuffer(&raw);
+  cleanGenBitsBuffer(&zlib);
+  return 0;
+
+free_return:
+  cleanGenBitsBuffer(&ihdr);
+  cleanGenBitsBuffer(&raw);
+  cleanGenBitsBuffer(&zlib);
+  LIBBLU_ERROR_RETURN("Unable to generate PNG picture.\n");
+}
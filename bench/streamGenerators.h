@@ -0,0 +1,234 @@
+/** \~english
+ * \file streamGenerators.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Deterministic synthetic streams generators.
+ *
+ * Generated streams are syntactically valid for the muxer parsers (headers,
+ * CRCs, timing) but carry pseudo-random payloads: they are not decodable
+ * and only intended for throughput measurements. For a given seed, the
+ * generated content is identical between runs and platforms.
+ */
+
+#ifndef __LIBBLU_MUXER__BENCH__STREAM_GENERATORS_H__
+#define __LIBBLU_MUXER__BENCH__STREAM_GENERATORS_H__
+
+#include "benchUtil.h"
+
+/* ### H.264 Annex-B : ##################################################### */
+
+/** \~english
+ * \brief H.264 1080p23.976 High profile stream generation settings.
+ */
+typedef struct {
+  unsigned nbFrames;    /**< Number of generated frames.                    */
+  unsigned gopLength;   /**< Number of frames per GOP (IDR period).         */
+  unsigned nbSlices;    /**< Number of slices per picture.                  */
+  size_t idrFrameSize;  /**< Mean IDR picture slices payload size in bytes. */
+  size_t frameSize;     /**< Mean P picture slices payload size in bytes.   */
+} LibbluBenchH264Settings;
+
+#define LIBBLU_BENCH_H264_DEFAULT_SETTINGS                                    \
+  (LibbluBenchH264Settings) {                                                 \
+    .nbFrames = 1440,                                                         \
+    .gopLength = 24,                                                          \
+    .nbSlices = 4,                                                            \
+    .idrFrameSize = 120000,                                                   \
+    .frameSize = 30000                                                        \
+  }
+
+/** \~english
+ * \brief Write a synthetic H.264 Annex-B stream.
+ *
+ * \param filepath Output filename.
+ * \param settings Stream settings.
+ * \param seed Pseudo-random generator seed.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Each access unit is composed of an AUD, SPS and PPS (on IDR pictures),
+ * buffering period (on IDR pictures) and picture timing SEI messages and
+ * slices of I (IDR) or P pictures, without B pictures.
+ */
+int writeH264StreamLibbluBench(
+  const lbc * filepath,
+  LibbluBenchH264Settings settings,
+  uint64_t seed
+);
+
+/* ### AC-3 / E-AC-3 : ##################################################### */
+
+/** \~english
+ * \brief AC-3 stream generation settings.
+ */
+typedef struct {
+  unsigned nbFrames;  /**< Number of generated sync frames (32 ms each).    */
+  bool eac3;          /**< Follow each 5.1 AC-3 core frame by an E-AC-3
+    dependent substream frame carrying two extra channels (7.1).            */
+} LibbluBenchAc3Settings;
+
+#define LIBBLU_BENCH_AC3_DEFAULT_SETTINGS                                     \
+  (LibbluBenchAc3Settings) {                                                  \
+    .nbFrames = 1875,                                                         \
+    .eac3 = false                                                             \
+  }
+
+/** \~english
+ * \brief Write a synthetic 48 kHz 448 kbps AC-3 (or AC-3 + E-AC-3) stream.
+ *
+ * \param filepath Output filename.
+ * \param settings Stream settings.
+ * \param seed Pseudo-random generator seed.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int writeAc3StreamLibbluBench(
+  const lbc * filepath,
+  LibbluBenchAc3Settings settings,
+  uint64_t seed
+);
+
+/* ### LPCM WAV : ########################################################## */
+
+/** \~english
+ * \brief LPCM WAVE file generation settings.
+ */
+typedef struct {
+  unsigned duration;      /**< Duration in seconds.                         */
+  unsigned sampleRate;    /**< Sample rate in Hz (48000, 96000 or 192000).  */
+  unsigned bitDepth;      /**< Bit depth (16 or 24).                        */
+  unsigned nbChannels;    /**< Number of channels (1 to 8).                 */
+} LibbluBenchLpcmSettings;
+
+#define LIBBLU_BENCH_LPCM_DEFAULT_SETTINGS                                    \
+  (LibbluBenchLpcmSettings) {                                                 \
+    .duration = 60,                                                           \
+    .sampleRate = 48000,                                                      \
+    .bitDepth = 24,                                                           \
+    .nbChannels = 2                                                           \
+  }
+
+/** \~english
+ * \brief Write a synthetic LPCM WAVE file.
+ *
+ * \param filepath Output filename.
+ * \param settings File settings.
+ * \param seed Pseudo-random generator seed.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int writeLpcmWavLibbluBench(
+  const lbc * filepath,
+  LibbluBenchLpcmSettings settings,
+  uint64_t seed
+);
+
+/* ### HDMV PGS : ########################################################## */
+
+/** \~english
+ * \brief PGS SUP file generation settings.
+ */
+typedef struct {
+  unsigned nbDisplaySets;  /**< Number of displayed subtitles.              */
+  unsigned width;          /**< Subtitle object width in pixels.            */
+  unsigned height;         /**< Subtitle object height in pixels.           */
+  unsigned interval;       /**< Interval between subtitles in 90 kHz
+    ticks.                                                                  */
+} LibbluBenchPgsSettings;
+
+#define LIBBLU_BENCH_PGS_DEFAULT_SETTINGS                                     \
+  (LibbluBenchPgsSettings) {                                                  \
+    .nbDisplaySets = 30,                                                      \
+    .width = 960,                                                             \
+    .height = 120,                                                            \
+    .interval = 2 * 90000                                                     \
+  }
+
+/** \~english
+ * \brief Write a synthetic 1080p PGS SUP file.
+ *
+ * \param filepath Output filename.
+ * \param settings File settings.
+ * \param seed Pseudo-random generator seed.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Each subtitle is an epoch start display set presenting a single RLE
+ * object, followed by a clearing display set.
+ */
+int writePgsSupLibbluBench(
+  const lbc * filepath,
+  LibbluBenchPgsSettings settings,
+  uint64_t seed
+);
+
+/* ### PNG pictures : ###################################################### */
+
+/** \~english
+ * \brief Fill a RGBA picture with synthetic menu-like content.
+ *
+ * \param rgba Destination RGBA (0xRRGGBBAA) pixels array.
+ * \param width Picture width in pixels.
+ * \param height Picture height in pixels.
+ * \param rand Pseudo-random generator.
+ *
+ * Content is made of gradients, flat anti-aliased shapes and a little
+ * noise, giving several hundreds of distinct colours to quantise.
+ */
+void fillRgbaPictureLibbluBench(
+  uint32_t * rgba,
+  unsigned width,
+  unsigned height,
+  LibbluBenchRandom * rand
+);
+
+/** \~english
+ * \brief Number of distinct colours of generated PNG pictures.
+ *
+ * Kept low enough for all the pictures of an IGS page to fit in a single
+ * HDMV palette.
+ */
+#define LIBBLU_BENCH_PNG_NB_COLOURS  16
+
+/** \~english
+ * \brief Fill a RGBA picture with synthetic low colours menu-like content.
+ *
+ * \param rgba Destination RGBA (0xRRGGBBAA) pixels array.
+ * \param width Picture width in pixels.
+ * \param height Picture height in pixels.
+ * \param rand Pseudo-random generator.
+ *
+ * Content is made of flat shapes without anti-aliasing, using at most
+ * #LIBBLU_BENCH_PNG_NB_COLOURS distinct colours.
+ */
+void fillLowColoursRgbaPictureLibbluBench(
+  uint32_t * rgba,
+  unsigned width,
+  unsigned height,
+  LibbluBenchRandom * rand
+);
+
+/** \~english
+ * \brief Write a synthetic RGBA PNG picture.
+ *
+ * \param filepath Output filename.
+ * \param width Picture width in pixels.
+ * \param height Picture height in pixels.
+ * \param rand Pseudo-random generator.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Picture content is generated by fillLowColoursRgbaPictureLibbluBench(),
+ * allowing its use as IGS compiler input. Image data is stored
+ * uncompressed (deflate stored blocks), no zlib dependency is required.
+ */
+int writePngPictureLibbluBench(
+  const lbc * filepath,
+  unsigned width,
+  unsigned height,
+  LibbluBenchRandom * rand
+);
+
+#endif
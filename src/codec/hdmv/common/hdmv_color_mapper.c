@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "hdmv_color_mapper.h"
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+/** \~english
+ * \brief Channel value of padding entries.
+ *
+ * Chosen to be farther from any 8-bit channel value than any real entry,
+ * while keeping squared distances in 32-bit range.
+ */
+#define HDMV_COLOR_MAPPER_PADDING_VALUE  1024
+
+HdmvColorMapperPtr createHdmvColorMapper(
+  const HdmvPaletteDefinition * pal
+)
+{
+  HdmvColorMapperPtr mapper;
+  unsigned i;
+
+  assert(NULL != pal);
+  assert(0 < pal->nbUsedEntries);
+
+  mapper = (HdmvColorMapperPtr) malloc(sizeof(HdmvColorMapper));
+  if (NULL == mapper)
+    LIBBLU_HDMV_PIC_ERROR_NRETURN("Memory allocation error.\n");
+
+  mapper->pal = pal;
+  mapper->nbEntries = (
+    (pal->nbUsedEntries + HDMV_COLOR_MAPPER_NB_LANES - 1)
+    / HDMV_COLOR_MAPPER_NB_LANES
+  ) * HDMV_COLOR_MAPPER_NB_LANES;
+
+  for (i = 0; i < mapper->nbEntries; i++) {
+    int16_t r, g, b, a;
+
+    if (i < pal->nbUsedEntries) {
+      uint32_t rgba = pal->entries[i].rgba;
+
+      r = (int16_t) GET_CHANNEL(rgba, C_R);
+      g = (int16_t) GET_CHANNEL(rgba, C_G);
+      b = (int16_t) GET_CHANNEL(rgba, C_B);
+      a = (int16_t) GET_CHANNEL(rgba, C_A);
+    }
+    else
+      r = g = b = a = HDMV_COLOR_MAPPER_PADDING_VALUE;
+
+    mapper->rg[2*i] = r;
+    mapper->rg[2*i+1] = g;
+    mapper->ba[2*i] = b;
+    mapper->ba[2*i+1] = a;
+  }
+
+  for (i = 0; i < ARRAY_SIZE(mapper->cache); i++)
+    mapper->cache[i].index = -1;
+
+  return mapper;
+}
+
+#if defined(__SSE2__)
+
+static unsigned searchNearestColorHdmvColorMapper(
+  const HdmvColorMapperPtr mapper,
+  uint32_t rgba
+)
+{
+  int32_t laneDists[HDMV_COLOR_MAPPER_NB_LANES];
+  int32_t laneIdxs[HDMV_COLOR_MAPPER_NB_LANES];
+  __m128i srcRg, srcBa, minDists, minIdxs, idxs, step;
+  unsigned i, selectedIdx;
+  int32_t minDist;
+
+  /* Source channels, replicated for each lane */
+  srcRg = _mm_set1_epi32(
+    (int) (GET_CHANNEL(rgba, C_G) << 16 | GET_CHANNEL(rgba, C_R))
+  );
+  srcBa = _mm_set1_epi32(
+    (int) (GET_CHANNEL(rgba, C_A) << 16 | GET_CHANNEL(rgba, C_B))
+  );
+
+  minDists = _mm_set1_epi32(INT32_MAX);
+  minIdxs = _mm_setzero_si128();
+  idxs = _mm_set_epi32(3, 2, 1, 0);
+  step = _mm_set1_epi32(HDMV_COLOR_MAPPER_NB_LANES);
+
+  for (i = 0; i < mapper->nbEntries; i += HDMV_COLOR_MAPPER_NB_LANES) {
+    __m128i diffRg, diffBa, dists, closer;
+
+    diffRg = _mm_sub_epi16(
+      _mm_loadu_si128((const __m128i *) &mapper->rg[2*i]),
+      srcRg
+    );
+    diffBa = _mm_sub_epi16(
+      _mm_loadu_si128((const __m128i *) &mapper->ba[2*i]),
+      srcBa
+    );
+
+    /* dR^2 + dG^2 + dB^2 + dA^2 of four entries */
+    dists = _mm_add_epi32(
+      _mm_madd_epi16(diffRg, diffRg),
+      _mm_madd_epi16(diffBa, diffBa)
+    );
+
+    /* Keep strictly closer entries, first ones being favored */
+    closer = _mm_cmplt_epi32(dists, minDists);
+    minDists = _mm_or_si128(
+      _mm_and_si128(closer, dists),
+      _mm_andnot_si128(closer, minDists)
+    );
+    minIdxs = _mm_or_si128(
+      _mm_and_si128(closer, idxs),
+      _mm_andnot_si128(closer, minIdxs)
+    );
+    idxs = _mm_add_epi32(idxs, step);
+  }
+
+  _mm_storeu_si128((__m128i *) laneDists, minDists);
+  _mm_storeu_si128((__m128i *) laneIdxs, minIdxs);
+
+  minDist = laneDists[0];
+  selectedIdx = (unsigned) laneIdxs[0];
+  for (i = 1; i < HDMV_COLOR_MAPPER_NB_LANES; i++) {
+    if (
+      laneDists[i] < minDist
+      || (laneDists[i] == minDist && (unsigned) laneIdxs[i] < selectedIdx)
+    ) {
+      minDist = laneDists[i];
+      selectedIdx = (unsigned) laneIdxs[i];
+    }
+  }
+
+  return selectedIdx;
+}
+
+#else
+
+static unsigned searchNearestColorHdmvColorMapper(
+  const HdmvColorMapperPtr mapper,
+  uint32_t rgba
+)
+{
+  int s_r, s_g, s_b, s_a;
+  int minDist;
+  unsigned i, selectedIdx;
+
+  s_r = (int) GET_CHANNEL(rgba, C_R);
+  s_g = (int) GET_CHANNEL(rgba, C_G);
+  s_b = (int) GET_CHANNEL(rgba, C_B);
+  s_a = (int) GET_CHANNEL(rgba, C_A);
+
+  minDist = INT_MAX;
+  selectedIdx = 0;
+
+  for (i = 0; i < mapper->nbEntries; i++) {
+    int dist_r, dist_g, dist_b, dist_a, dist;
+
+    dist_r = mapper->rg[2*i] - s_r;
+    dist_g = mapper->rg[2*i+1] - s_g;
+    dist_b = mapper->ba[2*i] - s_b;
+    dist_a = mapper->ba[2*i+1] - s_a;
+
+    dist =
+      dist_r * dist_r
+      + dist_g * dist_g
+      + dist_b * dist_b
+      + dist_a * dist_a
+    ;
+
+    if (dist < minDist) {
+      minDist = dist;
+      selectedIdx = i;
+    }
+  }
+
+  return selectedIdx;
+}
+
+#endif
+
+unsigned findNearestColorHdmvColorMapper(
+  HdmvColorMapperPtr mapper,
+  uint32_t rgba,
+  IntRgba * quantError
+)
+{
+  HdmvColorMapperCacheEntry * entry;
+  unsigned selectedIdx;
+
+  assert(NULL != mapper);
+
+  /* Fibonacci hashing of the color value */
+  entry = &mapper->cache[
+    (rgba * UINT32_C(0x9E3779B1)) >> (32 - HDMV_COLOR_MAPPER_CACHE_SIZE_LOG2)
+  ];
+
+  if (0 <= entry->index && entry->rgba == rgba)
+    selectedIdx = (unsigned) entry->index;
+  else {
+    selectedIdx = searchNearestColorHdmvColorMapper(mapper, rgba);
+    assert(selectedIdx < mapper->pal->nbUsedEntries);
+
+    entry->rgba = rgba;
+    entry->index = (int16_t) selectedIdx;
+  }
+
+  if (NULL != quantError) {
+    uint32_t pal_rgba = mapper->pal->entries[selectedIdx].rgba;
+
+    *quantError = (IntRgba) {
+      .r = (int) GET_CHANNEL(rgba, C_R) - (int) GET_CHANNEL(pal_rgba, C_R),
+      .g = (int) GET_CHANNEL(rgba, C_G) - (int) GET_CHANNEL(pal_rgba, C_G),
+      .b = (int) GET_CHANNEL(rgba, C_B) - (int) GET_CHANNEL(pal_rgba, C_B),
+      .a = (int) GET_CHANNEL(rgba, C_A) - (int) GET_CHANNEL(pal_rgba, C_A)
+    };
+  }
+
+  return selectedIdx;
+}
@@ -0,0 +1,95 @@
+/** \~english
+ * \file hdmv_color_mapper.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief HDMV palette nearest color lookup module.
+ *
+ * A color mapper is built from a palette before mapping pictures pixels
+ * on it. Palette entries channels are stored interleaved as 16-bit
+ * integers, allowing to compute the squared distance to several entries
+ * at once (using SSE2 when available), and already mapped colors are
+ * memoized in a direct-mapped cache.
+ *
+ * A mapper is not shared between threads, each mapping process shall
+ * use its own.
+ */
+
+#ifndef __LIBBLU_MUXER__CODECS__HDMV__COMMON__COLOR_MAPPER_H__
+#define __LIBBLU_MUXER__CODECS__HDMV__COMMON__COLOR_MAPPER_H__
+
+#include "hdmv_error.h"
+#include "hdmv_palette_def.h"
+#include "hdmv_color.h"
+
+/** \~english
+ * \brief Number of palette entries compared per distance kernel iteration.
+ *
+ * Palette entries are padded to a multiple of this value.
+ */
+#define HDMV_COLOR_MAPPER_NB_LANES  4
+
+/** \~english
+ * \brief Color mapper cache size, expressed as a power of two.
+ */
+#define HDMV_COLOR_MAPPER_CACHE_SIZE_LOG2  12
+
+typedef struct {
+  uint32_t rgba;  /**< Cached RGBA value.                                    */
+  int16_t index;  /**< Nearest palette entry index, -1 if unused.            */
+} HdmvColorMapperCacheEntry;
+
+typedef struct {
+  const HdmvPaletteDefinition * pal;  /**< Mapped palette.                  */
+  unsigned nbEntries;                 /**< Padded number of entries.        */
+
+  int16_t rg[2 * HDMV_PAL_SIZE];  /**< Interleaved red and green channels.  */
+  int16_t ba[2 * HDMV_PAL_SIZE];  /**< Interleaved blue and alpha channels. */
+
+  HdmvColorMapperCacheEntry cache[1 << HDMV_COLOR_MAPPER_CACHE_SIZE_LOG2];
+} HdmvColorMapper, *HdmvColorMapperPtr;
+
+/* ###### Creation / Destruction : ######################################### */
+
+/** \~english
+ * \brief Create a color mapper on supplied palette.
+ *
+ * \param pal Mapped palette, shall contain at least one entry and must not
+ * be modified during mapper lifetime.
+ * \return HdmvColorMapperPtr Upon success, created object is returned.
+ * Otherwise, a NULL pointer is returned.
+ */
+HdmvColorMapperPtr createHdmvColorMapper(
+  const HdmvPaletteDefinition * pal
+);
+
+static inline void destroyHdmvColorMapper(
+  HdmvColorMapperPtr mapper
+)
+{
+  free(mapper);
+}
+
+/* ###### Operations : ##################################################### */
+
+/** \~english
+ * \brief Return the index of the palette entry nearest to given color.
+ *
+ * \param mapper Used color mapper.
+ * \param rgba Color to map.
+ * \param quantError Optional quantization error output, difference
+ * between supplied color and selected entry.
+ * \return unsigned Selected palette entry index.
+ *
+ * Distance is the squared euclidean distance between RGBA components. If
+ * several entries are equally distant, the one with the lowest index is
+ * selected.
+ */
+unsigned findNearestColorHdmvColorMapper(
+  HdmvColorMapperPtr mapper,
+  uint32_t rgba,
+  IntRgba * quantError
+);
+
+#endif
@@ -8,6 +8,29 @@
 
 #include "hdmv_common.h"
 
+#if !defined(DISABLE_INI)
+#  include "../../../ini/iniHandler.h"
+#endif
+
+unsigned getNbThreadsFromIniHdmv(
+  IniFileContextPtr conf
+)
+{
+  lbc * str;
+  unsigned nbThreads;
+
+  if (NULL == conf)
+    return 0; /* Default, use all available processors */
+
+  if (NULL == (str = lookupIniFile(conf, "HDMV.THREADS")))
+    return 0;
+
+  if (lbc_sscanf(str, "%u", &nbThreads) != 1)
+    return 0;
+
+  return nbThreads;
+}
+
 uint64_t computeHdmvOdsDecodeDuration(
   HdmvODataParameters param,
   HdmvStreamType type
@@ -153,11 +176,19 @@ HdmvSequencePtr getHdmvSequenceHdmvSegmentsInventory(
 )
 {
   HdmvSequencePtr seq;
+  uint8_t * fragments;
+  size_t fragmentsAllocatedLen;
 
   GET_HDMV_SEGMENTS_INVENTORY_POOL(seq, HdmvSequence *, &inv->sequences);
   if (NULL == seq)
     return NULL;
+
+  /* Keep fragments buffer of a sequence reused after inventory reset. */
+  fragments = seq->fragments;
+  fragmentsAllocatedLen = seq->fragmentsAllocatedLen;
   initHdmvSequence(seq);
+  seq->fragments = fragments;
+  seq->fragmentsAllocatedLen = fragmentsAllocatedLen;
 
   return seq;
 }
@@ -2321,17 +2352,19 @@ int decodeHdmvPaletteEntry(
   const unsigned i
 )
 {
-  uint32_t value;
+  uint8_t entry[5];
 
   assert(NULL != hdmvInput);
   assert(NULL != param);
 
   LIBBLU_HDMV_COM_DEBUG("   Palette_entry(%u): ", i);
 
-  /* [u8 palette_entry_id] */
-  if (readValueBigEndian(hdmvInput, 1, &value) < 0)
+  /* Fixed-length entry, fetched at once. */
+  if (readBytes(hdmvInput, entry, 5) < 0)
     return -1;
-  param->palette_entry_id = value & 0xFF;
+
+  /* [u8 palette_entry_id] */
+  param->palette_entry_id = entry[0];
 
   LIBBLU_HDMV_COM_DEBUG_NH(
     "palette_entry_id=%03u (0x%02X), ",
@@ -2339,9 +2372,7 @@ int decodeHdmvPaletteEntry(
   );
 
   /* [u8 Y_value] */
-  if (readValueBigEndian(hdmvInput, 1, &value) < 0)
-    return -1;
-  param->y_value = value & 0xFF;
+  param->y_value = entry[1];
 
   LIBBLU_HDMV_COM_DEBUG_NH(
     "Y=%03u (0x%02X), ",
@@ -2349,9 +2380,7 @@ int decodeHdmvPaletteEntry(
   );
 
   /* [u8 Cr_value] */
-  if (readValueBigEndian(hdmvInput, 1, &value) < 0)
-    return -1;
-  param->cr_value = value & 0xFF;
+  param->cr_value = entry[2];
 
   LIBBLU_HDMV_COM_DEBUG_NH(
     "Cr=%03u (0x%02X), ",
@@ -2359,9 +2388,7 @@ int decodeHdmvPaletteEntry(
   );
 
   /* [u8 Cb_value] */
-  if (readValueBigEndian(hdmvInput, 1, &value) < 0)
-    return -1;
-  param->cb_value = value & 0xFF;
+  param->cb_value = entry[3];
 
   LIBBLU_HDMV_COM_DEBUG_NH(
     "Cb=%03u (0x%02X), ",
@@ -2369,9 +2396,7 @@ int decodeHdmvPaletteEntry(
   );
 
   /* [u8 T_value] */
-  if (readValueBigEndian(hdmvInput, 1, &value) < 0)
-    return -1;
-  param->t_value = value & 0xFF;
+  param->t_value = entry[4];
 
   LIBBLU_HDMV_COM_DEBUG_NH(
     "T=%03u (0x%02X);\n",
@@ -2556,7 +2581,7 @@ int decodeHdmvOdsSegment(
 {
   HdmvOdsSegmentParameters * param;
   HdmvSequencePtr seq;
-  size_t dataFragmentLength;
+  size_t dataFragmentLength, storedLength;
   int64_t startOffset;
 
   assert(NULL != hdmvInput);
@@ -2588,9 +2613,23 @@ int decodeHdmvOdsSegment(
 
   /* Object_data_fragment() */
   dataFragmentLength = seg.length - (tellPos(hdmvInput) - startOffset);
+
+  /**
+   * Only the object_data() header is decoded, encoded_data_string() bytes
+   * are not copied since the muxing script references segments payload
+   * by input file offset.
+   */
+  storedLength = 0;
+  if (seq->fragmentsUsedLen < HDMV_OBJECT_DATA_HEADER_LENGTH)
+    storedLength = MIN(
+      dataFragmentLength,
+      HDMV_OBJECT_DATA_HEADER_LENGTH - seq->fragmentsUsedLen
+    );
+
   if (
-    readHdmvDataFragment(
-      hdmvInput, dataFragmentLength,
+    0 < storedLength
+    && readHdmvDataFragment(
+      hdmvInput, storedLength,
       &seq->fragments,
       &seq->fragmentsAllocatedLen,
       &seq->fragmentsUsedLen
@@ -2598,10 +2637,17 @@ int decodeHdmvOdsSegment(
   )
     return -1;
 
+  if (skipBytes(hdmvInput, dataFragmentLength - storedLength) < 0)
+    return -1;
+
   if (isLastInSequenceHdmvSDParameters(&param->sequence_descriptor)) {
     /* Decode complete segment data. */
+    if (seq->fragmentsUsedLen < HDMV_OBJECT_DATA_HEADER_LENGTH)
+      LIBBLU_HDMV_COM_ERROR_RETURN(
+        "Object_data() is too short to be decoded.\n"
+      );
 
-    /* Interactive_composition_data() */
+    /* Object_data() */
     if (
       decodeHdmvObjectData(
         seq->fragments,
@@ -2653,17 +2699,21 @@ int parseHdmvSegmentDescriptor(
   BitstreamReaderPtr hdmvInput, HdmvSegmentParameters * param
 )
 {
-  uint32_t value;
+  uint8_t header[HDMV_SEGMENT_HEADER_LENGTH];
+  uint8_t value;
 
   assert(NULL != hdmvInput);
   assert(NULL != param);
 
   param->inputFileOffset = tellPos(hdmvInput);
 
-  /* [u8 segment_type] */
-  if (readValueBigEndian(hdmvInput, 1, &value) < 0)
+  /* Fixed-length descriptor, fetched at once. */
+  if (readBytes(hdmvInput, header, HDMV_SEGMENT_HEADER_LENGTH) < 0)
     return -1;
 
+  /* [u8 segment_type] */
+  value = header[0];
+
   LIBBLU_HDMV_COM_DEBUG("0x%08" PRIX64 ": %s.\n", param->inputFileOffset, HdmvSegmentTypeStr(value));
   LIBBLU_HDMV_COM_DEBUG(" Segment_descriptor():\n");
   LIBBLU_HDMV_COM_DEBUG("  segment_type: %s (0x%" PRIx8 ").\n", HdmvSegmentTypeStr(value), value);
@@ -2686,9 +2736,7 @@ int parseHdmvSegmentDescriptor(
   }
 
   /* [u16 segment_length] */
-  if (readValueBigEndian(hdmvInput, 2, &value) < 0)
-    return -1;
-  param->length = value;
+  param->length = (header[1] << 8) | header[2];
 
   LIBBLU_HDMV_COM_DEBUG(
     "  segment_length: %" PRIu16 " bytes (0x%" PRIx16 ").\n",
@@ -14,6 +14,7 @@
 #include "hdmv_data.h"
 #include "../../../util.h"
 #include "../../../esms/scriptCreation.h"
+#include "../../../ini/iniData.h"
 
 #define ALLOC_SEQ_INCREMENT           32
 #define ALLOC_SEG_INCREMENT           10
@@ -27,6 +28,17 @@
 #define ALLOC_MEM_BLK_IDX_INCREMENT    2
 #define ALLOC_PAL_ENTRY_INCREMENT    128
 
+/** \~english
+ * \brief Return the number of worker threads used by HDMV processings.
+ *
+ * \param conf Configuration file handle, may be NULL.
+ * \return unsigned Number of threads set by 'HDMV.THREADS' configuration
+ * option, or zero if undefined (use all available processors).
+ */
+unsigned getNbThreadsFromIniHdmv(
+  IniFileContextPtr conf
+);
+
 typedef struct HdmvSegment {
   struct HdmvSegment * nextSegment;
   struct HdmvSegment * lastSegment;
@@ -118,6 +130,7 @@ static inline void resetHdmvSegmentsInventoryPool(
 )
 {
   pool->usedElementsSegments = 0;
+  pool->remainingElements = 0;
 }
 
 /* ### HDMV Segments Inventory : ########################################### */
@@ -25,6 +25,7 @@
 
 #define IGS_MNU_WORD             0x4947 /* "IG" */
 #define IGS_SUP_WORD             0x5047 /* "PG" */
+#define PGS_SUP_HEADER_LENGTH    0xA
 
 #define IGS_MAX_NB_SEG_ICS       1
 #define IGS_MAX_NB_SEG_PDS       256
@@ -781,6 +782,16 @@ static inline size_t computeSizeHdmvObjectData(
   return 3 + param.object_data_length;
 }
 
+/** \~english
+ * \brief Size in bytes of the object_data() fixed-length header.
+ *
+ * Made of object_data_length, object_width and object_height fields. Only
+ * these bytes are kept in memory while parsing Object Definition Segments,
+ * remaining encoded_data_string() bytes are referenced by their input file
+ * offset.
+ */
+#define HDMV_OBJECT_DATA_HEADER_LENGTH 0x7
+
 typedef struct {
   HdmvODParameters object_descriptor;
   HdmvSDParameters sequence_descriptor;
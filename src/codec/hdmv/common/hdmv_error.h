@@ -121,6 +121,9 @@
 #define LIBBLU_HDMV_IGS_COMPL_ERROR_BRETURN(format, ...)                      \
   LIBBLU_ERROR_BRETURN(LIBBLU_HDMV_IGS_COMPL_PREFIX format, ##__VA_ARGS__)
 
+#define LIBBLU_HDMV_IGS_COMPL_WARNING(format, ...)                            \
+  LIBBLU_WARNING(LIBBLU_HDMV_IGS_COMPL_PREFIX format, ##__VA_ARGS__)
+
 #define LIBBLU_HDMV_IGS_COMPL_INFO(format, ...)                               \
   LIBBLU_INFO(LIBBLU_HDMV_IGS_COMPL_PREFIX format, ##__VA_ARGS__)
 
@@ -237,6 +240,9 @@
 #define LIBBLU_HDMV_PIC_ERROR_BRETURN(format, ...)                            \
   LIBBLU_ERROR_BRETURN(LIBBLU_HDMV_PIC_PREFIX format, ##__VA_ARGS__)
 
+#define LIBBLU_HDMV_PIC_WARNING(format, ...)                                  \
+  LIBBLU_WARNING(LIBBLU_HDMV_PIC_PREFIX format, ##__VA_ARGS__)
+
 #define LIBBLU_HDMV_PIC_DEBUG(format, ...)                                    \
   LIBBLU_DEBUG(                                                               \
     LIBBLU_DEBUG_HDMV_PICTURES,                                               \
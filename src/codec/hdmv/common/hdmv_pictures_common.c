@@ -10,6 +10,10 @@
 
 #include "hdmv_pictures_common.h"
 
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
 /* ### HDMV Picture infos : ################################################ */
 
 static bool checkPictureDimensions(
@@ -71,13 +75,17 @@ static int allocateRle(
   size_t size
 )
 {
+  uint8_t * newRle;
+
   if (!size) {
     *dst = NULL;
     return 0;
   }
 
-  if (NULL == (*dst = (uint8_t *) malloc(size)))
+  /* On failure, previous buffer is kept and released with the picture */
+  if (NULL == (newRle = (uint8_t *) realloc(*dst, size)))
     LIBBLU_HDMV_PIC_ERROR_RETURN("Memory allocation error.\n");
+  *dst = newRle;
   return 0;
 }
 
@@ -90,11 +98,10 @@ HdmvPicturePtr createHdmvPicture(
 )
 {
   HdmvPicturePtr pic;
-  size_t picSize, rleSize;
+  size_t picSize;
 
   if (!checkPictureDimensions(width, height))
     return NULL;
-  rleSize = maxRleSize(width, height);
   picSize = width * height;
 
   pic = (HdmvPicturePtr) malloc(sizeof(HdmvPicture));
@@ -106,8 +113,8 @@ HdmvPicturePtr createHdmvPicture(
       .version = version,
       .width = width,
       .height = height,
-      .imgAllocatedSize = picSize,
-      .rleAllocatedSize = rleSize
+      .ditherNbThreads = 1,
+      .imgAllocatedSize = picSize
     }
   };
 
@@ -115,8 +122,7 @@ HdmvPicturePtr createHdmvPicture(
     goto free_return;
   if (allocatePal(&pic->pal, picSize) < 0)
     goto free_return;
-  if (allocateRle(&pic->rle, rleSize) < 0)
-    goto free_return;
+  /* RLE data is allocated on compression */
 
   return pic;
 
@@ -134,8 +140,6 @@ HdmvPicturePtr dupHdmvPicture(
   unsigned width, height;
 
   size_t size;
-  const uint32_t * rgba;
-  const uint8_t * palRle;
 
   /* Create a new picture */
   getVersionHdmvPicture(pic, &version);
@@ -143,26 +147,36 @@ HdmvPicturePtr dupHdmvPicture(
   if (NULL == (dst = createHdmvPicture(version, width, height)))
     return NULL;
 
-  /* Duplicate RGBA data */
-  if (NULL == (rgba = getRgbaHdmvPicture(pic)))
-    goto free_return;
-  if (0 < (size = getRgbaSizeHdmvPicture(pic)))
-    memcpy(pic->rgba, rgba, size * sizeof(uint32_t));
-  dst->updatedRgba = true;
+  dst->infos.linkedPal = pic->infos.linkedPal;
+  dst->infos.ditherMeth = pic->infos.ditherMeth;
+  dst->infos.ditherNbThreads = pic->infos.ditherNbThreads;
 
-  /* Duplicate palette data */
-  if (NULL == (palRle = getPalHdmvPicture(pic)))
-    goto free_return;
-  if (0 < (size = getPalSizeHdmvPicture(pic)))
-    memcpy(pic->pal, palRle, size);
-  dst->updatedPal = true;
+  /* Duplicate up to date data only, nothing is computed */
+  if (pic->updatedRgba) {
+    if (0 < (size = getRgbaSizeHdmvPicture(pic)))
+      memcpy(dst->rgba, pic->rgba, size * sizeof(uint32_t));
+    dst->updatedRgba = true;
+  }
 
-  /* Duplicate RLE data */
-  if (NULL == (palRle = getRleHdmvPicture(pic)))
-    goto free_return;
-  if (0 < (size = getRleSizeHdmvPicture(pic)))
-    memcpy(pic->rle, palRle, size);
-  dst->updatedRle = true;
+  if (pic->updatedPal) {
+    if (0 < (size = getPalSizeHdmvPicture(pic)))
+      memcpy(dst->pal, pic->pal, size);
+    dst->updatedPal = true;
+  }
+
+  if (pic->updatedRle) {
+    if (0 < (size = pic->infos.rleUsedSize)) {
+      if (allocateRle(&dst->rle, size) < 0)
+        goto free_return;
+      memcpy(dst->rle, pic->rle, size);
+      dst->infos.rleAllocatedSize = size;
+    }
+    dst->infos.rleUsedSize = size;
+    dst->updatedRle = true;
+  }
+
+  if (!dst->updatedRgba && !dst->updatedPal && !dst->updatedRle)
+    LIBBLU_HDMV_PIC_ERROR_FRETURN("Unable to duplicate an empty picture.\n");
 
   return dst;
 
@@ -292,247 +306,374 @@ static int updatePalFromRleHdmvPicture(
 
 /* ############ Color picking : ############################################ */
 
-#define GET_MAX_DIST  false
-
-static unsigned findNearestColorHdmvPaletteDefinition(
-  const HdmvPaletteDefinitionPtr pal,
-  uint32_t rgba,
-  IntRgba * quantError
+static void updatePalFromRgbaNoDitheringHdmvPicture(
+  HdmvPicturePtr pic,
+  HdmvColorMapperPtr mapper
 )
 {
-  uint32_t pal_rgba;
-  int s_r, s_g, s_b, s_a;
-  size_t i;
-
-#if GET_MAX_DIST
-  int maxDist_rgba = 0;
-#endif
-  int minDist_rgba = INT_MAX;
-  unsigned selectedIdx = 0;
-
-  assert(NULL != pal);
-  assert(0 < pal->nbUsedEntries);
-
-  s_r = (int) GET_CHANNEL(rgba, C_R);
-  s_g = (int) GET_CHANNEL(rgba, C_G);
-  s_b = (int) GET_CHANNEL(rgba, C_B);
-  s_a = (int) GET_CHANNEL(rgba, C_A);
-
-  for (i = 0; i < pal->nbUsedEntries; i++) {
-    int dist_r, dist_g, dist_b, dist_a, dist_rgba;
-    int p_r, p_g, p_b, p_a;
-
-    pal_rgba = pal->entries[i].rgba;
-    p_r = (int) GET_CHANNEL(pal_rgba, C_R);
-    p_g = (int) GET_CHANNEL(pal_rgba, C_G);
-    p_b = (int) GET_CHANNEL(pal_rgba, C_B);
-    p_a = (int) GET_CHANNEL(pal_rgba, C_A);
-
-    dist_r = abs(s_r - p_r);
-    dist_g = abs(s_g - p_g);
-    dist_b = abs(s_b - p_b);
-    dist_a = abs(s_a - p_a);
-
-    dist_rgba =
-      (dist_r * dist_r)
-      + (dist_g * dist_g)
-      + (dist_b * dist_b)
-      + (dist_a * dist_a)
-    ;
-
-#if GET_MAX_DIST
-    if (maxDist_rgba < dist_rgba)
-      maxDist_rgba = dist_rgba;
-#endif
-
-    if (dist_rgba < minDist_rgba) {
-      minDist_rgba = dist_rgba;
-      selectedIdx = i;
+  unsigned i, j;
 
-      if (pal_rgba == rgba)
-        break; /* Exact color found */
+  LIBBLU_HDMV_PIC_DEBUG("  Using no dithering.\n");
+  for (j = 0; j < pic->infos.height; j++) {
+    for (i = 0; i < pic->infos.width; i++) {
+      pic->pal[j * pic->infos.width + i] =
+        findNearestColorHdmvColorMapper(
+          mapper,
+          pic->rgba[j * pic->infos.width + i],
+          NULL
+        )
+      ;
     }
   }
+}
 
-  /* LIBBLU_IGS_COMPL_QUANT_DEBUG("Min color error distance: %d.\n", minDist_rgba); */
-#if GET_MAX_DIST
-  /* LIBBLU_IGS_COMPL_QUANT_DEBUG("Max color error distance: %d.\n", maxDist_rgba); */
-#endif
+/* ############ Floyd-Steinberg dithering : ################################ */
+
+/** \~english
+ * \brief Floyd-Steinberg dithering context.
+ *
+ * Diffused quantization errors are applied on a working copy of the
+ * picture RGBA data, source pixels are kept untouched. Sequential dithering
+ * uses a two rows circular buffer (current and next row), while wavefront
+ * dithering works on a copy of the whole picture, each row being processed
+ * by a task trailing the previous row progression.
+ */
+typedef struct {
+  HdmvPicturePtr pic;
+  HdmvColorMapperPtr mapper;  /**< Sequential mode shared color mapper.     */
 
-  pal_rgba = pal->entries[selectedIdx].rgba;
-  if (NULL != quantError) {
-    *quantError = (IntRgba) {
-      .r = s_r - (int) GET_CHANNEL(pal_rgba, C_R),
-      .g = s_g - (int) GET_CHANNEL(pal_rgba, C_G),
-      .b = s_b - (int) GET_CHANNEL(pal_rgba, C_B),
-      .a = s_a - (int) GET_CHANNEL(pal_rgba, C_A)
-    };
-  }
+  uint32_t * work;            /**< Working RGBA rows.                       */
+  unsigned nbWorkRows;        /**< Number of rows in working buffer.        */
+
+  bool wavefront;             /**< Wavefront parallel mode.                 */
+  TasksPoolProgress progress; /**< Wavefront mode rows progression.         */
+} HdmvPictureDitheringContext;
 
-  return selectedIdx;
+/** \~english
+ * \brief Number of pixels processed between two row progression reports in
+ * wavefront dithering mode.
+ */
+#define HDMV_PIC_DITHERING_WAVEFRONT_STEP  32
+
+static uint32_t * getRowDitheringContext(
+  HdmvPictureDitheringContext * ctx,
+  unsigned row
+)
+{
+  return &ctx->work[(row % ctx->nbWorkRows) * ctx->pic->infos.width];
 }
 
-static void computeCoeffFloydSteinberg(
-  IntRgba * res,
-  float div,
+#if defined(__SSE2__)
+
+/** \~english
+ * \brief Round to nearest, ties to even, signed 16-bit values divided by 16.
+ *
+ * Equivalent to former floating-point computation
+ * nearbyintf(weight / 16.0f * error).
+ */
+static inline __m128i roundErrorsFloydSteinberg(
+  __m128i weightedErrors
+)
+{
+  __m128i bias = _mm_add_epi16(
+    _mm_set1_epi16(7),
+    _mm_and_si128(_mm_srai_epi16(weightedErrors, 4), _mm_set1_epi16(1))
+  );
+
+  return _mm_srai_epi16(_mm_add_epi16(weightedErrors, bias), 4);
+}
+
+static void diffuseErrorFloydSteinberg(
+  uint32_t * curRow,
+  uint32_t * nextRow,
+  unsigned x,
   IntRgba quantError
 )
 {
-  res->r = (int) nearbyintf(div * quantError.r);
-  res->g = (int) nearbyintf(div * quantError.g);
-  res->b = (int) nearbyintf(div * quantError.b);
-  res->a = (int) nearbyintf(div * quantError.a);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i errors, neighbours, diffused;
+
+  /* Quantization error channels, duplicated for two neighbours */
+  errors = _mm_set_epi16(
+    quantError.a, quantError.b, quantError.g, quantError.r,
+    quantError.a, quantError.b, quantError.g, quantError.r
+  );
+
+  /* (x+1, y) 7/16 and (x-1, y+1) 3/16 */
+  neighbours = _mm_unpacklo_epi8(
+    _mm_set_epi32(0, 0, (int) nextRow[x-1], (int) curRow[x+1]),
+    zero
+  );
+  diffused = _mm_packus_epi16( /* Saturation clips channels in 0-255 */
+    _mm_add_epi16(
+      neighbours,
+      roundErrorsFloydSteinberg(
+        _mm_mullo_epi16(errors, _mm_set_epi16(3, 3, 3, 3, 7, 7, 7, 7))
+      )
+    ),
+    zero
+  );
+  curRow[x+1] = (uint32_t) _mm_cvtsi128_si32(diffused);
+  nextRow[x-1] = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(diffused, 4));
+
+  /* (x, y+1) 5/16 and (x+1, y+1) 1/16 */
+  neighbours = _mm_unpacklo_epi8(
+    _mm_loadl_epi64((const __m128i *) &nextRow[x]),
+    zero
+  );
+  diffused = _mm_packus_epi16(
+    _mm_add_epi16(
+      neighbours,
+      roundErrorsFloydSteinberg(
+        _mm_mullo_epi16(errors, _mm_set_epi16(1, 1, 1, 1, 5, 5, 5, 5))
+      )
+    ),
+    zero
+  );
+  _mm_storel_epi64((__m128i *) &nextRow[x], diffused);
+}
+
+#else
+
+/** \~english
+ * \brief Round to nearest, ties to even, a signed value divided by 16.
+ *
+ * Equivalent to former floating-point computation
+ * nearbyintf(weight / 16.0f * error).
+ */
+static inline int roundErrorFloydSteinberg(
+  int weightedError
+)
+{
+  return (weightedError + 7 + ((weightedError >> 4) & 1)) >> 4;
 }
 
-static uint32_t applyCoeffErrorFloydSteinberg(
+static uint32_t applyErrorFloydSteinberg(
   uint32_t rgba,
-  IntRgba coeffs
+  IntRgba quantError,
+  int weight
 )
 {
   uint32_t ret;
+  int r, g, b, a;
+
+  r = (int) GET_CHANNEL(rgba, C_R) + roundErrorFloydSteinberg(weight * quantError.r);
+  g = (int) GET_CHANNEL(rgba, C_G) + roundErrorFloydSteinberg(weight * quantError.g);
+  b = (int) GET_CHANNEL(rgba, C_B) + roundErrorFloydSteinberg(weight * quantError.b);
+  a = (int) GET_CHANNEL(rgba, C_A) + roundErrorFloydSteinberg(weight * quantError.a);
 
-  ret  = CHANNEL_VALUE(CLIP_UINT8((int) GET_CHANNEL(rgba, C_R) + coeffs.r), C_R);
-  ret |= CHANNEL_VALUE(CLIP_UINT8((int) GET_CHANNEL(rgba, C_G) + coeffs.g), C_G);
-  ret |= CHANNEL_VALUE(CLIP_UINT8((int) GET_CHANNEL(rgba, C_B) + coeffs.b), C_B);
-  ret |= CHANNEL_VALUE(CLIP_UINT8((int) GET_CHANNEL(rgba, C_A) + coeffs.a), C_A);
+  ret  = CHANNEL_VALUE(CLIP_UINT8(r), C_R);
+  ret |= CHANNEL_VALUE(CLIP_UINT8(g), C_G);
+  ret |= CHANNEL_VALUE(CLIP_UINT8(b), C_B);
+  ret |= CHANNEL_VALUE(CLIP_UINT8(a), C_A);
 
   return ret;
 }
 
-void applyFloydSteinberg(
-  uint32_t * rgba,
+static void diffuseErrorFloydSteinberg(
+  uint32_t * curRow,
+  uint32_t * nextRow,
   unsigned x,
-  unsigned y,
-  unsigned width,
   IntRgba quantError
 )
 {
-  uint32_t * px;
-  IntRgba coeff;
-
   /* (x+1, y) 7/16 */
-  px = &rgba[y*width + x+1];
-  computeCoeffFloydSteinberg(&coeff, 7.0f / 16.0f, quantError);
-  *px = applyCoeffErrorFloydSteinberg(*px, coeff);
-
+  curRow[x+1] = applyErrorFloydSteinberg(curRow[x+1], quantError, 7);
   /* (x-1, y+1) 3/16 */
-  px = &rgba[(y+1)*width + x-1];
-  computeCoeffFloydSteinberg(&coeff, 3.0f / 16.0f, quantError);
-  *px = applyCoeffErrorFloydSteinberg(*px, coeff);
-
+  nextRow[x-1] = applyErrorFloydSteinberg(nextRow[x-1], quantError, 3);
   /* (x, y+1) 5/16 */
-  px = &rgba[(y+1)*width + x];
-  computeCoeffFloydSteinberg(&coeff, 5.0f / 16.0f, quantError);
-  *px = applyCoeffErrorFloydSteinberg(*px, coeff);
-
+  nextRow[x] = applyErrorFloydSteinberg(nextRow[x], quantError, 5);
   /* (x+1, y+1) 1/16 */
-  px = &rgba[(y+1)*width + x+1];
-  computeCoeffFloydSteinberg(&coeff, 1.0f / 16.0f, quantError);
-  *px = applyCoeffErrorFloydSteinberg(*px, coeff);
+  nextRow[x+1] = applyErrorFloydSteinberg(nextRow[x+1], quantError, 1);
 }
 
-static void updatePalFromRgbaNoDitheringHdmvPicture(
-  HdmvPicturePtr pic
+#endif
+
+static void ditherRowFloydSteinbergHdmvPicture(
+  HdmvPictureDitheringContext * ctx,
+  HdmvColorMapperPtr mapper,
+  unsigned row
 )
 {
-  unsigned i, j;
+  const unsigned width = ctx->pic->infos.width;
+  const unsigned height = ctx->pic->infos.height;
 
-  LIBBLU_HDMV_PIC_DEBUG("  Using no dithering.\n");
-  for (j = 0; j < pic->infos.height; j++) {
-    for (i = 0; i < pic->infos.width; i++) {
-      pic->pal[j * pic->infos.width + i] =
-        findNearestColorHdmvPaletteDefinition(
-          pic->infos.linkedPal,
-          pic->rgba[j * pic->infos.width + i],
-          NULL
-        )
-      ;
+  uint32_t * curRow, * nextRow;
+  uint8_t * dstRow;
+  unsigned i, prevRowProgress;
+
+  curRow = getRowDitheringContext(ctx, row);
+  dstRow = &ctx->pic->pal[row * width];
+
+  /* In wavefront mode, previous row is completed unless first row */
+  prevRowProgress = (ctx->wavefront && 0 < row) ? 0 : width;
+
+  if (row + 1 < height) {
+    nextRow = getRowDitheringContext(ctx, row + 1);
+    if (!ctx->wavefront) /* Load next row in circular buffer */
+      memcpy(nextRow, &ctx->pic->rgba[(row + 1) * width], width * sizeof(uint32_t));
+
+    /* Diffuse error from inner pixels */
+    for (i = 1; i + 1 < width; i++) {
+      IntRgba quantError;
+
+      /* Previous row shall have diffused error up to (i+1, row) */
+      if (prevRowProgress < MIN(i + 3, width))
+        prevRowProgress = waitTasksPoolProgress(
+          &ctx->progress, row - 1, MIN(i + 3, width)
+        );
+
+      dstRow[i] = findNearestColorHdmvColorMapper(
+        mapper, curRow[i], &quantError
+      );
+      diffuseErrorFloydSteinberg(curRow, nextRow, i, quantError);
+
+      if (ctx->wavefront && 0 == (i + 1) % HDMV_PIC_DITHERING_WAVEFRONT_STEP)
+        setTasksPoolProgress(&ctx->progress, row, i + 1);
     }
   }
+  else {
+    /* Last row, without error diffusion */
+    if (prevRowProgress < width)
+      prevRowProgress = waitTasksPoolProgress(&ctx->progress, row - 1, width);
+
+    for (i = 1; i + 1 < width; i++)
+      dstRow[i] = findNearestColorHdmvColorMapper(mapper, curRow[i], NULL);
+  }
+
+  /* Border columns, without error diffusion */
+  if (prevRowProgress < width)
+    waitTasksPoolProgress(&ctx->progress, row - 1, width);
+  dstRow[0] = findNearestColorHdmvColorMapper(mapper, curRow[0], NULL);
+  dstRow[width - 1] = findNearestColorHdmvColorMapper(
+    mapper, curRow[width - 1], NULL
+  );
+
+  if (ctx->wavefront)
+    setTasksPoolProgress(&ctx->progress, row, width);
 }
 
-static void updatePalFromRgbaFloydSteinbergHdmvPicture(
-  HdmvPicturePtr pic
+static int ditherRowTaskFloydSteinbergHdmvPicture(
+  void * ctxPtr,
+  unsigned row
 )
 {
-  unsigned i, j;
+  HdmvPictureDitheringContext * ctx = (HdmvPictureDitheringContext *) ctxPtr;
+  HdmvColorMapperPtr mapper;
 
-  LIBBLU_HDMV_PIC_DEBUG("  Using Floyd-Steinberg dithering.\n");
+  /* Color mappers are not shared between threads */
+  if (NULL == (mapper = createHdmvColorMapper(ctx->pic->infos.linkedPal))) {
+    /* Release following row */
+    setTasksPoolProgress(&ctx->progress, row, ctx->pic->infos.width);
+    return -1;
+  }
 
-  for (j = 0; j < pic->infos.height-1; j++) {
-    for (i = 1; i < pic->infos.width-1; i++) {
-      IntRgba quantError;
+  ditherRowFloydSteinbergHdmvPicture(ctx, mapper, row);
 
-      pic->pal[j * pic->infos.width + i] =
-        findNearestColorHdmvPaletteDefinition(
-          pic->infos.linkedPal,
-          pic->rgba[j * pic->infos.width + i],
-          &quantError
-        )
-      ;
+  destroyHdmvColorMapper(mapper);
+  return 0;
+}
 
-      applyFloydSteinberg(
-        pic->rgba, i, j,
-        pic->infos.width,
-        quantError
-      );
-    }
+static int updatePalFromRgbaFloydSteinbergHdmvPicture(
+  HdmvPicturePtr pic,
+  HdmvColorMapperPtr mapper
+)
+{
+  HdmvPictureDitheringContext ctx;
+  unsigned nbThreads, row;
+  int ret;
+
+  nbThreads = pic->infos.ditherNbThreads;
+  ctx = (HdmvPictureDitheringContext) {
+    .pic = pic,
+    .mapper = mapper,
+    .nbWorkRows = 2,
+    .wavefront = (1 != nbThreads && 1 < pic->infos.height)
+  };
+
+  if (ctx.wavefront) {
+    LIBBLU_HDMV_PIC_DEBUG("  Using wavefront Floyd-Steinberg dithering.\n");
+    ctx.nbWorkRows = pic->infos.height;
   }
+  else
+    LIBBLU_HDMV_PIC_DEBUG("  Using Floyd-Steinberg dithering.\n");
 
-  for (j = 0; j < pic->infos.height; j++) {
-    pic->pal[j * pic->infos.width] =
-      findNearestColorHdmvPaletteDefinition(
-        pic->infos.linkedPal,
-        pic->rgba[j * pic->infos.width],
-        NULL
-      )
-    ;
-    pic->pal[(j + 1) * pic->infos.width - 1] =
-      findNearestColorHdmvPaletteDefinition(
-        pic->infos.linkedPal,
-        pic->rgba[(j + 1) * pic->infos.width - 1],
-        NULL
-      )
-    ;
+  ctx.work = (uint32_t *) malloc(
+    (size_t) ctx.nbWorkRows * pic->infos.width * sizeof(uint32_t)
+  );
+  if (NULL == ctx.work)
+    LIBBLU_HDMV_PIC_ERROR_RETURN("Memory allocation error.\n");
+
+  if (!ctx.wavefront) {
+    /* Load first row, following ones are loaded progressively */
+    memcpy(ctx.work, pic->rgba, pic->infos.width * sizeof(uint32_t));
+
+    for (row = 0; row < pic->infos.height; row++)
+      ditherRowFloydSteinbergHdmvPicture(&ctx, mapper, row);
+
+    free(ctx.work);
+    return 0;
   }
 
-  for (i = 0; i < pic->infos.width; i++) {
-    pic->pal[pic->infos.width * (pic->infos.height-1) + i] =
-      findNearestColorHdmvPaletteDefinition(
-        pic->infos.linkedPal,
-        pic->rgba[pic->infos.width * (pic->infos.height-1) + i],
-        NULL
-      )
-    ;
+  memcpy(
+    ctx.work, pic->rgba,
+    (size_t) pic->infos.height * pic->infos.width * sizeof(uint32_t)
+  );
+
+  if (initTasksPoolProgress(&ctx.progress, pic->infos.height) < 0) {
+    free(ctx.work);
+    return -1;
   }
+
+  ret = processTasksPool(
+    ditherRowTaskFloydSteinbergHdmvPicture, &ctx,
+    pic->infos.height, nbThreads
+  );
+
+  cleanTasksPoolProgress(&ctx.progress);
+  free(ctx.work);
+
+  if (ret < 0)
+    LIBBLU_HDMV_PIC_ERROR_RETURN("Unable to dither picture.\n");
+  return 0;
 }
 
 static int updatePalFromRgbaHdmvPicture(
   HdmvPicturePtr pic
 )
 {
+  HdmvColorMapperPtr mapper;
   clock_t start, duration;
-
-  /* TODO: Speed-up ! */
+  int ret;
 
   if ((start = clock()) < 0)
     LIBBLU_HDMV_PIC_DEBUG("   Warning: Unable to compute duration.\n");
 
+  /* Build nearest color lookup on linked palette */
+  if (NULL == (mapper = createHdmvColorMapper(pic->infos.linkedPal)))
+    return -1;
+
+  ret = 0;
   switch (pic->infos.ditherMeth) {
     case HDMV_PIC_CDM_DISABLED:
-      updatePalFromRgbaNoDitheringHdmvPicture(pic);
+      updatePalFromRgbaNoDitheringHdmvPicture(pic, mapper);
       break;
 
     case HDMV_PIC_CDM_FLOYD_STEINBERG:
-      updatePalFromRgbaFloydSteinbergHdmvPicture(pic);
+      ret = updatePalFromRgbaFloydSteinbergHdmvPicture(pic, mapper);
   }
 
+  destroyHdmvColorMapper(mapper);
+  if (ret < 0)
+    return -1;
+
   duration = clock() - start;
   LIBBLU_HDMV_PIC_DEBUG(
     "  Palette content filling duration: %ld ticks (%.2fs, %ld ticks/s).\n",
     duration, (float) duration / CLOCKS_PER_SEC, (clock_t) CLOCKS_PER_SEC
   );
 
+  pic->updatedPal = true;
   return 0;
 }
 
@@ -582,6 +723,15 @@ uint8_t * getRleHandleHdmvPicture(
   HdmvPicturePtr pic
 )
 {
+  size_t rleSize = maxRleSize(pic->infos.width, pic->infos.height);
+
+  /* Written data size is unknown, use the worst case */
+  if (pic->infos.rleAllocatedSize < rleSize) {
+    if (allocateRle(&pic->rle, rleSize) < 0)
+      return NULL;
+    pic->infos.rleAllocatedSize = rleSize;
+  }
+
   pic->updatedRgba = false;
   pic->updatedPal = false;
   pic->updatedRle = true;
@@ -589,92 +739,207 @@ uint8_t * getRleHandleHdmvPicture(
   return pic->rle;
 }
 
+int setRleHdmvPicture(
+  HdmvPicturePtr pic,
+  const uint8_t * rle,
+  size_t size
+)
+{
+  assert(NULL != pic);
+  assert(NULL != rle || !size);
+
+  if (pic->infos.rleAllocatedSize < size) {
+    if (allocateRle(&pic->rle, size) < 0)
+      return -1;
+    pic->infos.rleAllocatedSize = size;
+  }
+
+  if (0 < size)
+    memcpy(pic->rle, rle, size);
+  pic->infos.rleUsedSize = size;
+  pic->updatedRle = true;
+
+  return 0;
+}
+
 /* ############ RLE compression : ########################################## */
 
+/** \~english
+ * \brief Maximum length of a coded run, in pixels.
+ */
+#define HDMV_PIC_RLE_MAX_RUN_LENGTH  16383
+
+/** \~english
+ * \brief Run length from which pixels are compared by blocks.
+ */
+#define HDMV_PIC_RLE_SHORT_RUN_LENGTH  4
+
+/** \~english
+ * \brief Default RLE data allocation size, in bytes.
+ *
+ * Allocation grows on compression according to coded data size rather
+ * than being set to the worst case size.
+ */
+#define HDMV_PIC_RLE_DEFAULT_SIZE  4096
+
+/** \~english
+ * \brief Return the length of the run starting at given pixel.
+ *
+ * \param src Run first pixel.
+ * \param maxLen Maximum run length, shall be at least 1.
+ * \return size_t Number of consecutive pixels sharing the value of the first
+ * one, limited to maxLen.
+ *
+ * After a few pixels, remaining ones are compared by blocks of 16 (using
+ * SSE2) or 8 bytes, runs of transparent color being usually long.
+ */
+static inline size_t getRunLengthRleHdmvPicture(
+  const uint8_t * src,
+  size_t maxLen
+)
+{
+  const uint8_t px = src[0];
+  size_t len;
+
+  /* Short runs, checked pixel per pixel */
+  for (len = 1; len < maxLen && len < HDMV_PIC_RLE_SHORT_RUN_LENGTH; len++) {
+    if (src[len] != px)
+      return len;
+  }
+
+#if defined(__SSE2__)
+  const __m128i ref = _mm_set1_epi8((char) px);
+
+  while (len + 16 <= maxLen) {
+    unsigned mask = (unsigned) _mm_movemask_epi8(
+      _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) &src[len]), ref)
+    );
+
+    if (0xFFFF != mask) {
+      /* Run ends within block, at first different pixel */
+      for (; mask & 0x1; mask >>= 1)
+        len++;
+      return len;
+    }
+    len += 16;
+  }
+#else
+  const uint64_t ref = px * UINT64_C(0x0101010101010101);
+
+  while (len + 8 <= maxLen) {
+    uint64_t block;
+
+    memcpy(&block, &src[len], sizeof(uint64_t));
+    if (block != ref)
+      break; /* Run ends within block */
+    len += 8;
+  }
+#endif
+
+  while (len < maxLen && src[len] == px)
+    len++;
+  return len;
+}
+
+static inline uint8_t * writeRunRleHdmvPicture(
+  uint8_t * dst,
+  uint8_t px,
+  size_t len
+)
+{
+  if (px == 0) {
+    /* Color 0 */
+    if (len <= 63) {
+      /* 0b00000000 0b00LLLLLL */
+      *(dst++) = 0x00;
+      *(dst++) = len & 0x3F;
+    }
+    else {
+      /* 0b00000000 0b01LLLLLL 0bLLLLLLLL */
+      *(dst++) = 0x00;
+      *(dst++) = 0x40 | ((len >> 8) & 0x3F);
+      *(dst++) = len & 0xFF;
+    }
+  }
+  else {
+    if (len <= 3) {
+      /* 0bCCCCCCCC */
+      while (len--)
+        *(dst++) = px;
+    }
+    else if (len <= 63) {
+      /* 0b00000000 0b10LLLLLL 0bCCCCCCCC */
+      *(dst++) = 0x00;
+      *(dst++) = 0x80 | (len & 0x3F);
+      *(dst++) = px;
+    }
+    else {
+      /* 0b00000000 0b11LLLLLL 0bLLLLLLLL 0bCCCCCCCC */
+      *(dst++) = 0x00;
+      *(dst++) = 0xC0 | ((len >> 8) & 0x3F);
+      *(dst++) = len & 0xFF;
+      *(dst++) = px;
+    }
+  }
+
+  return dst;
+}
+
 static int performRleCompressionHdmvPicture(
   HdmvPicturePtr pic
 )
 {
-  uint8_t * dst, * src;
-  size_t height;
+  const size_t maxLineSize = maxRleSize(pic->infos.width, 1);
+
+  const uint8_t * src;
+  size_t rleSize;
+  unsigned j;
 
   src = pic->pal;
-  dst = pic->rle;
+  rleSize = 0;
 
-  for (height = pic->infos.height; 0 < height; height--) {
-    uint8_t runningPx, * nextLine;
-    size_t i, runningLen;
+  for (j = 0; j < pic->infos.height; j++) {
+    const uint8_t * eol = &src[pic->infos.width];
+    uint8_t * dst;
+
+    /* Ensure room for the worst case line */
+    if (pic->infos.rleAllocatedSize < rleSize + maxLineSize) {
+      size_t newSize = MAX(
+        GROW_ALLOCATION(pic->infos.rleAllocatedSize, HDMV_PIC_RLE_DEFAULT_SIZE),
+        rleSize + maxLineSize
+      );
 
-    nextLine = &src[pic->infos.width];
-    runningLen = 0;
+      if (allocateRle(&pic->rle, newSize) < 0)
+        return -1;
+      pic->infos.rleAllocatedSize = newSize;
+    }
 
-    while (true) {
-      if (!runningLen) {
-        /* Initialize a new running */
-        runningPx = *(src++);
-        runningLen++;
-      }
+    dst = &pic->rle[rleSize];
+    while (src < eol) {
+      size_t len;
 
-      if (
-        src == nextLine /* End of line */
-        || *src != runningPx  /* End of running */
-        || runningLen == 16383 /* Running is longer than max L */
-      ) {
-        /* End of running */
-        if (runningPx == 0) {
-          /* Color 0 */
-          if (runningLen <= 63) {
-            /* 0b00000000 0b00LLLLLL */
-            *(dst++) = 0x00;
-            *(dst++) = runningLen & 0x3F;
-          }
-          else {
-            /* 0b00000000 0b01LLLLLL 0bLLLLLLLL */
-            *(dst++) = 0x00;
-            *(dst++) = 0x40 | ((runningLen >> 8) & 0x3F);
-            *(dst++) = runningLen & 0xFF;
-          }
-        }
-        else {
-          if (runningLen <= 3) {
-            /* 0bCCCCCCCC */
-            for (i = 0; i < runningLen; i++)
-              *(dst++) = runningPx;
-          }
-          else if (runningLen <= 63) {
-            /* 0b00000000 0b10LLLLLL 0bCCCCCCCC */
-            *(dst++) = 0x00;
-            *(dst++) = 0x80 | (runningLen & 0x3F);
-            *(dst++) = runningPx;
-          }
-          else {
-            /* 0b00000000 0b11LLLLLL 0bLLLLLLLL 0bCCCCCCCC */
-            *(dst++) = 0x00;
-            *(dst++) = 0xC0 | ((runningLen >> 8) & 0x3F);
-            *(dst++) = runningLen & 0xFF;
-            *(dst++) = runningPx;
-          }
-        }
-
-        runningLen = 0;
-
-        if (src == nextLine)
-          break; /* End of line */
+      if (0 != *src && (src + 1 == eol || src[0] != src[1])) {
+        /* Single pixel, most common case of noisy pictures */
+        *(dst++) = *(src++);
         continue;
       }
 
-      /* Continue running */
-      src++;
-      runningLen++;
+      len = getRunLengthRleHdmvPicture(
+        src, MIN((size_t) (eol - src), HDMV_PIC_RLE_MAX_RUN_LENGTH)
+      );
+      dst = writeRunRleHdmvPicture(dst, *src, len);
+      src += len;
     }
 
     /* End of line */
     /* 0b00000000 0b00000000 */
     *(dst++) = 0x00;
     *(dst++) = 0x00;
+
+    rleSize = dst - pic->rle;
   }
 
-  pic->infos.rleUsedSize = dst - pic->rle;
+  pic->infos.rleUsedSize = rleSize;
   pic->updatedRle = true;
 
   return 0;
@@ -688,8 +953,11 @@ int setPaletteHdmvPicture(
   HdmvPictureColorDitheringMethod ditherMeth
 )
 {
-  if (pic->infos.linkedPal != pal || pic->infos.ditherMeth != ditherMeth)
+  if (pic->infos.linkedPal != pal || pic->infos.ditherMeth != ditherMeth) {
+    /* Indexed representations shall be computed again */
     pic->updatedPal = false;
+    pic->updatedRle = false;
+  }
 
   pic->infos.linkedPal = pal;
   pic->infos.ditherMeth = ditherMeth;
@@ -757,11 +1025,10 @@ int setSizeHdmvPicture(
   unsigned height
 )
 {
-  size_t picSize, rleSize;
+  size_t picSize;
 
   if (!checkPictureDimensions(width, height))
     return -1;
-  rleSize = maxRleSize(width, height);
   picSize = width * height;
 
   if (pic->infos.imgAllocatedSize < picSize) {
@@ -772,11 +1039,5 @@ int setSizeHdmvPicture(
     pic->infos.imgAllocatedSize = picSize;
   }
 
-  if (pic->infos.rleAllocatedSize < rleSize) {
-    if (allocateRle(&pic->rle, rleSize) < 0)
-      return -1;
-    pic->infos.rleAllocatedSize = rleSize;
-  }
-
   return 0;
 }
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "hdmv_error.h"
 #include "hdmv_palette_def.h"
 #include "hdmv_color.h"
+#include "hdmv_color_mapper.h"
+
+#include "../../../util/tasksPool.h"
 
 /* ### HDMV Picture infos : ################################################ */
 
@@ -23,6 +26,7 @@ typedef struct {
 
   HdmvPaletteDefinitionPtr linkedPal;
   HdmvPictureColorDitheringMethod ditherMeth;
+  unsigned ditherNbThreads;  /**< Dithering threads, 1 by default.          */
 
   size_t imgAllocatedSize;
   size_t rleAllocatedSize;
@@ -74,8 +78,11 @@ HdmvPicturePtr createHdmvPicture(
 /** \~english
  * \brief Duplicate a picture.
  *
- * \param pic
- * \return HdmvPicturePtr
+ * \param pic Source picture.
+ * \return HdmvPicturePtr Upon success, created copy is returned. Otherwise,
+ * a NULL pointer is returned.
+ *
+ * Only up to date RGBA, palette and RLE data are copied.
  *
  * \warning Duplicated picture must be filled before.
  */
@@ -181,6 +188,25 @@ uint8_t * getRleHandleHdmvPicture(
   HdmvPicturePtr pic
 );
 
+/** \~english
+ * \brief Set picture RLE data, previously compressed from its content.
+ *
+ * \param pic Destination picture.
+ * \param rle RLE data, result of picture compression using its linked
+ * palette and dithering method.
+ * \param size RLE data size in bytes.
+ * \return int Upon success, a zero is returned. Otherwise, a negative value
+ * is returned.
+ *
+ * Other representations up-to-date status is kept, allowing to restore
+ * saved compression results without performing it again.
+ */
+int setRleHdmvPicture(
+  HdmvPicturePtr pic,
+  const uint8_t * rle,
+  size_t size
+);
+
 /* ###### Operations : ##################################################### */
 
 /** \~english
@@ -198,6 +224,25 @@ int setPaletteHdmvPicture(
   HdmvPictureColorDitheringMethod ditherMeth
 );
 
+/** \~english
+ * \brief Set the number of threads used to dither the picture.
+ *
+ * \param pic Destination picture.
+ * \param nbThreads Number of threads, 1 for sequential dithering (default)
+ * or 0 to use every online processor.
+ *
+ * Using more than one thread enables wavefront Floyd-Steinberg dithering,
+ * each row trailing the previous one by a few pixels. This is only
+ * worthwhile on large pictures.
+ */
+static inline void setDitherNbThreadsHdmvPicture(
+  HdmvPicturePtr pic,
+  unsigned nbThreads
+)
+{
+  pic->infos.ditherNbThreads = nbThreads;
+}
+
 int cropHdmvPicture(
   HdmvPicturePtr pic,
   unsigned left,
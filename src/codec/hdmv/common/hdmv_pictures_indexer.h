@@ -14,13 +14,26 @@ typedef Hashtable HdmvPicturesIndexer, *HdmvPicturesIndexerPtr;
 
 /* ###### Creation / Destruction : ######################################### */
 
+/** \~english
+ * \brief Create a pictures indexer.
+ *
+ * \return HdmvPicturesIndexerPtr Upon success, created object is returned.
+ * Otherwise, a NULL pointer is returned.
+ *
+ * Indexed pictures are owned by the indexer and destroyed with it.
+ */
 static inline HdmvPicturesIndexerPtr createHdmvPicturesIndexer(
   void
 )
 {
   Hashtable * table;
 
-  if (NULL == (table = createHashTable()))
+  table = createAndSetFunHashTable(
+    (HashTable_keyHashFun) lbc_fnv1aStrHash,
+    (HashTable_keyCompFun) lbc_strcmp,
+    (HashTable_dataFreeFun) destroyHdmvPicture
+  );
+  if (NULL == table)
     LIBBLU_HDMV_PIC_ERROR_NRETURN("Memory allocation error.\n");
   return table;
 }
@@ -41,6 +41,30 @@ HdmvPictureFormat identifyFormatHdmvPictureLibraries(
 
 /* ######################################################################### */
 
+static int loadLibpngHdmvPictureLibraries(
+  HdmvPictureLibraries * libs,
+  const IniFileContextPtr conf
+)
+{
+  const lbc * libFilepath;
+
+  if (isLoadedHdmvLibpngHandle(&libs->libpng))
+    return 0;
+
+  libFilepath = lookupIniFile(conf, "LIBRARIES.LIBPNG");
+  return loadHdmvLibpngHandle(&libs->libpng, libFilepath);
+}
+
+int loadHdmvPictureLibraries(
+  HdmvPictureLibraries * libs,
+  const IniFileContextPtr conf
+)
+{
+  assert(NULL != libs);
+
+  return loadLibpngHdmvPictureLibraries(libs, conf);
+}
+
 #define ERROR_FRETURN(msg)                                                    \
   LIBBLU_HDMV_PIC_ERROR_FRETURN(                                              \
     msg " '%" PRI_LBCS "', %s (errno: %d).\n",                                \
@@ -72,12 +96,9 @@ HdmvPicturePtr openHdmvPicture(
   /* Use the signature to identify used format */
   switch (identifyFormatHdmvPictureLibraries(fileSignature)) {
     case HDMV_PIC_FORMAT_PNG: /* PNG */
-      if (!isLoadedHdmvLibpngHandle(&libs->libpng)) {
-        /* Load the libpng library if required */
-        const lbc * libFilepath = lookupIniFile(conf, "LIBRARIES.LIBPNG");
-        if (loadHdmvLibpngHandle(&libs->libpng, libFilepath) < 0)
-          goto free_return;
-      }
+      /* Load the libpng library if required */
+      if (loadLibpngHdmvPictureLibraries(libs, conf) < 0)
+        goto free_return;
 
       pic = openPngHdmvPicture(&libs->libpng, filepath, file);
       break;
@@ -47,6 +47,23 @@ HdmvPictureFormat identifyFormatHdmvPictureLibraries(
 
 /* ######################################################################### */
 
+/** \~english
+ * \brief Load every picture decoding library.
+ *
+ * \param libs Libraries handles.
+ * \param conf Optional INI configuration, defining libraries paths.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Libraries are otherwise loaded on first use by #openHdmvPicture(). This
+ * function shall be called before using it concurrently from several
+ * threads, each call then only reading the handles.
+ */
+int loadHdmvPictureLibraries(
+  HdmvPictureLibraries * libs,
+  const IniFileContextPtr conf
+);
+
 HdmvPicturePtr openHdmvPicture(
   HdmvPictureLibraries * libs,
   const lbc * filepath,
@@ -0,0 +1,524 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "hdmv_pictures_loader.h"
+
+/* ###### Creation / Destruction : ######################################### */
+
+static void keepDataHdmvPicturesLoader(
+  void * data
+)
+{
+  (void) data; /* Collected file paths set does not own any data. */
+}
+
+HdmvPicturesLoaderPtr createHdmvPicturesLoader(
+  void
+)
+{
+  HdmvPicturesLoaderPtr loader;
+
+  loader = (HdmvPicturesLoaderPtr) malloc(sizeof(HdmvPicturesLoader));
+  if (NULL == loader)
+    LIBBLU_HDMV_PIC_ERROR_NRETURN("Memory allocation error.\n");
+
+  *loader = (HdmvPicturesLoader) {
+    0
+  };
+
+  loader->filepaths = createAndSetFunHashTable(
+    (HashTable_keyHashFun) lbc_fnv1aStrHash,
+    (HashTable_keyCompFun) lbc_strcmp,
+    keepDataHdmvPicturesLoader
+  );
+  if (NULL == loader->filepaths) {
+    free(loader);
+    LIBBLU_HDMV_PIC_ERROR_NRETURN("Memory allocation error.\n");
+  }
+
+  return loader;
+}
+
+void destroyHdmvPicturesLoader(
+  HdmvPicturesLoaderPtr loader
+)
+{
+  unsigned i;
+
+  if (NULL == loader)
+    return;
+
+  for (i = 0; i < loader->nbUsedEntries; i++) {
+    free(loader->entries[i].filepath);
+    destroyHdmvPicture(loader->entries[i].pic);
+  }
+  free(loader->entries);
+  destroyHashTable(loader->filepaths);
+  free(loader);
+}
+
+/* ###### Operations : ##################################################### */
+
+int addFileHdmvPicturesLoader(
+  HdmvPicturesLoaderPtr loader,
+  const lbc * filepath
+)
+{
+  HdmvPicturesLoaderEntry * entry;
+  lbc * key;
+
+  assert(NULL != loader);
+  assert(NULL != filepath);
+
+  if (NULL != getHashTable(loader->filepaths, filepath))
+    return 0; /* Already collected */
+
+  if (loader->nbAllocatedEntries <= loader->nbUsedEntries) {
+    HdmvPicturesLoaderEntry * newArray;
+    unsigned newSize;
+
+    newSize = GROW_ALLOCATION(loader->nbAllocatedEntries, 16);
+    if (lb_mul_overflow(newSize, sizeof(HdmvPicturesLoaderEntry)))
+      LIBBLU_HDMV_PIC_ERROR_RETURN("Pictures loader entries number overflow.\n");
+
+    newArray = (HdmvPicturesLoaderEntry *) realloc(
+      loader->entries,
+      newSize * sizeof(HdmvPicturesLoaderEntry)
+    );
+    if (NULL == newArray)
+      LIBBLU_HDMV_PIC_ERROR_RETURN("Memory allocation error.\n");
+
+    loader->entries = newArray;
+    loader->nbAllocatedEntries = newSize;
+  }
+
+  entry = &loader->entries[loader->nbUsedEntries];
+  *entry = (HdmvPicturesLoaderEntry) {
+    .filepath = lbc_strdup(filepath)
+  };
+  if (NULL == entry->filepath)
+    LIBBLU_HDMV_PIC_ERROR_RETURN("Memory allocation error.\n");
+
+  if (NULL == (key = lbc_strdup(filepath)))
+    LIBBLU_HDMV_PIC_ERROR_FRETURN("Memory allocation error.\n");
+  if (putHashTable(loader->filepaths, key, entry->filepath) < 0) {
+    free(key);
+    LIBBLU_HDMV_PIC_ERROR_FRETURN("Memory allocation error.\n");
+  }
+
+  loader->nbUsedEntries++;
+  return 0;
+
+free_return:
+  free(entry->filepath);
+  return -1;
+}
+
+/* ######### Pictures cache : ############################################## */
+
+typedef struct {
+  uint64_t size;   /**< Source file size in bytes.                           */
+  int64_t mtime;   /**< Source file last modification time.                  */
+} HdmvPictureFileStats;
+
+static int getFileStatsHdmvPicturesLoader(
+  HdmvPictureFileStats * dst,
+  const lbc * filepath
+)
+{
+#if defined(ARCH_WIN32)
+  struct _stat64 st;
+
+  /* lbc is wchar_t on WIN32 */
+  if (_wstat64(filepath, &st) < 0)
+    return -1;
+#else
+  struct stat st;
+
+  /* lbc is char on Unix */
+  if (stat(filepath, &st) < 0)
+    return -1;
+#endif
+
+  *dst = (HdmvPictureFileStats) {
+    .size = (uint64_t) st.st_size,
+    .mtime = (int64_t) st.st_mtime
+  };
+
+  return 0;
+}
+
+/** \~english
+ * \brief Cached picture entry identification.
+ */
+typedef struct {
+  lbc * cacheFilepath;          /**< Cache entry file path.                  */
+  char * sourceFilepath;        /**< UTF-8 source file absolute path.        */
+  size_t sourceFilepathSize;    /**< Source file path size in bytes.         */
+  HdmvPictureFileStats stats;   /**< Source file statistics.                 */
+} HdmvPictureCacheKey;
+
+static int initHdmvPictureCacheKey(
+  HdmvPictureCacheKey * dst,
+  const lbc * cacheDir,
+  const lbc * filepath
+)
+{
+  lbc * absFilepath;
+
+  *dst = (HdmvPictureCacheKey) {
+    .cacheFilepath = NULL
+  };
+
+  if (getFileStatsHdmvPicturesLoader(&dst->stats, filepath) < 0)
+    return -1; /* Source file error, reported while opening it */
+
+  if (lb_gen_absolute_fp(&absFilepath, filepath) < 0)
+    return -1;
+
+  if (NULL == (dst->sourceFilepath = lbc_convfrom(absFilepath)))
+    LIBBLU_HDMV_PIC_ERROR_FRETURN("Memory allocation error.\n");
+  dst->sourceFilepathSize = strlen(dst->sourceFilepath);
+
+  if (UINT16_MAX < dst->sourceFilepathSize)
+    goto free_return; /* Too long path, not cached */
+
+  /* Absolute path is stored in entry, allowing to detect hash collisions */
+  if (
+    lbc_asprintf(
+      &dst->cacheFilepath, "%" PRI_LBCS "/%016" PRIX64 ".pic",
+      cacheDir,
+      fnv1a64BufHash(
+        FNV1A_64_OFFSET_BASIS, dst->sourceFilepath, dst->sourceFilepathSize
+      )
+    ) < 0
+  )
+    LIBBLU_HDMV_PIC_ERROR_FRETURN("Memory allocation error.\n");
+
+  free(absFilepath);
+  return 0;
+
+free_return:
+  free(absFilepath);
+  free(dst->sourceFilepath);
+  return -1;
+}
+
+static void cleanHdmvPictureCacheKey(
+  HdmvPictureCacheKey key
+)
+{
+  free(key.cacheFilepath);
+  free(key.sourceFilepath);
+}
+
+static HdmvPicturePtr readCacheHdmvPicturesLoader(
+  const HdmvPictureCacheKey * key
+)
+{
+  uint8_t header[HDMV_PIC_CACHE_HEADER_SIZE];
+  char * sourceFilepath;
+  HdmvPicturePtr pic;
+  uint32_t * rgba;
+  FILE * file;
+
+  unsigned width, height;
+  size_t size, i;
+
+  if (NULL == (file = lbc_fopen(key->cacheFilepath, "rb")))
+    return NULL; /* No cache entry */
+
+  pic = NULL, sourceFilepath = NULL;
+  if (!RA_FILE(file, header, HDMV_PIC_CACHE_HEADER_SIZE))
+    goto free_return;
+
+  if (
+    0 != memcmp(header, HDMV_PIC_CACHE_MAGIC, 4)
+    || HDMV_PIC_CACHE_VERSION != header[4]
+    || key->stats.size != lb_get_be_value(&header[5], 8)
+    || key->stats.mtime != (int64_t) lb_get_be_value(&header[13], 8)
+    || key->sourceFilepathSize != lb_get_be_value(&header[25], 2)
+  )
+    goto free_return; /* Outdated or foreign entry */
+
+  sourceFilepath = (char *) malloc(key->sourceFilepathSize);
+  if (NULL == sourceFilepath)
+    LIBBLU_HDMV_PIC_ERROR_FRETURN("Memory allocation error.\n");
+  if (!RA_FILE(file, sourceFilepath, key->sourceFilepathSize))
+    goto free_return;
+  if (0 != memcmp(sourceFilepath, key->sourceFilepath, key->sourceFilepathSize))
+    goto free_return; /* Hash collision */
+
+  width  = lb_get_be_value(&header[21], 2);
+  height = lb_get_be_value(&header[23], 2);
+  if (NULL == (pic = createHdmvPicture(0x0, width, height)))
+    goto free_return;
+
+  /* RGBA data is stored as decoded, as R, G, B, A bytes */
+  rgba = getRgbaHandleHdmvPicture(pic);
+  size = getRgbaSizeHdmvPicture(pic);
+  if (!RA_FILE(file, rgba, size * 4))
+    goto free_return;
+
+  if (
+    lb_get_be_value(&header[27], 8)
+    != fnv1a64BufHash(FNV1A_64_OFFSET_BASIS, rgba, size * 4)
+  )
+    goto free_return; /* Corrupted entry */
+
+  /* Converted in place, each pixel bytes being read before written */
+  for (i = 0; i < size; i++) {
+    const uint8_t * px = &((uint8_t *) rgba)[i << 2];
+
+    rgba[i] =
+      CHANNEL_VALUE(px[0], C_R)
+      | CHANNEL_VALUE(px[1], C_G)
+      | CHANNEL_VALUE(px[2], C_B)
+      | CHANNEL_VALUE(px[3], C_A)
+    ;
+  }
+
+  free(sourceFilepath);
+  fclose(file);
+  return pic;
+
+free_return:
+  destroyHdmvPicture(pic);
+  free(sourceFilepath);
+  fclose(file);
+  return NULL;
+}
+
+/** \~english
+ * \brief Number of pixels serialized at once in cache entries.
+ */
+#define HDMV_PIC_CACHE_WRITE_BLOCK  4096
+
+static int writeCacheHdmvPicturesLoader(
+  const HdmvPictureCacheKey * key,
+  HdmvPicturePtr pic
+)
+{
+  uint8_t header[HDMV_PIC_CACHE_HEADER_SIZE];
+  uint8_t block[HDMV_PIC_CACHE_WRITE_BLOCK << 2];
+  const uint32_t * rgba;
+  lbc * tmpFilepath;
+  FILE * file;
+
+  unsigned width, height;
+  size_t size, nbPixels, i, j;
+  uint64_t hash;
+
+  if (NULL == (rgba = getRgbaHdmvPicture(pic)))
+    return -1;
+  getDimensionsHdmvPicture(pic, &width, &height);
+  size = getRgbaSizeHdmvPicture(pic);
+
+  memcpy(header, HDMV_PIC_CACHE_MAGIC, 4);
+  header[4] = HDMV_PIC_CACHE_VERSION;
+  lb_put_be_value(&header[5], key->stats.size, 8);
+  lb_put_be_value(&header[13], (uint64_t) key->stats.mtime, 8);
+  lb_put_be_value(&header[21], width, 2);
+  lb_put_be_value(&header[23], height, 2);
+  lb_put_be_value(&header[25], key->sourceFilepathSize, 2);
+  memset(&header[27], 0x00, 8); /* RGBA data hash, set afterwards */
+
+  /* Written aside then renamed, a concurrent or interrupted writing shall
+  never expose an incomplete entry. */
+  if (lbc_asprintf(&tmpFilepath, "%" PRI_LBCS ".tmp", key->cacheFilepath) < 0)
+    LIBBLU_HDMV_PIC_ERROR_RETURN("Memory allocation error.\n");
+
+  if (NULL == (file = lbc_fopen(tmpFilepath, "wb"))) {
+    free(tmpFilepath);
+    return -1;
+  }
+
+  if (
+    !WA_FILE(file, header, HDMV_PIC_CACHE_HEADER_SIZE)
+    || !WA_FILE(file, key->sourceFilepath, key->sourceFilepathSize)
+  )
+    goto free_return;
+
+  /* RGBA data serialized as R, G, B, A bytes, by blocks of pixels */
+  hash = FNV1A_64_OFFSET_BASIS;
+  for (i = 0; i < size; i += nbPixels) {
+    nbPixels = MIN(size - i, HDMV_PIC_CACHE_WRITE_BLOCK);
+
+    for (j = 0; j < nbPixels; j++) {
+      block[(j << 2)    ] = GET_CHANNEL(rgba[i + j], C_R);
+      block[(j << 2) + 1] = GET_CHANNEL(rgba[i + j], C_G);
+      block[(j << 2) + 2] = GET_CHANNEL(rgba[i + j], C_B);
+      block[(j << 2) + 3] = GET_CHANNEL(rgba[i + j], C_A);
+    }
+
+    hash = fnv1a64BufHash(hash, block, nbPixels << 2);
+    if (!WA_FILE(file, block, nbPixels << 2))
+      goto free_return;
+  }
+
+  lb_put_be_value(&header[27], hash, 8);
+  if (
+    lb_fseek(file, 27, SEEK_SET) < 0
+    || !WA_FILE(file, &header[27], 8)
+  )
+    goto free_return;
+
+  if (0 != fclose(file)) {
+    lbc_remove(tmpFilepath);
+    free(tmpFilepath);
+    return -1;
+  }
+
+#if defined(ARCH_WIN32)
+  /* Renaming does not replace an existing file on Windows. */
+  lbc_remove(key->cacheFilepath);
+#endif
+  if (lbc_rename(tmpFilepath, key->cacheFilepath) < 0) {
+    lbc_remove(tmpFilepath);
+    free(tmpFilepath);
+    return -1;
+  }
+
+  free(tmpFilepath);
+  return 0;
+
+free_return:
+  fclose(file);
+  lbc_remove(tmpFilepath); /* Remove incomplete entry */
+  free(tmpFilepath);
+  return -1;
+}
+
+/* ######### Loading : ##################################################### */
+
+typedef struct {
+  HdmvPicturesLoaderPtr loader;
+  HdmvPictureLibraries * libs;
+  IniFileContextPtr conf;
+  const lbc * cacheDir;  /**< Pictures cache directory, NULL if unused.     */
+} HdmvPicturesLoadingTasks;
+
+static int readCacheTaskHdmvPicturesLoader(
+  void * arg,
+  unsigned taskIdx
+)
+{
+  HdmvPicturesLoadingTasks * tasks = (HdmvPicturesLoadingTasks *) arg;
+  HdmvPicturesLoaderEntry * entry = &tasks->loader->entries[taskIdx];
+  HdmvPictureCacheKey key;
+
+  if (initHdmvPictureCacheKey(&key, tasks->cacheDir, entry->filepath) < 0)
+    return 0; /* Picture will be decoded */
+
+  entry->pic = readCacheHdmvPicturesLoader(&key);
+  cleanHdmvPictureCacheKey(key);
+
+  return 0;
+}
+
+static int decodeTaskHdmvPicturesLoader(
+  void * arg,
+  unsigned taskIdx
+)
+{
+  HdmvPicturesLoadingTasks * tasks = (HdmvPicturesLoadingTasks *) arg;
+  HdmvPicturesLoaderEntry * entry = &tasks->loader->entries[taskIdx];
+  HdmvPictureCacheKey key;
+
+  if (NULL != entry->pic)
+    return 0; /* Loaded from cache */
+
+  entry->pic = openHdmvPicture(tasks->libs, entry->filepath, tasks->conf);
+  if (NULL == entry->pic)
+    return -1;
+
+  if (NULL == tasks->cacheDir)
+    return 0;
+
+  if (initHdmvPictureCacheKey(&key, tasks->cacheDir, entry->filepath) < 0)
+    return 0;
+  if (writeCacheHdmvPicturesLoader(&key, entry->pic) < 0)
+    LIBBLU_HDMV_PIC_WARNING(
+      "Unable to write picture cache entry '%" PRI_LBCS "'.\n",
+      key.cacheFilepath
+    );
+  cleanHdmvPictureCacheKey(key);
+
+  return 0;
+}
+
+int loadHdmvPicturesLoader(
+  HdmvPicturesLoaderPtr loader,
+  HdmvPicturesIndexerPtr dst,
+  HdmvPictureLibraries * libs,
+  const IniFileContextPtr conf,
+  unsigned nbThreads
+)
+{
+  HdmvPicturesLoadingTasks tasks;
+  unsigned i, nbDecoded;
+
+  assert(NULL != loader);
+  assert(NULL != dst);
+  assert(NULL != libs);
+
+  if (!loader->nbUsedEntries)
+    return 0;
+
+  tasks = (HdmvPicturesLoadingTasks) {
+    .loader = loader,
+    .libs = libs,
+    .conf = conf,
+    .cacheDir = lookupIniFile(conf, "HDMV.PICTURESCACHE")
+  };
+
+  if (NULL != tasks.cacheDir) {
+    /* Read available pictures from cache */
+    processTasksPool(
+      readCacheTaskHdmvPicturesLoader, &tasks,
+      loader->nbUsedEntries, nbThreads
+    );
+  }
+
+  for (nbDecoded = 0, i = 0; i < loader->nbUsedEntries; i++)
+    nbDecoded += (NULL == loader->entries[i].pic);
+
+  if (0 < nbDecoded) {
+    /* Libraries are loaded prior to concurrent decoding */
+    if (loadHdmvPictureLibraries(libs, conf) < 0)
+      return -1;
+
+    if (
+      processTasksPool(
+        decodeTaskHdmvPicturesLoader, &tasks,
+        loader->nbUsedEntries, nbThreads
+      ) < 0
+    )
+      return -1;
+  }
+
+  LIBBLU_HDMV_PIC_DEBUG(
+    "Loaded %u pictures (%u decoded, %u from cache).\n",
+    loader->nbUsedEntries, nbDecoded, loader->nbUsedEntries - nbDecoded
+  );
+
+  /* Transfer pictures ownership to indexer */
+  for (i = 0; i < loader->nbUsedEntries; i++) {
+    HdmvPicturesLoaderEntry * entry = &loader->entries[i];
+
+    if (addHdmvPicturesIndexer(dst, entry->pic, entry->filepath) < 0)
+      return -1;
+    entry->pic = NULL;
+  }
+
+  return 0;
+}
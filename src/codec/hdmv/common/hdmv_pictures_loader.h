@@ -0,0 +1,107 @@
+/** \~english
+ * \file hdmv_pictures_loader.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief HDMV pictures files parallel loading module.
+ *
+ * Referenced picture files are first collected, then decoded concurrently
+ * (each task using its own decoder context) and indexed by file path.
+ *
+ * Decoded pictures may be kept in an on-disk cache directory, defined by
+ * the 'picturesCache' key of the INI '[HDMV]' section. A cache entry is
+ * reused as long as its source file absolute path, size and modification
+ * time are unchanged and its content matches its recorded hash.
+ */
+
+#ifndef __LIBBLU_MUXER__CODECS__HDMV__COMMON__LOADER_H__
+#define __LIBBLU_MUXER__CODECS__HDMV__COMMON__LOADER_H__
+
+#include "hdmv_error.h"
+#include "hdmv_pictures_common.h"
+#include "hdmv_pictures_indexer.h"
+#include "hdmv_pictures_io.h"
+
+/** \~english
+ * \brief Pictures cache entry file magic value.
+ */
+#define HDMV_PIC_CACHE_MAGIC  "HPIC"
+
+/** \~english
+ * \brief Pictures cache entry file format version.
+ *
+ * Version 2 stores RGBA data as R, G, B, A bytes whatever the host byte
+ * order. Version 3 adds a RGBA data hash checked on loading.
+ */
+#define HDMV_PIC_CACHE_VERSION  3
+
+/** \~english
+ * \brief Pictures cache entry file header size in bytes, without source
+ * file path.
+ */
+#define HDMV_PIC_CACHE_HEADER_SIZE  35
+
+typedef struct {
+  lbc * filepath;      /**< Picture file path.                               */
+  HdmvPicturePtr pic;  /**< Decoded picture, NULL until loaded.              */
+} HdmvPicturesLoaderEntry;
+
+typedef struct {
+  HdmvPicturesLoaderEntry * entries;
+  unsigned nbAllocatedEntries;
+  unsigned nbUsedEntries;
+
+  Hashtable * filepaths;  /**< Already collected file paths.                 */
+} HdmvPicturesLoader, *HdmvPicturesLoaderPtr;
+
+/* ###### Creation / Destruction : ######################################### */
+
+HdmvPicturesLoaderPtr createHdmvPicturesLoader(
+  void
+);
+
+void destroyHdmvPicturesLoader(
+  HdmvPicturesLoaderPtr loader
+);
+
+/* ###### Operations : ##################################################### */
+
+/** \~english
+ * \brief Add a picture file to load.
+ *
+ * \param loader Used loader.
+ * \param filepath Picture file path, files already added are ignored.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int addFileHdmvPicturesLoader(
+  HdmvPicturesLoaderPtr loader,
+  const lbc * filepath
+);
+
+/** \~english
+ * \brief Load collected pictures files.
+ *
+ * \param loader Used loader.
+ * \param dst Destination indexer, pictures are indexed by their file path
+ * as supplied to #addFileHdmvPicturesLoader().
+ * \param libs Pictures libraries handles.
+ * \param conf Optional INI configuration.
+ * \param nbThreads Maximum number of decoding threads, if zero, the number
+ * of online processors is used.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Cache errors are not fatal, affected pictures being decoded from their
+ * source file.
+ */
+int loadHdmvPicturesLoader(
+  HdmvPicturesLoaderPtr loader,
+  HdmvPicturesIndexerPtr dst,
+  HdmvPictureLibraries * libs,
+  const IniFileContextPtr conf,
+  unsigned nbThreads
+);
+
+#endif
@@ -206,6 +206,7 @@ static int insertHdmvQuantizationHexatree(
   HdmvQuantHexTreeNodesInventoryPtr inv,
   HdmvQuantHexTreeNodePtr * tree,
   uint32_t rgba,
+  uint64_t weight,
   int depth,
   size_t * treeSize
 )
@@ -214,13 +215,14 @@ static int insertHdmvQuantizationHexatree(
 
   assert(NULL != tree);
   assert(NULL != treeSize);
+  assert(0 < weight);
   assert(depth <= MAX_DEPTH + 1);
 
   if (NULL == *tree) {
     if (NULL == (*tree = getNodeHdmvQuantHexTreeNodesInventory(inv)))
       return -1;
 
-    initHdmvQuantHexTreeNode(*tree, true, rgba, 1);
+    initHdmvQuantHexTreeNode(*tree, true, rgba, weight);
     (*treeSize)++;
     return 0;
   }
@@ -232,7 +234,7 @@ static int insertHdmvQuantizationHexatree(
     if ((*tree)->data.rgba == rgba || depth >= MAX_DEPTH) {
       HdmvRGBAData data;
 
-      setHdmvRGBAData(&data, rgba, 1);
+      setHdmvRGBAData(&data, rgba, weight);
       addHdmvRGBAData(&(*tree)->data, data);
       return 0;
     }
@@ -246,6 +248,7 @@ static int insertHdmvQuantizationHexatree(
     inv,
     &(*tree)->childNodes[getBranchHdmvQuantizationHexatree(depth, rgba)],
     rgba,
+    weight,
     depth + 1,
     treeSize
   );
@@ -254,7 +257,7 @@ static int insertHdmvQuantizationHexatree(
 
   /* Updating inter-node values: */
   (*tree)->leafDist = MAX((*tree)->leafDist, ret + 1);
-  (*tree)->data.rep++;
+  (*tree)->data.rep += weight;
 
   return ret + 1;
 }
@@ -428,6 +431,137 @@ int reduceHdmvQuantizationHexatree(
   return 0;
 }
 
+/* ### HDMV Quantizer line colors histogram : ############################# */
+
+/** \~english
+ * \brief Minimal line colors histogram hash table size, as a power of two.
+ */
+#define HDMV_QUANT_HISTOGRAM_MIN_SIZE_LOG2  4
+
+typedef struct {
+  uint32_t rgba;   /**< Color value.                                         */
+  uint32_t count;  /**< Number of line pixels using the color.               */
+  uint32_t line;   /**< Line stamp, entry is unused if different from the
+    histogram current one.                                                   */
+} HdmvQuantHistogramEntry;
+
+/** \~english
+ * \brief Distinct colors histogram of a picture line.
+ *
+ * Colors are counted in an open-addressing hash table, stamped with the
+ * line number to avoid clearing it between lines, and listed in order of
+ * first occurrence.
+ */
+typedef struct {
+  HdmvQuantHistogramEntry * entries;  /**< Hash table.                      */
+  unsigned sizeLog2;                  /**< Hash table size (power of two).  */
+  uint32_t line;                      /**< Current line stamp.              */
+
+  HdmvQuantHistogramEntry ** colors;  /**< Line distinct colors.            */
+  unsigned nbColors;                  /**< Number of line distinct colors.  */
+} HdmvQuantHistogram;
+
+static int initHdmvQuantHistogram(
+  HdmvQuantHistogram * hist,
+  unsigned width
+)
+{
+  unsigned sizeLog2;
+
+  /* At least twice the maximum number of distinct colors in a line */
+  for (
+    sizeLog2 = HDMV_QUANT_HISTOGRAM_MIN_SIZE_LOG2;
+    (1u << sizeLog2) < 2 * width;
+    sizeLog2++
+  )
+    ;
+
+  *hist = (HdmvQuantHistogram) {
+    .sizeLog2 = sizeLog2
+  };
+
+  hist->entries = (HdmvQuantHistogramEntry *) calloc(
+    1u << sizeLog2, sizeof(HdmvQuantHistogramEntry)
+  );
+  hist->colors = (HdmvQuantHistogramEntry **) malloc(
+    MAX(width, 1) * sizeof(HdmvQuantHistogramEntry *)
+  );
+  if (NULL == hist->entries || NULL == hist->colors) {
+    free(hist->entries);
+    free(hist->colors);
+    LIBBLU_HDMV_QUANT_ERROR_RETURN("Memory allocation error.\n");
+  }
+
+  return 0;
+}
+
+static void cleanHdmvQuantHistogram(
+  HdmvQuantHistogram hist
+)
+{
+  free(hist.entries);
+  free(hist.colors);
+}
+
+static void fillHdmvQuantHistogram(
+  HdmvQuantHistogram * hist,
+  const uint32_t * pix,
+  unsigned width
+)
+{
+  HdmvQuantHistogramEntry * prev;
+  uint32_t mask;
+  unsigned i;
+
+  assert(NULL != hist);
+  assert(NULL != pix);
+
+  mask = (1u << hist->sizeLog2) - 1;
+  hist->line++;
+  hist->nbColors = 0;
+  assert(0 < hist->line);
+
+  for (prev = NULL, i = 0; i < width; i++) {
+    HdmvQuantHistogramEntry * entry;
+    uint32_t rgba = pix[i];
+    uint32_t idx;
+
+    if (NULL != prev && prev->rgba == rgba) {
+      /* Flat run, same entry as previous pixel */
+      prev->count++;
+      continue;
+    }
+
+    /* Fibonacci hashing and linear probing */
+    idx = (rgba * UINT32_C(0x9E3779B1)) >> (32 - hist->sizeLog2);
+    for (;;) {
+      entry = &hist->entries[idx];
+
+      if (entry->line != hist->line) {
+        /* New line color */
+        *entry = (HdmvQuantHistogramEntry) {
+          .rgba = rgba,
+          .count = 1,
+          .line = hist->line
+        };
+        hist->colors[hist->nbColors++] = entry;
+        break;
+      }
+
+      if (entry->rgba == rgba) {
+        entry->count++;
+        break;
+      }
+
+      idx = (idx + 1) & mask;
+    }
+
+    prev = entry;
+  }
+}
+
+/* ######################################################################### */
+
 int continueHdmvQuantizationHexatree(
   HdmvQuantHexTreeNodePtr * tree,
   HdmvQuantHexTreeNodesInventoryPtr inv,
@@ -437,7 +571,8 @@ int continueHdmvQuantizationHexatree(
 )
 {
   unsigned picWidth, picHeight;
-  const uint32_t * pix, *eol, * end;
+  const uint32_t * pix, * end;
+  HdmvQuantHistogram hist;
   size_t curNbColors;
 
   clock_t duration, start;
@@ -460,10 +595,26 @@ int continueHdmvQuantizationHexatree(
   if ((start = clock()) < 0)
     LIBBLU_HDMV_QUANT_DEBUG(" Warning: Unable to use clock().\n");
 
+  if (initHdmvQuantHistogram(&hist, picWidth) < 0)
+    return -1;
+
   curNbColors = 0;
-  for (end = &pix[picWidth * picHeight]; pix != end; ) {
-    for (eol = &pix[picWidth]; pix != eol; pix++) {
-      if (insertHdmvQuantizationHexatree(inv, tree, *pix, 0, &curNbColors) < 0)
+  for (end = &pix[picWidth * picHeight]; pix != end; pix += picWidth) {
+    unsigned i;
+
+    /* Each distinct color of the line is inserted once, weighted by its
+      number of pixels. Since reductions only occur at the end of lines,
+      resulting tree is the same as inserting pixels one by one. */
+    fillHdmvQuantHistogram(&hist, pix, picWidth);
+
+    for (i = 0; i < hist.nbColors; i++) {
+      const HdmvQuantHistogramEntry * color = hist.colors[i];
+
+      if (
+        insertHdmvQuantizationHexatree(
+          inv, tree, color->rgba, color->count, 0, &curNbColors
+        ) < 0
+      )
         goto free_return;
     }
 
@@ -483,9 +634,11 @@ int continueHdmvQuantizationHexatree(
   if (NULL != outputNbColors)
     *outputNbColors = curNbColors;
 
+  cleanHdmvQuantHistogram(hist);
   LIBBLU_HDMV_QUANT_DEBUG("Completed.\n");
   return 0;
 
 free_return:
+  cleanHdmvQuantHistogram(hist);
   return -1;
 }
@@ -33,6 +33,8 @@ IgsCompilerContextPtr createIgsCompilerContext(
 
   /* Init Picture libraries */
   initHdmvPictureLibraries(&ctx->imgLibs);
+  if (NULL == (ctx->loadedPics = createHdmvPicturesIndexer()))
+    goto free_return;
 
   /* Init libxml context */
   ctx->xmlCtx = createXmlContext(&echoErrorIgsXmlFile, &echoDebugIgsXmlFile);
@@ -90,6 +92,7 @@ void destroyIgsCompilerContext(
 
   ECHO_DEBUG("Free IGS Compiler context memory.\n");
 
+  destroyHdmvPicturesIndexer(ctx->loadedPics);
   cleanHdmvPictureLibraries(ctx->imgLibs);
   destroyXmlContext(ctx->xmlCtx);
   destroyHdmvSegmentsInventory(ctx->inv);
@@ -194,76 +197,219 @@ int updateIgsCompilerWorkingDirectory(
   return 0;
 }
 
-static HdmvPaletteDefinitionPtr createAndBuildPalette(
-  const HdmvPicturesListPtr list,
-  HdmvPictureColorDitheringMethod ditherMeth,
-  HdmvPaletteColorMatrix colorMatrix
+/** \~english
+ * \brief Page palette building task.
+ *
+ * Pages are independent, their palettes are built (or restored from cache)
+ * concurrently and merged afterwards in pages order.
+ */
+typedef struct {
+  HdmvPicturesListPtr pictures;  /**< Page collected pictures.              */
+  HdmvPaletteDefinitionPtr pal;  /**< Built palette, NULL if empty page.    */
+
+  uint64_t cacheKey;             /**< Page cache entry key.                 */
+  bool cached;                   /**< Page restored from cache.             */
+} IgsCompilerPageTask;
+
+typedef struct {
+  IgsCompilerPageTask * pages;
+  HdmvPictureColorDitheringMethod ditherMeth;
+  HdmvPaletteColorMatrix colorMatrix;
+  const lbc * cacheDir;  /**< Built pages cache directory, NULL if unused.  */
+} IgsCompilerPagesTasks;
+
+static int buildPagePaletteIgsCompiler(
+  void * tasksPtr,
+  unsigned page_id
 )
 {
+  IgsCompilerPagesTasks * tasks = (IgsCompilerPagesTasks *) tasksPtr;
+  IgsCompilerPageTask * task = &tasks->pages[page_id];
   HdmvPaletteDefinitionPtr pal;
 
-  /* static const HdmvPictureColorDitheringMethod ditherMeth =
-    HDMV_PIC_CDM_FLOYD_STEINBERG
-  ;
-  static const HdmvPaletteColorMatrix palColorMatrix =
-    HDMV_PAL_CM_BT_601
-  ; */
+  if (!nbPicsHdmvPicturesList(task->pictures))
+    return 0; /* Empty page */
+
+  if (NULL != tasks->cacheDir) {
+    /* Restore page palette and pictures if unchanged */
+    if (
+      computeKeyIgsPageCache(
+        &task->cacheKey, task->pictures,
+        tasks->ditherMeth, tasks->colorMatrix
+      ) < 0
+    )
+      return -1;
+
+    task->pal = readIgsPageCache(
+      tasks->cacheDir, task->cacheKey, task->pictures,
+      tasks->ditherMeth, tasks->colorMatrix
+    );
+    if (NULL != task->pal) {
+      task->cached = true;
+      return 0;
+    }
+  }
 
   /* Create a new palette */
   if (NULL == (pal = createHdmvPaletteDefinition(0x0)))
-    return NULL;
+    return -1;
 
   /* Fill the palette according to pictures */
-  if (buildPaletteListHdmvPalette(pal, list, 255, NULL) < 0)
-    goto free_return;
+  if (buildPaletteListHdmvPalette(pal, task->pictures, 255, NULL) < 0) {
+    destroyHdmvPaletteDefinition(pal);
+    return -1;
+  }
 
   /* Sort palette */
   sortEntriesHdmvPaletteDefinition(pal);
 
-  /* Apply the palette on pictures */
-  if (setPaletteHdmvPicturesList(list, pal, ditherMeth) < 0)
-    goto free_return;
-
   /* Set palette conversion method */
-  setColorMatrixHdmvPaletteDefinition(pal, colorMatrix);
+  setColorMatrixHdmvPaletteDefinition(pal, tasks->colorMatrix);
 
-  return pal;
+  task->pal = pal;
+  return 0;
+}
 
-free_return:
-  destroyHdmvPaletteDefinition(pal);
-  return NULL;
+/** \~english
+ * \brief Minimal number of pixels of an object picture dithered using
+ * wavefront parallel mode rather than in parallel with other objects.
+ */
+#define IGS_COMPL_WAVEFRONT_DITHERING_MIN_SIZE  (256 * 256)
+
+static bool useWavefrontDitheringIgsCompiler(
+  const HdmvPicturePtr pic
+)
+{
+  return
+    HDMV_PIC_CDM_FLOYD_STEINBERG == pic->infos.ditherMeth
+    && IGS_COMPL_WAVEFRONT_DITHERING_MIN_SIZE
+      <= pic->infos.width * pic->infos.height
+  ;
+}
+
+static int buildObjectPictureIgsCompiler(
+  void * compoPtr,
+  unsigned objId
+)
+{
+  IgsCompilerCompositionPtr compo = (IgsCompilerCompositionPtr) compoPtr;
+  HdmvPicturePtr pic = compo->objPics[objId];
+
+  if (NULL == pic->infos.linkedPal)
+    return 0; /* Unreferenced object */
+  if (1 != pic->infos.ditherNbThreads)
+    return 0; /* Built afterwards using wavefront dithering */
+
+  /* Perform palette indexing and RLE compression */
+  if (0 == getRleSizeHdmvPicture(pic))
+    LIBBLU_HDMV_IGS_COMPL_ERROR_RETURN(
+      "Unable to build object %u picture.\n",
+      objId
+    );
+
+  return 0;
+}
+
+static int writePageCacheIgsCompiler(
+  void * tasksPtr,
+  unsigned page_id
+)
+{
+  IgsCompilerPagesTasks * tasks = (IgsCompilerPagesTasks *) tasksPtr;
+  IgsCompilerPageTask * task = &tasks->pages[page_id];
+  unsigned i;
+
+  if (task->cached || !nbPicsHdmvPicturesList(task->pictures))
+    return 0;
+
+  for (i = 0; i < page_id; i++) {
+    const IgsCompilerPageTask * prevTask = &tasks->pages[i];
+
+    if (
+      nbPicsHdmvPicturesList(prevTask->pictures)
+      && prevTask->cacheKey == task->cacheKey
+    )
+      return 0; /* Identical page, already saved */
+  }
+
+  if (writeIgsPageCache(tasks->cacheDir, task->cacheKey, task->pictures) < 0)
+    LIBBLU_HDMV_IGS_COMPL_WARNING(
+      "Unable to save page %u in cache.\n",
+      page_id
+    );
+
+  return 0;
+}
+
+static void cleanPagesTasksIgsCompiler(
+  IgsCompilerPagesTasks * tasks,
+  unsigned nbPages
+)
+{
+  unsigned page_id;
+
+  if (NULL == tasks->pages)
+    return;
+
+  for (page_id = 0; page_id < nbPages; page_id++) {
+    IgsCompilerPageTask * task = &tasks->pages[page_id];
+
+    if (NULL != task->pictures) {
+      /* Pictures are owned by the composition */
+      flushHdmvPicturesList(task->pictures);
+      destroyHdmvPicturesList(task->pictures);
+    }
+    destroyHdmvPaletteDefinition(task->pal);
+  }
+  free(tasks->pages);
 }
 
 int buildIgsCompilerComposition(
   IgsCompilerCompositionPtr compo,
   HdmvPictureColorDitheringMethod ditherMeth,
-  HdmvPaletteColorMatrix colorMatrix
+  HdmvPaletteColorMatrix colorMatrix,
+  const lbc * cacheDir,
+  unsigned nbThreads
 )
 {
-  unsigned nbPages, page_id;
-  HdmvPicturesListPtr pictures;
+  IgsCompilerPagesTasks tasks;
+  unsigned nbPages, nbBuiltPages, nbCachedPages, page_id, objId;
 
   assert(NULL != compo);
 
   LIBBLU_HDMV_IGS_COMPL_INFO("Building interactive compositions...\n");
 
-  if (NULL == (pictures = createHdmvPicturesList()))
-    goto free_return;
+  nbPages = compo->interactiveComposition.number_of_pages;
+  tasks = (IgsCompilerPagesTasks) {
+    .ditherMeth = ditherMeth,
+    .colorMatrix = colorMatrix,
+    .cacheDir = cacheDir
+  };
+
+  if (0 < nbPages) {
+    tasks.pages = (IgsCompilerPageTask *) calloc(
+      nbPages, sizeof(IgsCompilerPageTask)
+    );
+    if (NULL == tasks.pages)
+      LIBBLU_HDMV_IGS_COMPL_ERROR_RETURN("Memory allocation error.\n");
+  }
 
   LIBBLU_HDMV_IGS_COMPL_DEBUG("Collecting content of each page:\n");
 
   /* Collect all composition pictures */
-  nbPages = compo->interactiveComposition.number_of_pages;
   for (page_id = 0; page_id < nbPages; page_id++) {
-    /* Create a palette for each page */
     HdmvPageParameters * page = compo->interactiveComposition.pages[page_id];
 
-    HdmvPaletteDefinitionPtr pal;
-    unsigned nbPics, palId, bogId;
+    HdmvPicturesListPtr pictures;
+    unsigned bogId;
 
     LIBBLU_HDMV_IGS_COMPL_DEBUG(" Page %u\n", page_id);
     LIBBLU_HDMV_IGS_COMPL_DEBUG("  Collecting every object from each BOG:\n");
 
+    if (NULL == (pictures = createHdmvPicturesList()))
+      goto free_return;
+    tasks.pages[page_id].pictures = pictures;
+
     for (bogId = 0; bogId < page->number_of_BOGs; bogId++) {
       HdmvButtonOverlapGroupParameters * bog = page->bogs[bogId];
 
@@ -302,42 +448,91 @@ int buildIgsCompilerComposition(
       }
     }
 
-    /* Getting the number of collected objects. */
-    nbPics = nbPicsHdmvPicturesList(pictures);
+    LIBBLU_HDMV_IGS_COMPL_DEBUG(
+      "  Collected %u pictures.\n",
+      nbPicsHdmvPicturesList(pictures)
+    );
+  }
 
-    if (!nbPics) {
-      LIBBLU_HDMV_IGS_COMPL_DEBUG("  Empty page, skipping to next one.\n");
+  /* Create a palette for each page */
+  LIBBLU_HDMV_IGS_COMPL_DEBUG("Creating pages palettes.\n");
+  if (processTasksPool(buildPagePaletteIgsCompiler, &tasks, nbPages, nbThreads) < 0)
+    LIBBLU_HDMV_IGS_COMPL_ERROR_GRETURN(
+      free_return, "Unable to create pages palettes.\n"
+    );
+
+  /* Merge palettes in pages order */
+  nbBuiltPages = nbCachedPages = 0;
+  for (page_id = 0; page_id < nbPages; page_id++) {
+    HdmvPageParameters * page = compo->interactiveComposition.pages[page_id];
+    IgsCompilerPageTask * task = &tasks.pages[page_id];
+
+    unsigned palId;
+
+    if (NULL == task->pal) {
+      LIBBLU_HDMV_IGS_COMPL_DEBUG(" Page %u: Empty page, skipping.\n", page_id);
       continue;
     }
 
-    LIBBLU_HDMV_IGS_COMPL_DEBUG("  Creating palette for %u pictures.\n", nbPics);
-    pal = createAndBuildPalette(pictures, ditherMeth, colorMatrix);
-    if (NULL == pal)
+    /* Apply the palette on pictures, no-op if restored from cache */
+    if (setPaletteHdmvPicturesList(task->pictures, task->pal, ditherMeth) < 0)
       goto free_return;
+    nbBuiltPages += !task->cached;
+    nbCachedPages += task->cached;
 
-    /* Add finished palette to composition and reset list for next page */
-    LIBBLU_HDMV_IGS_COMPL_DEBUG("  Saving generated palette.\n");
-    if (addPaletteIgsCompilerComposition(compo, pal, &palId) < 0) {
-      destroyHdmvPaletteDefinition(pal);
+    /* Add finished palette to composition */
+    LIBBLU_HDMV_IGS_COMPL_DEBUG(" Page %u: Saving generated palette.\n", page_id);
+    if (addPaletteIgsCompilerComposition(compo, task->pal, &palId) < 0)
       goto free_return;
-    }
+    task->pal = NULL; /* Palette is now owned by composition */
 
     /* Save generated ID */
     if (UINT8_MAX < palId)
-      LIBBLU_HDMV_IGS_COMPL_ERROR_FRETURN("Too many palettes present (id exceed 0xFF).\n");
+      LIBBLU_HDMV_IGS_COMPL_ERROR_GRETURN(
+        free_return, "Too many palettes present (id exceed 0xFF).\n"
+      );
     page->palette_id_ref = palId; /* Set page palette id */
+  }
+
+  /* Apply palettes on objects pictures */
+  LIBBLU_HDMV_IGS_COMPL_DEBUG("Building objects pictures.\n");
+  for (objId = 0; objId < compo->nbUsedObjPics; objId++) {
+    /* Large pictures are dithered using all threads, one at a time */
+    if (1 != nbThreads && useWavefrontDitheringIgsCompiler(compo->objPics[objId]))
+      setDitherNbThreadsHdmvPicture(compo->objPics[objId], nbThreads);
+  }
 
-    LIBBLU_HDMV_IGS_COMPL_DEBUG("  Flushing list.\n");
-    flushHdmvPicturesList(pictures);
+  if (processTasksPool(buildObjectPictureIgsCompiler, compo, compo->nbUsedObjPics, nbThreads) < 0)
+    goto free_return;
+
+  for (objId = 0; objId < compo->nbUsedObjPics; objId++) {
+    HdmvPicturePtr pic = compo->objPics[objId];
+
+    if (NULL == pic->infos.linkedPal || 1 == pic->infos.ditherNbThreads)
+      continue;
+    if (0 == getRleSizeHdmvPicture(pic))
+      LIBBLU_HDMV_IGS_COMPL_ERROR_FRETURN(
+        "Unable to build object %u picture.\n", objId
+      );
+  }
+
+  if (NULL != cacheDir) {
+    LIBBLU_HDMV_IGS_COMPL_INFO(
+      " %u page(s) restored from cache, %u built.\n",
+      nbCachedPages, nbBuiltPages
+    );
+
+    /* Save built pages, cache errors are not fatal */
+    processTasksPool(writePageCacheIgsCompiler, &tasks, nbPages, nbThreads);
   }
 
   LIBBLU_HDMV_IGS_COMPL_DEBUG(" Completed.\n");
 
-  destroyHdmvPicturesList(pictures);
+  cleanPagesTasksIgsCompiler(&tasks, nbPages);
   return 0;
 
 free_return:
-  destroyHdmvPicturesList(pictures);
+  cleanPagesTasksIgsCompiler(&tasks, nbPages);
   return -1;
 }
 
@@ -386,20 +581,33 @@ int processIgsCompiler(
 
   HdmvPictureColorDitheringMethod ditherMeth;
   HdmvPaletteColorMatrix colorMatrix;
+  const lbc * cacheDir;
 
   LIBBLU_HDMV_IGS_COMPL_INFO("Compiling IGS...\n");
 
   if (NULL == (ctx = createIgsCompilerContext(xmlPath, conf)))
     return -1;
+  ctx->nbThreads = getNbThreadsFromIniHdmv(ctx->conf);
 
   if (parseIgsXmlFile(ctx) < 0)
     goto free_return;
 
+  /* Decoded pictures are no longer needed */
+  destroyHdmvPicturesIndexer(ctx->loadedPics);
+  ctx->loadedPics = NULL;
+
   ditherMeth = getDitherMethodFromIniIgsCompiler(ctx);
   colorMatrix = getColorMatrixFromIniIgsCompiler(ctx);
+  cacheDir = lookupIniFile(ctx->conf, "HDMV.PICTURESCACHE");
 
   for (compId = 0; compId < ctx->data.nbCompo; compId++) {
-    if (buildIgsCompilerComposition(GET_COMP(ctx, compId), ditherMeth, colorMatrix) < 0)
+    IgsCompilerCompositionPtr compo = GET_COMP(ctx, compId);
+
+    if (
+      buildIgsCompilerComposition(
+        compo, ditherMeth, colorMatrix, cacheDir, ctx->nbThreads
+      ) < 0
+    )
       goto free_return;
   }
 
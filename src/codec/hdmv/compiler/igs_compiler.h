@@ -21,6 +21,7 @@
 
 #include "igs_compiler_context_data.h"
 #include "igs_compiler_data.h"
+#include "igs_pagesCache.h"
 #include "igs_segmentsBuilding.h"
 #include "igs_xmlParser.h"
 
@@ -28,6 +29,8 @@
 #include "../common/hdmv_pictures_list.h"
 #include "../common/hdmv_palette_gen.h"
 
+#include "../../../util/tasksPool.h"
+
 IgsCompilerContextPtr createIgsCompilerContext(
   const lbc * xmlFilename,
   IniFileContextPtr conf
@@ -55,7 +58,9 @@ int updateIgsCompilerWorkingDirectory(
 int buildIgsCompilerComposition(
   IgsCompilerCompositionPtr compo,
   HdmvPictureColorDitheringMethod ditherMeth,
-  HdmvPaletteColorMatrix colorMatrix
+  HdmvPaletteColorMatrix colorMatrix,
+  const lbc * cacheDir,
+  unsigned nbThreads
 );
 
 int processIgsCompiler(
@@ -5,6 +5,7 @@
 
 #include "igs_compiler_data.h"
 #include "../common/hdmv_pictures_io.h"
+#include "../common/hdmv_pictures_loader.h"
 #include "../../../ini/iniData.h"
 
 #define GET_COMP(ctx, id)                         \
@@ -16,6 +17,9 @@
 typedef struct {
   IniFileContextPtr conf;
   HdmvPictureLibraries imgLibs;
+  HdmvPicturesIndexerPtr loadedPics;  /**< Pictures decoded prior to
+    compositions parsing, indexed by file path.                              */
+  unsigned nbThreads;  /**< Number of threads, 0 means every processor.     */
   XmlCtxPtr xmlCtx;
   HdmvSegmentsInventoryPtr inv;
 
@@ -0,0 +1,342 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+
+#include "igs_pagesCache.h"
+
+/** \~english
+ * \brief Size of a picture record header in a cache entry, in bytes.
+ *
+ * Each page picture is saved as its dimensions (2 x 16 bits) and RLE data
+ * size (32 bits), followed by its RLE data.
+ */
+#define IGS_PAGE_CACHE_PIC_HEADER_SIZE  8
+
+/* ### Key : ############################################################### */
+
+static uint64_t hashValueIgsPageCache(
+  uint64_t hash,
+  uint32_t value
+)
+{
+  uint8_t bytes[4];
+
+  bytes[0] = (value >> 24) & 0xFF;
+  bytes[1] = (value >> 16) & 0xFF;
+  bytes[2] = (value >>  8) & 0xFF;
+  bytes[3] = (value      ) & 0xFF;
+
+  return fnv1a64BufHash(hash, bytes, 4);
+}
+
+int computeKeyIgsPageCache(
+  uint64_t * key,
+  HdmvPicturesListPtr pictures,
+  HdmvPictureColorDitheringMethod ditherMeth,
+  HdmvPaletteColorMatrix colorMatrix
+)
+{
+  HdmvPicturePtr pic;
+  uint64_t hash;
+  unsigned i;
+
+  assert(NULL != key);
+  assert(NULL != pictures);
+
+  hash = FNV1A_64_OFFSET_BASIS;
+  hash = hashValueIgsPageCache(hash, IGS_PAGE_CACHE_VERSION);
+  hash = hashValueIgsPageCache(hash, ditherMeth);
+  hash = hashValueIgsPageCache(hash, colorMatrix);
+  hash = hashValueIgsPageCache(hash, nbPicsHdmvPicturesList(pictures));
+
+  for (i = 0; NULL != (pic = iterateHdmvPicturesList(pictures, &i)); ) {
+    const uint32_t * rgba;
+    unsigned width, height;
+
+    if (NULL == (rgba = getRgbaHdmvPicture(pic)))
+      return -1;
+    getDimensionsHdmvPicture(pic, &width, &height);
+
+    hash = hashValueIgsPageCache(hash, width);
+    hash = hashValueIgsPageCache(hash, height);
+    hash = fnv1a64BufHash(
+      hash, rgba, getRgbaSizeHdmvPicture(pic) * sizeof(uint32_t)
+    );
+  }
+
+  *key = hash;
+  return 0;
+}
+
+/* ### Entries : ########################################################### */
+
+static lbc * getFilepathIgsPageCache(
+  const lbc * cacheDir,
+  uint64_t key
+)
+{
+  lbc * filepath;
+
+  if (lbc_asprintf(&filepath, "%" PRI_LBCS "/%016" PRIX64 ".igp", cacheDir, key) < 0)
+    LIBBLU_HDMV_IGS_COMPL_ERROR_NRETURN("Memory allocation error.\n");
+  return filepath;
+}
+
+/** \~english
+ * \brief Check saved pictures records.
+ *
+ * \param records Pictures records, following saved palette entries.
+ * \param size Size of pictures records, in bytes.
+ * \param pictures Page pictures.
+ * \return bool True if records match page pictures.
+ */
+static bool checkPicturesIgsPageCache(
+  const uint8_t * records,
+  size_t size,
+  HdmvPicturesListPtr pictures
+)
+{
+  HdmvPicturePtr pic;
+  size_t off;
+  unsigned i;
+
+  for (off = 0, i = 0; NULL != (pic = iterateHdmvPicturesList(pictures, &i)); ) {
+    unsigned width, height;
+    size_t rleSize;
+
+    if (size - off < IGS_PAGE_CACHE_PIC_HEADER_SIZE)
+      return false;
+
+    getDimensionsHdmvPicture(pic, &width, &height);
+    if (
+      width != lb_get_be_value(&records[off], 2)
+      || height != lb_get_be_value(&records[off+2], 2)
+    )
+      return false;
+
+    rleSize = lb_get_be_value(&records[off+4], 4);
+    off += IGS_PAGE_CACHE_PIC_HEADER_SIZE;
+    if (!rleSize || size - off < rleSize)
+      return false;
+    off += rleSize;
+  }
+
+  return off == size;
+}
+
+HdmvPaletteDefinitionPtr readIgsPageCache(
+  const lbc * cacheDir,
+  uint64_t key,
+  HdmvPicturesListPtr pictures,
+  HdmvPictureColorDitheringMethod ditherMeth,
+  HdmvPaletteColorMatrix colorMatrix
+)
+{
+  uint8_t header[IGS_PAGE_CACHE_HEADER_SIZE];
+  HdmvPaletteDefinitionPtr pal;
+  lbc * filepath;
+  FILE * file;
+
+  uint8_t * payload;
+  size_t payloadSize, off;
+  unsigned nbEntries, nbPics, i;
+
+  assert(NULL != cacheDir);
+  assert(NULL != pictures);
+
+  nbPics = nbPicsHdmvPicturesList(pictures);
+  assert(0 < nbPics);
+
+  if (NULL == (filepath = getFilepathIgsPageCache(cacheDir, key)))
+    return NULL;
+  file = lbc_fopen(filepath, "rb");
+  free(filepath);
+  if (NULL == file)
+    return NULL; /* No cache entry */
+
+  pal = NULL, payload = NULL;
+  if (!RA_FILE(file, header, IGS_PAGE_CACHE_HEADER_SIZE))
+    goto free_return;
+
+  nbEntries = lb_get_be_value(&header[13], 2);
+  payloadSize = lb_get_be_value(&header[17], 4);
+
+  if (
+    0 != memcmp(header, IGS_PAGE_CACHE_MAGIC, 4)
+    || IGS_PAGE_CACHE_VERSION != header[4]
+    || key != lb_get_be_value(&header[5], 8)
+    || nbPics != lb_get_be_value(&header[15], 2)
+  )
+    goto free_return; /* Outdated or foreign entry */
+
+  if (
+    !nbEntries || HDMV_PAL_SIZE < nbEntries
+    || payloadSize < nbEntries * 4 + nbPics * IGS_PAGE_CACHE_PIC_HEADER_SIZE
+  )
+    goto free_return; /* Invalid entry */
+
+  /* Read and check the whole payload prior to any modification */
+  if (NULL == (payload = (uint8_t *) malloc(payloadSize)))
+    LIBBLU_HDMV_IGS_COMPL_ERROR_FRETURN("Memory allocation error.\n");
+  if (!RA_FILE(file, payload, payloadSize))
+    goto free_return;
+
+  if (
+    lb_get_be_value(&header[21], 8)
+    != fnv1a64BufHash(FNV1A_64_OFFSET_BASIS, payload, payloadSize)
+  )
+    goto free_return; /* Corrupted entry */
+
+  off = nbEntries * 4;
+  if (!checkPicturesIgsPageCache(payload + off, payloadSize - off, pictures))
+    goto free_return;
+
+  /* Palette */
+  if (NULL == (pal = createHdmvPaletteDefinition(0x0)))
+    goto free_return;
+  for (i = 0; i < nbEntries; i++) {
+    if (addRgbaEntryHdmvPaletteDefinition(pal, lb_get_be_value(&payload[4*i], 4)) < 0)
+      goto free_return;
+  }
+  setColorMatrixHdmvPaletteDefinition(pal, colorMatrix);
+
+  /* Pictures */
+  if (setPaletteHdmvPicturesList(pictures, pal, ditherMeth) < 0)
+    goto free_return;
+
+  for (i = 0; i < nbPics; i++) {
+    HdmvPicturePtr pic = getHdmvPicturesList(pictures, i);
+    size_t rleSize = lb_get_be_value(&payload[off+4], 4);
+
+    off += IGS_PAGE_CACHE_PIC_HEADER_SIZE;
+    if (setRleHdmvPicture(pic, payload + off, rleSize) < 0) {
+      /* Discard partially restored page */
+      setPaletteHdmvPicturesList(pictures, NULL, ditherMeth);
+      goto free_return;
+    }
+    off += rleSize;
+  }
+
+  free(payload);
+  fclose(file);
+  return pal;
+
+free_return:
+  destroyHdmvPaletteDefinition(pal);
+  free(payload);
+  fclose(file);
+  return NULL;
+}
+
+int writeIgsPageCache(
+  const lbc * cacheDir,
+  uint64_t key,
+  HdmvPicturesListPtr pictures
+)
+{
+  HdmvPaletteDefinitionPtr pal;
+  HdmvPicturePtr pic;
+  lbc * filepath;
+  FILE * file;
+  bool written;
+
+  uint8_t * data;
+  size_t dataSize, off, nbEntries, i;
+  unsigned picIdx;
+
+  assert(NULL != cacheDir);
+  assert(NULL != pictures);
+  assert(0 < nbPicsHdmvPicturesList(pictures));
+
+  pal = getHdmvPicturesList(pictures, 0)->infos.linkedPal;
+  assert(NULL != pal);
+  nbEntries = getNbEntriesHdmvPaletteDefinition(pal);
+
+  /* Compute entry size */
+  dataSize = IGS_PAGE_CACHE_HEADER_SIZE + nbEntries * 4;
+  for (picIdx = 0; NULL != (pic = iterateHdmvPicturesList(pictures, &picIdx)); ) {
+    size_t rleSize;
+
+    assert(pal == pic->infos.linkedPal);
+    if (0 == (rleSize = getRleSizeHdmvPicture(pic)))
+      return -1;
+    dataSize += IGS_PAGE_CACHE_PIC_HEADER_SIZE + rleSize;
+  }
+
+  if (NULL == (data = (uint8_t *) malloc(dataSize)))
+    LIBBLU_HDMV_IGS_COMPL_ERROR_RETURN("Memory allocation error.\n");
+
+  /* Header */
+  off = 0;
+  WA_ARRAY(data, off, IGS_PAGE_CACHE_MAGIC, 4);
+  WB_ARRAY(data, off, IGS_PAGE_CACHE_VERSION);
+  lb_put_be_value(&data[5], key, 8);
+  lb_put_be_value(&data[13], nbEntries, 2);
+  lb_put_be_value(&data[15], nbPicsHdmvPicturesList(pictures), 2);
+  off = IGS_PAGE_CACHE_HEADER_SIZE; /* Payload size and hash, set afterwards */
+
+  /* Palette */
+  for (i = 0; i < nbEntries; i++) {
+    uint32_t rgba;
+
+    if (getRgbaEntryHdmvPaletteDefinition(pal, i, &rgba) < 0)
+      goto free_return;
+    lb_put_be_value(&data[off], rgba, 4);
+    off += 4;
+  }
+
+  /* Pictures */
+  for (picIdx = 0; NULL != (pic = iterateHdmvPicturesList(pictures, &picIdx)); ) {
+    unsigned width, height;
+    size_t rleSize;
+
+    getDimensionsHdmvPicture(pic, &width, &height);
+    rleSize = getRleSizeHdmvPicture(pic);
+
+    lb_put_be_value(&data[off], width, 2);
+    lb_put_be_value(&data[off+2], height, 2);
+    lb_put_be_value(&data[off+4], rleSize, 4);
+    off += IGS_PAGE_CACHE_PIC_HEADER_SIZE;
+    WA_ARRAY(data, off, getRleHdmvPicture(pic), rleSize);
+  }
+  assert(off == dataSize);
+
+  /* Payload integrity */
+  lb_put_be_value(&data[17], dataSize - IGS_PAGE_CACHE_HEADER_SIZE, 4);
+  lb_put_be_value(
+    &data[21],
+    fnv1a64BufHash(
+      FNV1A_64_OFFSET_BASIS,
+      data + IGS_PAGE_CACHE_HEADER_SIZE,
+      dataSize - IGS_PAGE_CACHE_HEADER_SIZE
+    ),
+    8
+  );
+
+  if (NULL == (filepath = getFilepathIgsPageCache(cacheDir, key)))
+    goto free_return;
+
+  if (NULL == (file = lbc_fopen(filepath, "wb"))) {
+    free(filepath);
+    goto free_return;
+  }
+
+  written = WA_FILE(file, data, dataSize);
+  if (0 != fclose(file) || !written) {
+    lbc_remove(filepath); /* Remove incomplete entry */
+    free(filepath);
+    goto free_return;
+  }
+
+  free(filepath);
+  free(data);
+  return 0;
+
+free_return:
+  free(data);
+  return -1;
+}
@@ -0,0 +1,102 @@
+/** \~english
+ * \file igs_pagesCache.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief HDMV IGS Compiler built pages cache module.
+ *
+ * Building a page (palette generation, pictures indexing and RLE
+ * compression) only depends on the page pictures content and on the
+ * compilation settings. Built pages are saved in the directory defined by
+ * the 'picturesCache' key of the INI '[HDMV]' section, identified by a
+ * hash of these inputs, allowing to skip building of unchanged pages when
+ * compiling again an edited menu.
+ */
+
+#ifndef __LIBBLU_MUXER__CODECS__IGS_COMPILER__PAGES_CACHE_H__
+#define __LIBBLU_MUXER__CODECS__IGS_COMPILER__PAGES_CACHE_H__
+
+#include "../../../util.h"
+
+#include "../common/hdmv_error.h"
+#include "../common/hdmv_palette_def.h"
+#include "../common/hdmv_pictures_common.h"
+#include "../common/hdmv_pictures_list.h"
+
+/** \~english
+ * \brief Built page cache entry file magic value.
+ */
+#define IGS_PAGE_CACHE_MAGIC  "HIGP"
+
+/** \~english
+ * \brief Built page cache entry file format version.
+ *
+ * Also part of entries key, shall be increased on any change of the page
+ * building results (palette generation, dithering or RLE compression).
+ */
+#define IGS_PAGE_CACHE_VERSION  1
+
+/** \~english
+ * \brief Built page cache entry file header size in bytes.
+ *
+ * Header contains magic, version, page key, number of palette entries,
+ * number of pictures, payload size and payload hash. Payload is made of
+ * palette RGBA entries followed by pictures dimensions and RLE data.
+ */
+#define IGS_PAGE_CACHE_HEADER_SIZE  29
+
+/** \~english
+ * \brief Compute the cache key of a page.
+ *
+ * \param key Destination key.
+ * \param pictures Page pictures, in page collection order.
+ * \param ditherMeth Pictures dithering method.
+ * \param colorMatrix Palette color conversion matrix.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int computeKeyIgsPageCache(
+  uint64_t * key,
+  HdmvPicturesListPtr pictures,
+  HdmvPictureColorDitheringMethod ditherMeth,
+  HdmvPaletteColorMatrix colorMatrix
+);
+
+/** \~english
+ * \brief Restore a built page from cache.
+ *
+ * \param cacheDir Cache directory.
+ * \param key Page key.
+ * \param pictures Page pictures, receiving on success the restored palette
+ * and RLE data.
+ * \param ditherMeth Pictures dithering method.
+ * \param colorMatrix Palette color conversion matrix.
+ * \return HdmvPaletteDefinitionPtr On success, the restored page palette,
+ * linked to pictures, is returned. Otherwise, if no valid entry is
+ * available, a NULL pointer is returned and pictures are left unchanged.
+ */
+HdmvPaletteDefinitionPtr readIgsPageCache(
+  const lbc * cacheDir,
+  uint64_t key,
+  HdmvPicturesListPtr pictures,
+  HdmvPictureColorDitheringMethod ditherMeth,
+  HdmvPaletteColorMatrix colorMatrix
+);
+
+/** \~english
+ * \brief Save a built page in cache.
+ *
+ * \param cacheDir Cache directory.
+ * \param key Page key.
+ * \param pictures Built page pictures, all linked to the page palette.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int writeIgsPageCache(
+  const lbc * cacheDir,
+  uint64_t key,
+  HdmvPicturesListPtr pictures
+);
+
+#endif
@@ -110,6 +110,68 @@
 #define GET_UINT64(dst, def, err_msg, err_instr, path, ...)                   \
   GET_UINTN(64, dst, def, err_msg, err_instr, path, ##__VA_ARGS__)
 
+#define CHILD_NODE(node, name)                                                \
+  getChildNodeIgsXmlFile(node, name)
+
+#define NEXT_NODE(node, name)                                                 \
+  getNextSiblingNodeIgsXmlFile(node, name)
+
+#define NB_CHILD_NODES(node, name)                                            \
+  getNbChildNodesIgsXmlFile(node, name)
+
+#define NODE_GET_STRING(node, dst, def, err_instr, field)                     \
+  do {                                                                        \
+    int _ret;                                                                 \
+                                                                              \
+    _ret = getIfExistsStringFromNodeIgsXmlFile(                               \
+      XML_CTX(ctx), node, dst, (xmlChar *) def, field                         \
+    );                                                                        \
+    if (_ret < 0)                                                             \
+      err_instr;                                                              \
+  } while (0)
+
+#define NODE_GET_BOOL(node, dst, def, err_instr, field)                       \
+  do {                                                                        \
+    int _ret;                                                                 \
+    bool _val;                                                                \
+                                                                              \
+    _ret = getIfExistsBooleanFromNodeIgsXmlFile(                              \
+      XML_CTX(ctx), node, &_val, def, field                                   \
+    );                                                                        \
+    if (_ret < 0)                                                             \
+      err_instr;                                                              \
+                                                                              \
+    *(dst) = _val;                                                            \
+  } while (0)
+
+#define NODE_GET_UINTN(n, node, dst, def, err_msg, err_instr, field)          \
+  do {                                                                        \
+    int _ret;                                                                 \
+    uint64_t _val;                                                            \
+                                                                              \
+    _ret = getIfExistsUint64FromNodeIgsXmlFile(                               \
+      XML_CTX(ctx), node, &_val, def, field                                   \
+    );                                                                        \
+    if (_ret < 0)                                                             \
+      err_instr;                                                              \
+                                                                              \
+    if (UINT##n##_MAX < _val) {                                               \
+      LIBBLU_HDMV_IGS_COMPL_XML_ERROR(err_msg);                               \
+      err_instr;                                                              \
+    }                                                                         \
+                                                                              \
+    *(dst) = _val;                                                            \
+  } while (0)
+
+#define NODE_GET_UINT8(node, dst, def, err_msg, err_instr, field)             \
+  NODE_GET_UINTN(8, node, dst, def, err_msg, err_instr, field)
+#define NODE_GET_UINT16(node, dst, def, err_msg, err_instr, field)            \
+  NODE_GET_UINTN(16, node, dst, def, err_msg, err_instr, field)
+#define NODE_GET_UINT32(node, dst, def, err_msg, err_instr, field)            \
+  NODE_GET_UINTN(32, node, dst, def, err_msg, err_instr, field)
+#define NODE_GET_UINT64(node, dst, def, err_msg, err_instr, field)            \
+  NODE_GET_UINTN(64, node, dst, def, err_msg, err_instr, field)
+
 /* ========================== */
 
 void echoErrorIgsXmlFile(
@@ -238,71 +300,78 @@ uint16_t addObjPicIgsCompilerComposition(
 }
 #endif
 
+/** \~english
+ * \brief UO_mask_table() user operations XML names and mask bits.
+ */
+static const struct {
+  const char * name;
+  unsigned bit;
+} igsXmlUopFields[] = {
+  {"chapter_search",                       61},
+  {"time_search",                          60},
+  {"skip_to_next_point",                   59},
+  {"skip_back_to_previous_point",          58},
+  {"stop",                                 56},
+  {"pause_on",                             55},
+  {"still_off",                            53},
+  {"forward_play",                         52},
+  {"backward_play",                        51},
+  {"resume",                               50},
+  {"move_up_selected_button",              49},
+  {"move_down_selected_button",            48},
+  {"move_left_selected_button",            47},
+  {"move_right_selected_button",           46},
+  {"select_button",                        45},
+  {"activate_button",                      44},
+  {"select_button_and_activate",           43},
+  {"primary_audio_stream_number_change",   42},
+  {"angle_number_change",                  40},
+  {"popup_on",                             39},
+  {"popup_off",                            38},
+  {"PG_textST_enable_disable",             37},
+  {"PG_textST_stream_number_change",       36},
+  {"secondary_video_enable_disable",       35},
+  {"secondary_video_stream_number_change", 34},
+  {"secondary_audio_enable_disable",       33},
+  {"secondary_audio_stream_number_change", 32},
+  {"PiP_PG_textST_stream_number_change",   31}
+};
+
 int parseParametersUopIgsXmlFile(
   IgsCompilerContextPtr ctx,
-  const char * path,
+  xmlNodePtr node,
   uint64_t * maskDest
 )
 {
   uint64_t mask;
+  unsigned i;
 
   assert(NULL != maskDest);
 
-  /* uop/mask */ {
-    GET_UINT64(
-      &mask, *maskDest,
-      "Invalid UOP mask field, expect a valid unsigned value.\n",
-      return -1,
-      "%s/mask",
-      path
-    );
-  }
+  /* uop/mask */
+  NODE_GET_UINT64(
+    node, &mask, *maskDest,
+    "Invalid UOP mask field, expect a valid unsigned value.\n",
+    return -1,
+    "mask"
+  );
 
   /* uop/<User Operation name> */
-#define GET_UOP(m, n, f)                                                      \
-  {                                                                           \
-    bool _bl;                                                                 \
-                                                                              \
-    GET_BOOL(&_bl, !((*(m) >> (n)) & 0x1), goto free_return, "%s/"#f, path);  \
-    *(m) = (*(m) & ~(1llu << (n))) | ((uint64_t) !_bl) << (n);                \
-  }
+  for (i = 0; i < ARRAY_SIZE(igsXmlUopFields); i++) {
+    unsigned bit = igsXmlUopFields[i].bit;
+    bool allowed;
 
-  GET_UOP(&mask, 61, chapter_search);
-  GET_UOP(&mask, 60, time_search);
-  GET_UOP(&mask, 59, skip_to_next_point);
-  GET_UOP(&mask, 58, skip_back_to_previous_point);
-  GET_UOP(&mask, 56, stop);
-  GET_UOP(&mask, 55, pause_on);
-  GET_UOP(&mask, 53, still_off);
-  GET_UOP(&mask, 52, forward_play);
-  GET_UOP(&mask, 51, backward_play);
-  GET_UOP(&mask, 50, resume);
-  GET_UOP(&mask, 49, move_up_selected_button);
-  GET_UOP(&mask, 48, move_down_selected_button);
-  GET_UOP(&mask, 47, move_left_selected_button);
-  GET_UOP(&mask, 46, move_right_selected_button);
-  GET_UOP(&mask, 45, select_button);
-  GET_UOP(&mask, 44, activate_button);
-  GET_UOP(&mask, 43, select_button_and_activate);
-  GET_UOP(&mask, 42, primary_audio_stream_number_change);
-  GET_UOP(&mask, 40, angle_number_change);
-  GET_UOP(&mask, 39, popup_on);
-  GET_UOP(&mask, 38, popup_off);
-  GET_UOP(&mask, 37, PG_textST_enable_disable);
-  GET_UOP(&mask, 36, PG_textST_stream_number_change);
-  GET_UOP(&mask, 35, secondary_video_enable_disable);
-  GET_UOP(&mask, 34, secondary_video_stream_number_change);
-  GET_UOP(&mask, 33, secondary_audio_enable_disable);
-  GET_UOP(&mask, 32, secondary_audio_stream_number_change);
-  GET_UOP(&mask, 31, PiP_PG_textST_stream_number_change);
-#undef GET_UOP
+    NODE_GET_BOOL(
+      node, &allowed, !((mask >> bit) & 0x1),
+      return -1,
+      igsXmlUopFields[i].name
+    );
+    mask = (mask & ~(1llu << bit)) | ((uint64_t) !allowed) << bit;
+  }
 
   *maskDest = mask;
 
   return 0;
-
-free_return:
-  return -1;
 }
 
 int parseParametersIgsXmlFile(
@@ -411,10 +480,16 @@ int parseParametersIgsXmlFile(
 
   ctx->data.commonUopMask = 0x0;
   if (0 < NB_OBJ("/igs/parameters/uop")) {
+    xmlXPathObjectPtr uopPathObj;
+
+    if (NULL == (uopPathObj = GET_OBJ("/igs/parameters/uop")))
+      return -1;
+
     ret = parseParametersUopIgsXmlFile(
-      ctx, "/igs/parameters/uop",
+      ctx, XML_PATH_NODE(uopPathObj, 0),
       &ctx->data.commonUopMask
     );
+    xmlXPathFreeObject(uopPathObj);
     if (ret < 0)
       return -1;
   }
@@ -669,6 +744,7 @@ int parseCompositionParametersIgsXmlFile(
 
 HdmvPicturePtr parseImgIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   lbc ** imgFilename
 )
 {
@@ -683,7 +759,7 @@ HdmvPicturePtr parseImgIgsXmlFile(
 
   /* Parse all img fields: */
   /* img/@name : */
-  GET_STRING(&string, NULL, return NULL, "//@name");
+  NODE_GET_STRING(node, &string, NULL, return NULL, "@name");
   if (NULL != imgFilename) {
     /* If string == NULL, passthrough */
     if (NULL == string)
@@ -696,64 +772,70 @@ HdmvPicturePtr parseImgIgsXmlFile(
   freeXmlCharPtr(&string);
 
   /* img/@path : */
-  GET_STRING(&string, NULL, return NULL, "//@path");
-  if (NULL == string) {
-    printNbObjectsFromExprErrorIgsXmlFile(0, "//@path");
+  NODE_GET_STRING(node, &string, NULL, return NULL, "@path");
+  if (NULL == string)
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR_FRETURN(
       "Missing required 'path' argument on img in input XML file (line %u).\n",
-      XML_CTX(ctx)->lastParsedNodeLine
+      node->line
     );
-  }
 
   if (NULL == (imgPath = lbc_utf8_convto(string)))
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR_FRETURN("Memory allocation error.\n");
   freeXmlCharPtr(&string);
 
   /* img/@cutting_x : */
-  GET_UINT32(
-    &cuttingX, 0,
+  NODE_GET_UINT32(
+    node, &cuttingX, 0,
     "Img's 'cutting_x' optionnal parameter must be positive",
     goto free_return,
-    "//@cutting_x"
+    "@cutting_x"
   );
 
   /* img/@cutting_y : */
-  GET_UINT32(
-    &cuttingY, 0,
+  NODE_GET_UINT32(
+    node, &cuttingY, 0,
     "Img's 'cutting_y' optionnal parameter must be positive",
     goto free_return,
-    "//@cutting_y"
+    "@cutting_y"
   );
 
   /* img/@width : */
-  GET_UINT32(
-    &width, 0,
+  NODE_GET_UINT32(
+    node, &width, 0,
     "Img's 'width' optionnal parameter must be positive",
     goto free_return,
-    "//@width"
+    "@width"
   );
 
   /* img/@height : */
-  GET_UINT32(
-    &height, 0,
+  NODE_GET_UINT32(
+    node, &height, 0,
     "Img's 'height' optionnal parameter must be positive",
     goto free_return,
-    "//@height"
+    "@height"
   );
 
   if ((0 < width && width < 8) || (0 < height && height < 8))
-    LIBBLU_HDMV_IGS_COMPL_XML_ERROR_NRETURN(
+    LIBBLU_HDMV_IGS_COMPL_XML_ERROR_FRETURN(
       "Image object dimensions cannot be smaller than 8x8 pixels (line %u).\n",
-      XML_CTX(ctx)->lastParsedNodeLine
+      node->line
     );
 
   LIBBLU_HDMV_IGS_COMPL_XML_INFO(
     "Loading picture '%" PRI_LBCS "' (line %u).\n",
-    imgPath, XML_CTX(ctx)->lastParsedNodeLine
+    imgPath, node->line
   );
 
-  if (NULL == (pic = openHdmvPicture(&ctx->imgLibs, imgPath, ctx->conf)))
-    goto free_return;
+  pic = getHdmvPicturesIndexer(ctx->loadedPics, imgPath);
+  if (NULL != pic) {
+    /* Already decoded, the same file may be used several times */
+    if (NULL == (pic = dupHdmvPicture(pic)))
+      goto free_return;
+  }
+  else {
+    if (NULL == (pic = openHdmvPicture(&ctx->imgLibs, imgPath, ctx->conf)))
+      goto free_return;
+  }
 
   if (cropHdmvPicture(pic, cuttingX, cuttingY, width, height) < 0)
     goto free_return;
@@ -770,7 +852,8 @@ free_return:
 }
 
 HdmvPicturePtr parseRefImgIgsXmlFile(
-  IgsCompilerContextPtr ctx
+  IgsCompilerContextPtr ctx,
+  xmlNodePtr node
 )
 {
   HdmvPicturePtr pic;
@@ -784,23 +867,25 @@ HdmvPicturePtr parseRefImgIgsXmlFile(
 
   /* Parse all img fields: */
   /* ref_pic/@name : */
-  string = getStringFromExprIgsXmlFile(XML_CTX(ctx), "//@name");
-  if (NULL == string) {
-    printNbObjectsFromExprErrorIgsXmlFile(0, "//@name");
+  NODE_GET_STRING(node, &string, NULL, return NULL, "@name");
+  if (NULL == string)
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR_NRETURN(
-      "Missing required 'name' argument on img in input XML file.\n"
+      "Missing required 'name' argument on img in input XML file "
+      "(line %u).\n",
+      node->line
     );
-  }
 
-  if (NULL == (name = lbc_utf8_convto(string)))
+  if (NULL == (name = lbc_utf8_convto(string))) {
+    freeXmlCharPtr(&string);
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR_NRETURN("Memory allocation error.\n");
+  }
   freeXmlCharPtr(&string);
 
   pic = getRefPictureIgsCompilerComposition(CUR_COMP(ctx), name);
   if (NULL == pic) {
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR(
       "No reference picture called '%" PRI_LBCS "' exits (line: %u).\n",
-      name, XML_CTX(ctx)->lastParsedNodeLine
+      name, node->line
     );
 
     free(name);
@@ -809,35 +894,35 @@ HdmvPicturePtr parseRefImgIgsXmlFile(
   free(name);
 
   /* ref_pic/@cutting_x : */
-  GET_UINT32(
-    &cuttingX, 0,
+  NODE_GET_UINT32(
+    node, &cuttingX, 0,
     "Img's 'cutting_x' optionnal parameter must be positive",
     return NULL,
-    "//@cutting_x"
+    "@cutting_x"
   );
 
   /* ref_pic/@cutting_y : */
-  GET_UINT32(
-    &cuttingY, 0,
+  NODE_GET_UINT32(
+    node, &cuttingY, 0,
     "Img's 'cutting_y' optionnal parameter must be positive",
     return NULL,
-    "//@cutting_y"
+    "@cutting_y"
   );
 
   /* ref_pic/@width : */
-  GET_UINT32(
-    &width, 0,
+  NODE_GET_UINT32(
+    node, &width, 0,
     "Img's 'width' optionnal parameter must be positive",
     return NULL,
-    "//@width"
+    "@width"
   );
 
   /* ref_pic/@height : */
-  GET_UINT32(
-    &height, 0,
+  NODE_GET_UINT32(
+    node, &height, 0,
     "Img's 'height' optionnal parameter must be positive",
     return NULL,
-    "//@height"
+    "@height"
   );
 
   if (NULL == (pic = dupHdmvPicture(pic)))
@@ -853,25 +938,20 @@ HdmvPicturePtr parseRefImgIgsXmlFile(
 
 static int parseReferencePictureIndexerIgsXmlFile(
   IgsCompilerContextPtr ctx,
-  xmlXPathObjectPtr obj,
-  int idx
+  xmlNodePtr node
 )
 {
   HdmvPicturePtr pic;
   lbc * name;
 
-  LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("   Setting root...\n");
-  if (setRootPathFromPathObjectIgsXmlFile(XML_CTX(ctx), obj, idx) < 0)
-    return -1;
-
   LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("   Parsing image...\n");
-  if (NULL == (pic = parseImgIgsXmlFile(ctx, &name)))
+  if (NULL == (pic = parseImgIgsXmlFile(ctx, node, &name)))
     return -1;
 
   if (NULL == name)
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR_FRETURN(
       "Missing reference image 'name' field (line: %u).\n",
-      XML_CTX(ctx)->lastParsedNodeLine
+      node->line
     );
 
   LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("   Adding image to references indexer...\n");
@@ -879,9 +959,6 @@ static int parseReferencePictureIndexerIgsXmlFile(
     goto free_return;
   free(name);
 
-  LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("   Restoring path status...\n");
-  if (restoreLastRootIgsXmlFile(XML_CTX(ctx)) < 0)
-    return -1;
   return 0;
 
 free_return:
@@ -891,61 +968,467 @@ free_return:
 }
 
 int parseReferencePicturesIndexerIgsXmlFile(
-  IgsCompilerContextPtr ctx
+  IgsCompilerContextPtr ctx,
+  xmlNodePtr node
 )
 {
-  xmlXPathObjectPtr imgPathObj;
-  int i, nbImg;
+  xmlNodePtr imgNode;
+  int i;
 
   /* Picture references : */
-  if (NULL == (imgPathObj = GET_OBJ("//reference_imgs/img")))
-    LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN(
-      "Broken XML tree, 'reference_imgs' section is empty.\n"
-    );
-  nbImg = XML_PATH_NODE_NB(imgPathObj);
+  imgNode = CHILD_NODE(CHILD_NODE(node, "reference_imgs"), "img");
 
-  if (0 < nbImg)
+  if (NULL != imgNode)
     LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(" reference_imgs:\n");
 
-  for (i = 0; i < nbImg; i++) {
+  for (i = 0; NULL != imgNode; i++) {
     LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("  reference_img[%d]:\n", i);
-    if (parseReferencePictureIndexerIgsXmlFile(ctx, imgPathObj, i) < 0)
-      goto free_return;
+    if (parseReferencePictureIndexerIgsXmlFile(ctx, imgNode) < 0)
+      return -1;
+    imgNode = NEXT_NODE(imgNode, "img");
   }
 
-  xmlXPathFreeObject(imgPathObj);
   return 0;
+}
 
-free_return:
-  xmlXPathFreeObject(imgPathObj);
-  return -1;
+/** \~english
+ * \brief Parse the pictures of a button state graphic as objects.
+ *
+ * \param ctx Used context.
+ * \param node Button state node (can be NULL).
+ * \param startObjectRef First object id return (0xFFFF if none).
+ * \param endObjectRef Last object id return (0xFFFF if none).
+ * \return int A zero value on success, otherwise a negative value.
+ */
+static int parseButtonStateGraphicIgsXmlFile(
+  IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
+  uint16_t * startObjectRef,
+  uint16_t * endObjectRef
+)
+{
+  xmlNodePtr objNode;
+  int j;
+
+  *startObjectRef = 0xFFFF;
+  *endObjectRef = 0xFFFF;
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("        objects:\n");
+
+  objNode = CHILD_NODE(CHILD_NODE(node, "graphic"), NULL);
+  for (j = 0; NULL != objNode; objNode = NEXT_NODE(objNode, NULL)) {
+    HdmvPicturePtr pic;
+    unsigned id;
+
+    if (xmlStrEqual(objNode->name, (xmlChar *) "img")) {
+      LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("         object[%d]:\n", j);
+      LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Parsing image...\n");
+      pic = parseImgIgsXmlFile(ctx, objNode, NULL);
+    }
+    else if (xmlStrEqual(objNode->name, (xmlChar *) "ref_pic")) {
+      LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("         object[%d]:\n", j);
+      LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Parsing reference image...\n");
+      pic = parseRefImgIgsXmlFile(ctx, objNode);
+    }
+    else
+      continue; /* Unknown/unsupported node */
+
+    if (NULL == pic)
+      return -1;
+
+    LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Adding image to objects...\n");
+
+    if (addObjectIgsCompilerComposition(CUR_COMP(ctx), pic, &id) < 0)
+      return -1;
+    if (UINT16_MAX <= id)
+      LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN("Too many objects.\n");
+
+    if (!j++)
+      *startObjectRef = id;
+    *endObjectRef = id;
+
+    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+      "          object_id: 0x%04X.\n",
+      id
+    );
+  }
+
+  if (!j)
+    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("        None.\n");
+
+  return 0;
+}
+
+/** \~english
+ * \brief Parse a button() structure from IGS XML description file.
+ *
+ * \param ctx Used context.
+ * \param node Button node.
+ * \param btn Return parameters pointer.
+ * \param nextButtonId Next available button_id value.
+ * \return int A zero value on success, otherwise a negative value.
+ */
+static int parseButtonIgsXmlFile(
+  IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
+  HdmvButtonParam * btn,
+  uint16_t * nextButtonId
+)
+{
+  xmlNodePtr neighborNode, stateNode, comNode;
+  HdmvNavigationCommand * last;
+  unsigned nbNavigationCommands;
+
+  btn->commands = NULL;
+
+  /* button/@id */
+  NODE_GET_UINT16(
+    node, &btn->button_id, *nextButtonId,
+    "Button's 'id' optionnal parameter must be between "
+    "0x0000 and 0x1FDF inclusive",
+    return -1,
+    "@id"
+  );
+  *nextButtonId = btn->button_id + 1;
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "       button_id: 0x%" PRIX16 ".\n",
+    btn->button_id
+  );
+
+  if (0x1FDF < btn->button_id)
+    LIBBLU_HDMV_IGS_COMPL_XML_ERROR(
+      "Unexpected 'button_id' value, values shall be between 0x0000 "
+      "and 0x1FDF inclusive.\n"
+    );
+
+  /* button/button_numeric_select_value */
+  NODE_GET_UINT16(
+    node, &btn->button_numeric_select_value, 0xFFFF,
+    "Button's 'button_numeric_select_value' optionnal parameter must be "
+    "between 0x0000 and 0xFFFF inclusive",
+    return -1,
+    "button_numeric_select_value"
+  );
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "       button_numeric_select_value: 0x%" PRIX16 ".\n",
+    btn->button_numeric_select_value
+  );
+
+  /* button/auto_action_flag */
+  NODE_GET_BOOL(
+    node, &btn->auto_action, false,
+    return -1,
+    "auto_action_flag"
+  );
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "       auto_action_flag: %s (0b%x).\n",
+    BOOL_STR(btn->auto_action),
+    btn->auto_action
+  );
+
+  /* button/horizontal_position */
+  NODE_GET_UINT16(
+    node, &btn->button_horizontal_position, -1,
+    "Missing or invalid button's 'horizontal_position' parameter, "
+    "must be between 0x0000 and 0xFFFF inclusive",
+    return -1,
+    "horizontal_position"
+  );
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "       horizontal_position: %" PRIu16 " px.\n",
+    btn->button_horizontal_position
+  );
+
+  /* button/vertical_position */
+  NODE_GET_UINT16(
+    node, &btn->button_vertical_position, -1,
+    "Missing or invalid button's 'vertical_position' parameter, "
+    "must be between 0x0000 and 0xFFFF inclusive",
+    return -1,
+    "vertical_position"
+  );
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "       vertical_position: %" PRIu16 " px.\n",
+    btn->button_vertical_position
+  );
+
+  /* button/neighbor_info */
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("       neighbor_info:\n");
+  neighborNode = CHILD_NODE(node, "neighbor_info");
+
+  NODE_GET_UINT16(
+    neighborNode, &btn->neighbor_info.upper_button_id_ref, btn->button_id,
+    "Missing or invalid button's neighbor 'upper_button' parameter, "
+    "must be between 0x0000 and 0xFFFF inclusive.\n",
+    return -1,
+    "upper_button"
+  );
+
+  NODE_GET_UINT16(
+    neighborNode, &btn->neighbor_info.lower_button_id_ref, btn->button_id,
+    "Missing or invalid button's neighbor 'lower_button' parameter, "
+    "must be between 0x0000 and 0xFFFF inclusive.\n",
+    return -1,
+    "lower_button"
+  );
+
+  NODE_GET_UINT16(
+    neighborNode, &btn->neighbor_info.left_button_id_ref, btn->button_id,
+    "Missing or invalid button's neighbor 'left_button' parameter, "
+    "must be between 0x0000 and 0xFFFF inclusive.\n",
+    return -1,
+    "left_button"
+  );
+
+  NODE_GET_UINT16(
+    neighborNode, &btn->neighbor_info.right_button_id_ref, btn->button_id,
+    "Missing or invalid button's neighbor 'right_button' parameter, "
+    "must be between 0x0000 and 0xFFFF inclusive.\n",
+    return -1,
+    "right_button"
+  );
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        upper_button: 0x%" PRIX16 ".\n",
+    btn->neighbor_info.upper_button_id_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        lower_button: 0x%" PRIX16 ".\n",
+    btn->neighbor_info.lower_button_id_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        left_button:  0x%" PRIX16 ".\n",
+    btn->neighbor_info.left_button_id_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        right_button: 0x%" PRIX16 ".\n",
+    btn->neighbor_info.right_button_id_ref
+  );
+
+  /* Normal state */
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "       normal_state_info:\n"
+  );
+  stateNode = CHILD_NODE(node, "normal_state_info");
+
+  if (
+    parseButtonStateGraphicIgsXmlFile(
+      ctx, stateNode,
+      &btn->normal_state_info.start_object_ref,
+      &btn->normal_state_info.end_object_ref
+    ) < 0
+  )
+    return -1;
+
+  NODE_GET_BOOL(
+    stateNode, &btn->normal_state_info.repeat, false,
+    return -1,
+    "repeat_flag"
+  );
+
+  NODE_GET_BOOL(
+    stateNode, &btn->normal_state_info.complete, false,
+    return -1,
+    "complete_flag"
+  );
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        start_object_id_ref: 0x%04" PRIX16 ".\n",
+    btn->normal_state_info.start_object_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        end_object_id_ref:   0x%04" PRIX16 ".\n",
+    btn->normal_state_info.end_object_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        repeat_flag:         %s (0b%x).\n",
+    BOOL_STR(btn->normal_state_info.repeat),
+    btn->normal_state_info.repeat
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        complete_flag:       %s (0b%x).\n",
+    BOOL_STR(btn->normal_state_info.complete),
+    btn->normal_state_info.complete
+  );
+
+  /* Selected state */
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("       selected_state_info:\n");
+  stateNode = CHILD_NODE(node, "selected_state_info");
+
+  NODE_GET_UINT8(
+    stateNode, &btn->selected_state_info.sound_id_ref, 0xFF,
+    "Invalid button's selected state 'sound_id' parameter, "
+    "must be between 0x00 and 0xFF inclusive",
+    return -1,
+    "sound_id"
+  );
+
+  if (
+    parseButtonStateGraphicIgsXmlFile(
+      ctx, stateNode,
+      &btn->selected_state_info.start_object_ref,
+      &btn->selected_state_info.end_object_ref
+    ) < 0
+  )
+    return -1;
+
+  NODE_GET_BOOL(
+    stateNode, &btn->selected_state_info.repeat, false,
+    return -1,
+    "repeat_flag"
+  );
+
+  NODE_GET_BOOL(
+    stateNode, &btn->selected_state_info.complete, false,
+    return -1,
+    "complete_flag"
+  );
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        start_object_id_ref: 0x%02" PRIX8 ".\n",
+    btn->selected_state_info.sound_id_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        start_object_id_ref: 0x%04" PRIX16 ".\n",
+    btn->selected_state_info.start_object_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        end_object_id_ref:   0x%04" PRIX16 ".\n",
+    btn->selected_state_info.end_object_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        repeat_flag:         %s (0b%x).\n",
+    BOOL_STR(btn->selected_state_info.repeat),
+    btn->selected_state_info.repeat
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        complete_flag:       %s (0b%x).\n",
+    BOOL_STR(btn->selected_state_info.complete),
+    btn->selected_state_info.complete
+  );
+
+  /* Activated state */
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("       activated_state_info:\n");
+  stateNode = CHILD_NODE(node, "activated_state_info");
+
+  NODE_GET_UINT8(
+    stateNode, &btn->activated_state_info.sound_id_ref, 0xFF,
+    "Invalid button's activated state 'sound_id' parameter, "
+    "must be between 0x00 and 0xFF inclusive",
+    return -1,
+    "sound_id"
+  );
+
+  if (
+    parseButtonStateGraphicIgsXmlFile(
+      ctx, stateNode,
+      &btn->activated_state_info.start_object_ref,
+      &btn->activated_state_info.end_object_ref
+    ) < 0
+  )
+    return -1;
+
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        start_object_id_ref: 0x%02" PRIX8 ".\n",
+    btn->activated_state_info.sound_id_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        start_object_id_ref: 0x%04" PRIX16 ".\n",
+    btn->activated_state_info.start_object_ref
+  );
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
+    "        end_object_id_ref:   0x%04" PRIX16 ".\n",
+    btn->activated_state_info.end_object_ref
+  );
+
+  /* Commands */
+  LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("      navigation_commands:\n");
+
+  comNode = CHILD_NODE(CHILD_NODE(node, "commands"), "command");
+  if (NULL == comNode)
+    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("       *no command*\n");
+
+  last = NULL;
+  nbNavigationCommands = 0;
+  for (; NULL != comNode; comNode = NEXT_NODE(comNode, "command")) {
+    HdmvNavigationCommand * com;
+
+    if (NULL == (com = getHdmvNavigationCommandHdmvSegmentsInventory(ctx->inv)))
+      return -1;
+
+    if (NULL != last)
+      setNextHdmvNavigationCommand(last, com);
+    else
+      btn->commands = com;
+
+    /* command/@code */
+    NODE_GET_UINT32(
+      comNode, &com->opCode, -1,
+      "Missing or invalid navigation command 'code' field, "
+      "must be between 0x00000000 and 0xFFFFFFFF inclusive",
+      return -1,
+      "@code"
+    );
+
+    /* command/@destination */
+    NODE_GET_UINT32(
+      comNode, &com->dst, -1,
+      "Missing or invalid navigation command 'destination' field, "
+      "must be between 0x00000000 and 0xFFFFFFFF inclusive",
+      return -1,
+      "@destination"
+    );
+
+    /* command/@source */
+    NODE_GET_UINT32(
+      comNode, &com->src, -1,
+      "Missing or invalid navigation command 'source' field, "
+      "must be between 0x00000000 and 0xFFFFFFFF inclusive",
+      return -1,
+      "@source"
+    );
+
+    last = com;
+    nbNavigationCommands++;
+  }
+
+  btn->number_of_navigation_commands = nbNavigationCommands;
+
+  return 0;
 }
 
 int parsePageBogIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   HdmvButtonOverlapGroupParameters * bog,
   int index,
   uint16_t * nextButtonId
 )
 {
-  int nbButtons;
-  int i, j;
+  xmlNodePtr btnNode;
+  unsigned nbButtons;
+  int i;
 
   bool automatic_default_valid_button_id_ref;
   bool default_valid_button_id_refPresent;
 
   assert(NULL != ctx);
+  assert(NULL != node);
   assert(NULL != bog);
   assert(NULL != nextButtonId);
 
   /* bog/default_valid_button */
-  GET_UINT16(
-    &bog->default_valid_button_id_ref, 0xFFFF,
+  NODE_GET_UINT16(
+    node, &bog->default_valid_button_id_ref, 0xFFFF,
     "BOG's 'default_valid_button' optionnal parameter must be between "
     "0x0000 and 0xFFFF inclusive",
     return -1,
-    "//bog[%d]/default_valid_button",
-    index+1
+    "default_valid_button"
   );
 
   LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
@@ -956,16 +1439,16 @@ int parsePageBogIgsXmlFile(
     (0xFFFF == bog->default_valid_button_id_ref)
   ;
   automatic_default_valid_button_id_ref =
-    !EXISTS("//bog[%d]/default_valid_button", index+1)
+    (NULL == CHILD_NODE(node, "default_valid_button"))
   ;
 
-  nbButtons = NB_OBJ("//bog[%d]/button", index+1);
+  nbButtons = NB_CHILD_NODES(node, "button");
   if (HDMV_MAX_NB_ICS_BUTTONS < nbButtons)
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN(
       "Number of buttons in BOG %d at line %u in input XML file is invalid "
-      "(%d, shall be between 0-255).\n",
+      "(%u, shall be between 0-255).\n",
       index,
-      XML_CTX(ctx)->lastParsedNodeLine,
+      node->line,
       nbButtons
     );
 
@@ -979,54 +1462,33 @@ int parsePageBogIgsXmlFile(
     );
     LIBBLU_HDMV_IGS_COMPL_XML_WARNING(
       "BOG %d at line %u is empty.\n",
-      index, XML_CTX(ctx)->lastParsedNodeLine
+      index, node->line
     );
   }
 
   bog->number_of_buttons = 0;
-  for (i = 0; i < nbButtons; i++) {
+  btnNode = CHILD_NODE(node, "button");
+  for (i = 0; NULL != btnNode; i++) {
     HdmvButtonParam * btn;
-    int nbNavigationCommands;
 
     btn = getHdmvButtonParamHdmvSegmentsInventory(ctx->inv);
     if (NULL == btn)
       return -1;
 
-    btn->commands = NULL;
-
     LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
       "      button[%d]:\n",
       i
     );
 
-    /* bog/button[i]/@id */
-    GET_UINT16(
-      &btn->button_id,
-      *nextButtonId,
-      "Button's 'id' optionnal parameter must be between "
-      "0x0000 and 0x1FDF inclusive",
-      return -1,
-      "//bog[%d]/button[%d]/@id",
-      index+1, i+1
-    );
-    *nextButtonId = btn->button_id + 1;
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "       button_id: 0x%" PRIX16 ".\n",
-      btn->button_id
-    );
-
-    if (0x1FDF < btn->button_id)
-      LIBBLU_HDMV_IGS_COMPL_XML_ERROR(
-        "Unexpected 'button_id' value, values shall be between 0x0000 "
-        "and 0x1FDF inclusive.\n"
-      );
+    /* bog/button[i] */
+    if (parseButtonIgsXmlFile(ctx, btnNode, btn, nextButtonId) < 0)
+      return -1;
 
     if (0 < i && btn->button_id <= bog->buttons[i-1]->button_id) {
       LIBBLU_HDMV_IGS_COMPL_XML_ERROR(
         "BOG's button ids order broken (duplicated values or broken order) "
         "(line: %u).\n",
-        XML_CTX(ctx)->lastParsedNodeLine
+        btnNode->line
       );
       LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN(
         " -> Buttons' ids shall strictly grows "
@@ -1037,557 +1499,8 @@ int parsePageBogIgsXmlFile(
     if (btn->button_id == bog->default_valid_button_id_ref)
       default_valid_button_id_refPresent = true;
 
-    /* bog/button[i]/button_numeric_select_value */
-    GET_UINT16(
-      &btn->button_numeric_select_value,
-      0xFFFF,
-      "Button's 'button_numeric_select_value' optionnal parameter must be "
-      "between 0x0000 and 0xFFFF inclusive",
-      return -1,
-      "//bog[%d]/button[%d]/button_numeric_select_value",
-      index+1, i+1
-    );
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "       button_numeric_select_value: 0x%" PRIX16 ".\n",
-      btn->button_numeric_select_value
-    );
-
-    /* bog/button[i]/auto_action_flag */
-    GET_BOOL(
-      &btn->auto_action,
-      false,
-      return -1,
-      "//bog[%d]/button[%d]/auto_action_flag",
-      index+1, i+1
-    );
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "       auto_action_flag: %s (0b%x).\n",
-      BOOL_STR(btn->auto_action),
-      btn->auto_action
-    );
-
-    /* bog/button[i]/horizontal_position */
-    GET_UINT16(
-      &btn->button_horizontal_position,
-      -1,
-      "Missing or invalid button's 'horizontal_position' parameter, "
-      "must be between 0x0000 and 0xFFFF inclusive",
-      return -1,
-      "//bog[%d]/button[%d]/horizontal_position",
-      index+1, i+1
-    );
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "       horizontal_position: %" PRIu16 " px.\n",
-      btn->button_horizontal_position
-    );
-
-    /* bog/button[i]/vertical_position */
-    GET_UINT16(
-      &btn->button_vertical_position,
-      -1,
-      "Missing or invalid button's 'vertical_position' parameter, "
-      "must be between 0x0000 and 0xFFFF inclusive",
-      return -1,
-      "//bog[%d]/button[%d]/vertical_position",
-      index+1, i+1
-    );
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "       vertical_position: %" PRIu16 " px.\n",
-      btn->button_vertical_position
-    );
-
-    /* neighbor_info */
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("       neighbor_info:\n");
-
-    if (0 < NB_OBJ("//bog[%d]/button[%d]/neighbor_info", index+1, i+1)) {
-      GET_UINT16(
-        &btn->neighbor_info.upper_button_id_ref,
-        btn->button_id,
-        "Missing or invalid button's neighbor 'upper_button' parameter, "
-        "must be between 0x0000 and 0xFFFF inclusive (line %u).\n",
-        return -1,
-        "//bog[%d]/button[%d]/neighbor_info/upper_button",
-        index+1, i+1
-      );
-
-      GET_UINT16(
-        &btn->neighbor_info.lower_button_id_ref,
-        btn->button_id,
-        "Missing or invalid button's neighbor 'lower_button' parameter, "
-        "must be between 0x0000 and 0xFFFF inclusive (line %u).\n",
-        return -1,
-        "//bog[%d]/button[%d]/neighbor_info/lower_button",
-        index+1, i+1
-      );
-
-      GET_UINT16(
-        &btn->neighbor_info.left_button_id_ref,
-        btn->button_id,
-        "Missing or invalid button's neighbor 'left_button' parameter, "
-        "must be between 0x0000 and 0xFFFF inclusive (line %u).\n",
-        return -1,
-        "//bog[%d]/button[%d]/neighbor_info/left_button",
-        index+1, i+1
-      );
-
-      GET_UINT16(
-        &btn->neighbor_info.right_button_id_ref,
-        btn->button_id,
-        "Missing or invalid button's neighbor 'right_button' parameter, "
-        "must be between 0x0000 and 0xFFFF inclusive (line %u).\n",
-        return -1,
-        "//bog[%d]/button[%d]/neighbor_info/right_button",
-        index+1, i+1
-      );
-    }
-    else
-      btn->neighbor_info.upper_button_id_ref = btn->button_id,
-      btn->neighbor_info.lower_button_id_ref = btn->button_id,
-      btn->neighbor_info.left_button_id_ref  = btn->button_id,
-      btn->neighbor_info.right_button_id_ref = btn->button_id
-    ;
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        upper_button: 0x%" PRIX16 ".\n",
-      btn->neighbor_info.upper_button_id_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        lower_button: 0x%" PRIX16 ".\n",
-      btn->neighbor_info.lower_button_id_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        left_button:  0x%" PRIX16 ".\n",
-      btn->neighbor_info.left_button_id_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        right_button: 0x%" PRIX16 ".\n",
-      btn->neighbor_info.right_button_id_ref
-    );
-
-    /* Normal state */
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "       normal_state_info:\n"
-    );
-
-    if (EXISTS("//bog[%d]/button[%d]/normal_state_info", index+1, i+1)) {
-      xmlXPathObjectPtr imgPathObj;
-      int nbStatesImgs;
-
-      LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("        objects:\n");
-
-      imgPathObj = GET_OBJ(
-        "//bog[%d]/button[%d]/normal_state_info/graphic/*",
-        index+1, i+1
-      );
-      nbStatesImgs = XML_PATH_NODE_NB(imgPathObj);
-
-      if (!nbStatesImgs) {
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("        None.\n");
-        btn->normal_state_info.start_object_ref = 0xFFFF;
-        btn->normal_state_info.end_object_ref   = 0xFFFF;
-      }
-
-      for (j = 0; j < nbStatesImgs; j++) {
-        HdmvPicturePtr pic;
-        unsigned id;
-        bool refPic;
-
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("         object[%d]:\n", j);
-
-        if (!strcmp((char *) XML_PATH_NODE(imgPathObj, j)->name, "img"))
-          refPic = false;
-        else if (!strcmp((char *) XML_PATH_NODE(imgPathObj, j)->name, "ref_pic"))
-          refPic = true;
-        else
-          continue; /* Unknown/unsupported node */
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Setting root...\n");
-        if (setRootPathFromPathObjectIgsXmlFile(XML_CTX(ctx), imgPathObj, j) < 0)
-          return -1;
-
-        if (!refPic) {
-          LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Parsing image...\n");
-          if (NULL == (pic = parseImgIgsXmlFile(ctx, NULL)))
-            return -1;
-        }
-        else {
-          LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Parsing reference image...\n");
-          if (NULL == (pic = parseRefImgIgsXmlFile(ctx)))
-            return -1;
-        }
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Adding image to objects...\n");
-
-        if (addObjectIgsCompilerComposition(CUR_COMP(ctx), pic, &id) < 0)
-          return -1;
-        if (UINT16_MAX <= id)
-          LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN("Too many objects.\n");
-
-        if (j == 0)
-          btn->normal_state_info.start_object_ref = id;
-        if (j == nbStatesImgs-1)
-          btn->normal_state_info.end_object_ref = id;
-
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-          "          object_id: 0x%04X.\n",
-          id
-        );
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("   Restoring path status...\n");
-        if (restoreLastRootIgsXmlFile(XML_CTX(ctx)) < 0)
-          return -1;
-      }
-
-      xmlXPathFreeObject(imgPathObj);
-
-      GET_BOOL(
-        &btn->normal_state_info.repeat,
-        false,
-        return -1,
-        "//bog[%d]/button[%d]/normal_state_info/repeat_flag",
-        index+1, i+1
-      );
-
-      GET_BOOL(
-        &btn->normal_state_info.complete,
-        false,
-        return -1,
-        "//bog[%d]/button[%d]/normal_state_info/complete_flag",
-        index+1, i+1
-      );
-    }
-    else
-      btn->normal_state_info.start_object_ref = 0xFFFF,
-      btn->normal_state_info.end_object_ref   = 0xFFFF,
-      btn->normal_state_info.repeat           = false,
-      btn->normal_state_info.complete         = false
-    ;
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        start_object_id_ref: 0x%04" PRIX16 ".\n",
-      btn->normal_state_info.start_object_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        end_object_id_ref:   0x%04" PRIX16 ".\n",
-      btn->normal_state_info.end_object_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        repeat_flag:         %s (0b%x).\n",
-      BOOL_STR(btn->normal_state_info.repeat),
-      btn->normal_state_info.repeat
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        complete_flag:       %s (0b%x).\n",
-      BOOL_STR(btn->normal_state_info.complete),
-      btn->normal_state_info.complete
-    );
-
-    /* Selected state */
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("       selected_state_info:\n");
-
-    if (EXISTS("//bog[%d]/button[%d]/selected_state_info", index+1, i+1)) {
-      xmlXPathObjectPtr imgPathObj;
-      int nbStatesImgs;
-
-      GET_UINT8(
-        &btn->selected_state_info.sound_id_ref, 0xFF,
-        "Invalid button's selected state 'sound_id' parameter, "
-        "must be between 0x00 and 0xFF inclusive",
-        return -1,
-        "//bog[%d]/button[%d]/selected_state_info/sound_id",
-        index+1, i+1
-      );
-
-      LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("        objects:\n");
-
-      imgPathObj = GET_OBJ(
-        "//bog[%d]/button[%d]/selected_state_info/graphic/*",
-        index+1, i+1
-      );
-      nbStatesImgs = XML_PATH_NODE_NB(imgPathObj);
-
-      if (!nbStatesImgs) {
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("        None.\n");
-        btn->selected_state_info.start_object_ref = 0xFFFF;
-        btn->selected_state_info.end_object_ref   = 0xFFFF;
-      }
-
-      for (j = 0; j < nbStatesImgs; j++) {
-        HdmvPicturePtr pic;
-        unsigned id;
-        bool refPic;
-
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("         object[%d]:\n", j);
-
-        if (!strcmp((char *) XML_PATH_NODE(imgPathObj, j)->name, "img"))
-          refPic = false;
-        else if (!strcmp((char *) XML_PATH_NODE(imgPathObj, j)->name, "ref_pic"))
-          refPic = true;
-        else
-          continue; /* Unknown/unsupported node */
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Setting root...\n");
-        if (setRootPathFromPathObjectIgsXmlFile(XML_CTX(ctx), imgPathObj, j) < 0)
-          return -1;
-
-        if (!refPic) {
-          LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Parsing image...\n");
-          if (NULL == (pic = parseImgIgsXmlFile(ctx, NULL)))
-            return -1;
-        }
-        else {
-          LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Parsing reference image...\n");
-          if (NULL == (pic = parseRefImgIgsXmlFile(ctx)))
-            return -1;
-        }
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Adding image to objects...\n");
-
-        if (addObjectIgsCompilerComposition(CUR_COMP(ctx), pic, &id) < 0)
-          return -1;
-        if (UINT16_MAX <= id)
-          LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN("Too many objects.\n");
-
-        if (j == 0)
-          btn->selected_state_info.start_object_ref = id;
-        if (j == nbStatesImgs-1)
-          btn->selected_state_info.end_object_ref = id;
-
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-          "          object_id: 0x%04X.\n",
-          id
-        );
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("   Restoring path status...\n");
-        if (restoreLastRootIgsXmlFile(XML_CTX(ctx)) < 0)
-          return -1;
-      }
-
-      xmlXPathFreeObject(imgPathObj);
-
-      GET_BOOL(
-        &btn->selected_state_info.repeat,
-        false,
-        return -1,
-        "//bog[%d]/button[%d]/selected_state_info/repeat_flag",
-        index+1, i+1
-      );
-
-      GET_BOOL(
-        &btn->selected_state_info.complete,
-        false,
-        return -1,
-        "//bog[%d]/button[%d]/selected_state_info/complete_flag",
-        index+1, i+1
-      );
-    }
-    else
-      btn->selected_state_info.sound_id_ref       = 0xFF,
-      btn->selected_state_info.start_object_ref = 0xFFFF,
-      btn->selected_state_info.end_object_ref   = 0xFFFF,
-      btn->selected_state_info.repeat           = false,
-      btn->selected_state_info.complete         = false
-    ;
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        start_object_id_ref: 0x%02" PRIX8 ".\n",
-      btn->selected_state_info.sound_id_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        start_object_id_ref: 0x%04" PRIX16 ".\n",
-      btn->selected_state_info.start_object_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        end_object_id_ref:   0x%04" PRIX16 ".\n",
-      btn->selected_state_info.end_object_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        repeat_flag:         %s (0b%x).\n",
-      BOOL_STR(btn->selected_state_info.repeat),
-      btn->selected_state_info.repeat
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        complete_flag:       %s (0b%x).\n",
-      BOOL_STR(btn->selected_state_info.complete),
-      btn->selected_state_info.complete
-    );
-
-    /* Activated state */
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("       activated_state_info:\n");
-
-    if (EXISTS("//bog[%d]/button[%d]/activated_state_info", index+1, i+1)) {
-      xmlXPathObjectPtr imgPathObj;
-      int nbStatesImgs;
-
-      GET_UINT8(
-        &btn->activated_state_info.sound_id_ref, 0xFF,
-        "Invalid button's activated state 'sound_id' parameter, "
-        "must be between 0x00 and 0xFF inclusive",
-        return -1,
-        "//bog[%d]/button[%d]/activated_state_info/sound_id",
-        index+1, i+1
-      );
-
-      LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("        objects:\n");
-
-      imgPathObj = GET_OBJ(
-        "//bog[%d]/button[%d]/activated_state_info/graphic/*",
-        index+1, i+1
-      );
-      nbStatesImgs = XML_PATH_NODE_NB(imgPathObj);
-
-      if (!nbStatesImgs) {
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("        None.\n");
-        btn->activated_state_info.start_object_ref = 0xFFFF;
-        btn->activated_state_info.end_object_ref   = 0xFFFF;
-      }
-
-      for (j = 0; j < nbStatesImgs; j++) {
-        HdmvPicturePtr pic;
-        unsigned id;
-        bool refPic;
-
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("         object[%d]:\n", j);
-
-        if (!strcmp((char *) XML_PATH_NODE(imgPathObj, j)->name, "img"))
-          refPic = false;
-        else if (!strcmp((char *) XML_PATH_NODE(imgPathObj, j)->name, "ref_pic"))
-          refPic = true;
-        else
-          continue; /* Unknown/unsupported node */
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Setting root...\n");
-        if (setRootPathFromPathObjectIgsXmlFile(XML_CTX(ctx), imgPathObj, j) < 0)
-          return -1;
-
-        if (!refPic) {
-          LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Parsing image...\n");
-          if (NULL == (pic = parseImgIgsXmlFile(ctx, NULL)))
-            return -1;
-        }
-        else {
-          LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Parsing reference image...\n");
-          if (NULL == (pic = parseRefImgIgsXmlFile(ctx)))
-            return -1;
-        }
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("          Adding image to objects...\n");
-
-        if (addObjectIgsCompilerComposition(CUR_COMP(ctx), pic, &id) < 0)
-          return -1;
-        if (UINT16_MAX <= id)
-          LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN("Too many objects.\n");
-
-        if (j == 0)
-          btn->activated_state_info.start_object_ref = id;
-        if (j == nbStatesImgs-1)
-          btn->activated_state_info.end_object_ref = id;
-
-        LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-          "          object_id: 0x%04X.\n",
-          id
-        );
-
-        LIBBLU_HDMV_IGS_COMPL_XML_DEBUG("   Restoring path status...\n");
-        if (restoreLastRootIgsXmlFile(XML_CTX(ctx)) < 0)
-          return -1;
-      }
-
-      xmlXPathFreeObject(imgPathObj);
-    }
-    else
-      btn->activated_state_info.sound_id_ref       = 0xFF,
-      btn->activated_state_info.start_object_ref = 0xFFFF,
-      btn->activated_state_info.end_object_ref   = 0xFFFF
-    ;
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        start_object_id_ref: 0x%02" PRIX8 ".\n",
-      btn->activated_state_info.sound_id_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        start_object_id_ref: 0x%04" PRIX16 ".\n",
-      btn->activated_state_info.start_object_ref
-    );
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "        end_object_id_ref:   0x%04" PRIX16 ".\n",
-      btn->activated_state_info.end_object_ref
-    );
-
-    /* Commands */
-    nbNavigationCommands = NB_OBJ(
-      "//bog[%d]/button[%d]/commands/command",
-      index+1, i+1
-    );
-
-    if (HDMV_MAX_NB_ICS_BUTTONS < nbButtons)
-      LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN(
-        "Number of buttons in BOG %d at line %u in input XML file is invalid "
-        "(%d, shall be between 0-255).\n",
-        index,
-        XML_CTX(ctx)->lastParsedNodeLine,
-        nbButtons
-      );
-
-    LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("      navigation_commands:\n");
-    if (!nbNavigationCommands)
-      LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG("       *no command*\n");
-
-    {
-      HdmvNavigationCommand * last = NULL;
-
-      for (j = 0; j < nbNavigationCommands; j++) {
-        HdmvNavigationCommand * com;
-
-        if (NULL == (com = getHdmvNavigationCommandHdmvSegmentsInventory(ctx->inv)))
-          return -1;
-
-        if (NULL != last)
-          setNextHdmvNavigationCommand(last, com);
-        else
-          btn->commands = com;
-
-        /* command/@code */
-        GET_UINT32(
-          &com->opCode, -1,
-          "Missing or invalid navigation command 'code' field, "
-          "must be between 0x00000000 and 0xFFFFFFFF inclusive",
-          return -1,
-          "//bog[%d]/button[%d]/commands/command[%d]/@code",
-          index+1, i+1, j+1
-        );
-
-        /* command/@destination */
-        GET_UINT32(
-          &com->dst, -1,
-          "Missing or invalid navigation command 'destination' field, "
-          "must be between 0x00000000 and 0xFFFFFFFF inclusive",
-          return -1,
-          "//bog[%d]/button[%d]/commands/command[%d]/@destination",
-          index+1, i+1, j+1
-        );
-
-        /* command/@source */
-        GET_UINT32(
-          &com->src, -1,
-          "Missing or invalid navigation command 'source' field, "
-          "must be between 0x00000000 and 0xFFFFFFFF inclusive",
-          return -1,
-          "//bog[%d]/button[%d]/commands/command[%d]/@source",
-          index+1, i+1, j+1
-        );
-
-        last = com;
-      }
-
-      btn->number_of_navigation_commands = nbNavigationCommands;
-    }
-
     bog->buttons[bog->number_of_buttons++] = btn;
+    btnNode = NEXT_NODE(btnNode, "button");
   }
 
   if (!default_valid_button_id_refPresent)
@@ -1604,32 +1517,31 @@ int parsePageBogIgsXmlFile(
 
 int parsePageIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   HdmvPageParameters * page,
   int index,
   uint8_t * nextPageId
 )
 {
+  xmlNodePtr paramNode, uopNode, bogNode;
   unsigned i, nbBogs;
   uint16_t button_id;
 
-  xmlXPathObjectPtr bogPathObj;
-
   bool automaticDefaultSelectedButtonId;
   bool defaultSelectedButtonIdPresent;
   bool defaultActivatedButtonIdPresent;
 
   assert(NULL != ctx);
+  assert(NULL != node);
   assert(NULL != page);
   assert(0 <= index && index < UINT8_MAX);
 
-  GET_UINT8(
-    &page->page_id,
-    *nextPageId,
+  NODE_GET_UINT8(
+    node, &page->page_id, *nextPageId,
     "Page's 'page_id' optionnal parameter must be between "
     "0x00 and 0xFE inclusive",
     return -1,
-    "//page[%d]/@id",
-    index+1
+    "@id"
   );
   *nextPageId = page->page_id + 1;
 
@@ -1646,12 +1558,11 @@ int parsePageIgsXmlFile(
 
 #if 0
   /* page/@version */
-  GET_UINT8(
-    &page->page_version_number, 0x00,
+  NODE_GET_UINT8(
+    node, &page->page_version_number, 0x00,
     "Page's 'version' optionnal parameter must be between 0 and 255 inclusive",
     return -1,
-    "//page[%d]/@version",
-    index+1
+    "@version"
   );
 
   LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
@@ -1661,14 +1572,13 @@ int parsePageIgsXmlFile(
 #endif
   page->page_version_number = 0x00;
 
+  paramNode = CHILD_NODE(node, "parameters");
+
   /* page/parameters/uop */
   page->UO_mask_table = ctx->data.commonUopMask; /* Applying global flags. */
 
-  if (EXISTS("//page[%d]/parameters/uop", index+1)) {
-    char uopPath[50];
-    snprintf(uopPath, 50, "//page[%d]/parameters/uop", index+1);
-
-    if (parseParametersUopIgsXmlFile(ctx, uopPath, &page->UO_mask_table) < 0)
+  if (NULL != (uopNode = CHILD_NODE(paramNode, "uop"))) {
+    if (parseParametersUopIgsXmlFile(ctx, uopNode, &page->UO_mask_table) < 0)
       return -1;
   }
   LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
@@ -1681,13 +1591,12 @@ int parsePageIgsXmlFile(
   );
 
   /* page/parameters/animation_frame_rate_code */
-  GET_UINT8(
-    &page->animation_frame_rate_code, 0x00,
+  NODE_GET_UINT8(
+    paramNode, &page->animation_frame_rate_code, 0x00,
     "Page's parameter 'animation_frame_rate_code' optionnal parameter must "
     "be between 0 and 255 inclusive",
     return -1,
-    "//page[%d]/parameters/animation_frame_rate_code",
-    index+1
+    "animation_frame_rate_code"
   );
 
   LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
@@ -1696,13 +1605,12 @@ int parsePageIgsXmlFile(
   );
 
   /* page/parameters/default_selected_button */
-  GET_UINT16(
-    &page->default_selected_button_id_ref, 0xFFFF,
+  NODE_GET_UINT16(
+    paramNode, &page->default_selected_button_id_ref, 0xFFFF,
     "Page's parameter 'default_selected_button' optionnal parameter must be "
     "between 0x0000 and 0xFFFF inclusive",
     return -1,
-    "//page[%d]/parameters/default_selected_button",
-    index+1
+    "default_selected_button"
   );
 
   LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
@@ -1711,20 +1619,19 @@ int parsePageIgsXmlFile(
   );
 
   automaticDefaultSelectedButtonId =
-    !EXISTS("//page[%d]/parameters/default_selected_button", index+1)
+    (NULL == CHILD_NODE(paramNode, "default_selected_button"))
   ;
   defaultSelectedButtonIdPresent =
     (0xFFFF == page->default_selected_button_id_ref)
   ;
 
   /* page/parameters/default_activated_button */
-  GET_UINT16(
-    &page->default_activated_button_id_ref, 0xFFFF,
+  NODE_GET_UINT16(
+    paramNode, &page->default_activated_button_id_ref, 0xFFFF,
     "Page's parameter 'default_selected_button' optionnal parameter must be "
     "between 0x0000 and 0xFFFF inclusive",
     return -1,
-    "//page[%d]/parameters/default_activated_button",
-    index+1
+    "default_activated_button"
   );
 
   LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
@@ -1757,11 +1664,11 @@ int parsePageIgsXmlFile(
   );
 
   /* page/bog */
-  nbBogs = NB_OBJ("//page[%d]/bog", index+1);
+  nbBogs = NB_CHILD_NODES(node, "bog");
   if (HDMV_MAX_NB_ICS_BOGS < nbBogs)
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN(
       "Number of BOGs in IGS page %d described in input XML file is invalid "
-      "(%d, shall be between 1-255).\n",
+      "(%u, shall be between 1-255).\n",
       index, nbBogs
     );
 
@@ -1779,29 +1686,16 @@ int parsePageIgsXmlFile(
     );
   }
 
-  /* Set path for relative path accessing: */
-  if (0 < nbBogs) {
-    if (NULL == (bogPathObj = GET_OBJ("//page[%d]", index+1)))
-      LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN(
-        "Broken XML tree, missing 'page' section in 'composition'.\n"
-      );
-
-    if (setRootPathFromPathObjectIgsXmlFile(XML_CTX(ctx), bogPathObj, 0) < 0)
-      return -1;
-  }
-  else
-    bogPathObj = NULL;
-
-
   button_id = 0x0000;
   page->number_of_BOGs = 0;
 
-  for (i = 0; i < nbBogs; i++) {
+  bogNode = CHILD_NODE(node, "bog");
+  for (i = 0; NULL != bogNode; i++) {
     HdmvButtonOverlapGroupParameters * bog;
     unsigned j;
 
     LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
-      "    bog[%d]:\n",
+      "    bog[%u]:\n",
       i
     );
 
@@ -1810,7 +1704,7 @@ int parsePageIgsXmlFile(
       return -1;
 
     /* page/bog[i] */
-    if (parsePageBogIgsXmlFile(ctx, bog, i, &button_id) < 0)
+    if (parsePageBogIgsXmlFile(ctx, bogNode, bog, i, &button_id) < 0)
       return -1;
 
     if (bog->default_valid_button_id_ref == page->default_selected_button_id_ref)
@@ -1821,6 +1715,7 @@ int parsePageIgsXmlFile(
     }
 
     page->bogs[page->number_of_BOGs++] = bog;
+    bogNode = NEXT_NODE(bogNode, "bog");
   }
 
   if (!defaultSelectedButtonIdPresent)
@@ -1839,13 +1734,6 @@ int parsePageIgsXmlFile(
       page->page_id
     );
 
-  if (NULL != bogPathObj) {
-    /* Restore original path */
-    if (restoreLastRootIgsXmlFile(XML_CTX(ctx)) < 0)
-      return -1;
-    xmlXPathFreeObject(bogPathObj);
-  }
-
   if (automaticDefaultSelectedButtonId && 0 < page->number_of_BOGs)
     page->default_selected_button_id_ref = page->bogs[0]->buttons[0]->button_id;
 
@@ -1856,13 +1744,16 @@ int parsePageIgsXmlFile(
 
 int parsePagesIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   HdmvICParameters * compo
 )
 {
-  int i, nbPages;
+  xmlNodePtr pageNode;
+  unsigned nbPages;
+  int i;
   uint8_t page_id;
 
-  nbPages = NB_OBJ("//page");
+  nbPages = NB_CHILD_NODES(node, "page");
   if (nbPages < 1 || HDMV_MAX_NB_ICS_PAGES < nbPages)
     LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN(
       "Number of IGS pages described in input XML file is invalid "
@@ -1876,7 +1767,8 @@ int parsePagesIgsXmlFile(
   page_id = 0x00;
   compo->number_of_pages = 0;
 
-  for (i = 0; i < nbPages; i++) {
+  pageNode = CHILD_NODE(node, "page");
+  for (i = 0; NULL != pageNode; i++) {
     HdmvPageParameters * page;
 
     LIBBLU_HDMV_IGS_COMPL_XML_PARSING_DEBUG(
@@ -1887,10 +1779,11 @@ int parsePagesIgsXmlFile(
     if (NULL == (page = getHdmvPageParametersHdmvSegmentsInventory(ctx->inv)))
       return -1;
 
-    if (parsePageIgsXmlFile(ctx, page, i, &page_id) < 0)
+    if (parsePageIgsXmlFile(ctx, pageNode, page, i, &page_id) < 0)
       return -1;
 
     compo->pages[compo->number_of_pages++] = page;
+    pageNode = NEXT_NODE(pageNode, "page");
   }
 
   return 0;
@@ -1898,6 +1791,7 @@ int parsePagesIgsXmlFile(
 
 int parseCompositionIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   IgsCompilerCompositionPtr compo
 )
 {
@@ -1912,10 +1806,10 @@ int parseCompositionIgsXmlFile(
   if (parseCompositionParametersIgsXmlFile(ctx, &compo->interactiveComposition) < 0)
     return -1;
 
-  if (parseReferencePicturesIndexerIgsXmlFile(ctx) < 0)
+  if (parseReferencePicturesIndexerIgsXmlFile(ctx, node) < 0)
     return -1;
 
-  if (parsePagesIgsXmlFile(ctx, &compo->interactiveComposition) < 0)
+  if (parsePagesIgsXmlFile(ctx, node, &compo->interactiveComposition) < 0)
     return -1;
 
   return 0;
@@ -1926,6 +1820,7 @@ int parseCompositionsIgsXmlFile(
 )
 {
   xmlXPathObjectPtr compPathObj;
+  xmlNodePtr compNode;
   IgsCompilerCompositionPtr compo;
   int nbCompos, i;
 
@@ -1956,10 +1851,11 @@ int parseCompositionsIgsXmlFile(
       return -1;
     ctx->data.compositions[ctx->data.nbCompo] = compo;
 
+    compNode = XML_PATH_NODE(compPathObj, i);
     if (setRootPathFromPathObjectIgsXmlFile(XML_CTX(ctx), compPathObj, i) < 0)
       return -1;
 
-    if (parseCompositionIgsXmlFile(ctx, compo) < 0)
+    if (parseCompositionIgsXmlFile(ctx, compNode, compo) < 0)
       return -1;
 
     if (restoreLastRootIgsXmlFile(XML_CTX(ctx)) < 0)
@@ -1972,6 +1868,83 @@ int parseCompositionsIgsXmlFile(
   return 0;
 }
 
+static int collectPictureFileIgsXmlFile(
+  HdmvPicturesLoaderPtr loader,
+  xmlXPathObjectPtr obj,
+  int idx
+)
+{
+  xmlChar * string;
+  lbc * imgPath;
+  int ret;
+
+  /* img/@path, read from node since setting it as root would detach it */
+  string = xmlGetProp(XML_PATH_NODE(obj, idx), (const xmlChar *) "path");
+  if (NULL == string)
+    return 0; /* Reported on parsing */
+
+  if (NULL == (imgPath = lbc_utf8_convto(string))) {
+    freeXmlCharPtr(&string);
+    LIBBLU_HDMV_IGS_COMPL_XML_ERROR_RETURN("Memory allocation error.\n");
+  }
+  freeXmlCharPtr(&string);
+
+  ret = addFileHdmvPicturesLoader(loader, imgPath);
+  free(imgPath);
+  return ret;
+}
+
+/** \~english
+ * \brief Decode every picture file referenced in the XML file.
+ *
+ * \param ctx Used context.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Pictures are decoded in parallel prior to compositions parsing, which
+ * then only duplicate them.
+ */
+static int loadPicturesIgsXmlFile(
+  IgsCompilerContextPtr ctx
+)
+{
+  HdmvPicturesLoaderPtr loader;
+  xmlXPathObjectPtr imgPathObj;
+  int i, nbImg;
+
+  if (NULL == (loader = createHdmvPicturesLoader()))
+    return -1;
+
+  imgPathObj = GET_OBJ("//img");
+  nbImg = XML_PATH_NODE_NB(imgPathObj);
+
+  for (i = 0; i < nbImg; i++) {
+    if (collectPictureFileIgsXmlFile(loader, imgPathObj, i) < 0)
+      goto free_return;
+  }
+
+  LIBBLU_HDMV_IGS_COMPL_XML_INFO(
+    "Decoding %u picture(s).\n",
+    loader->nbUsedEntries
+  );
+
+  if (
+    loadHdmvPicturesLoader(
+      loader, ctx->loadedPics, &ctx->imgLibs, ctx->conf, ctx->nbThreads
+    ) < 0
+  )
+    goto free_return;
+
+  xmlXPathFreeObject(imgPathObj);
+  destroyHdmvPicturesLoader(loader);
+  return 0;
+
+free_return:
+  xmlXPathFreeObject(imgPathObj);
+  destroyHdmvPicturesLoader(loader);
+  return -1;
+}
+
 int parseIgsXmlFile(
   IgsCompilerContextPtr ctx
 )
@@ -1992,6 +1965,9 @@ int parseIgsXmlFile(
   if (parseParametersIgsXmlFile(ctx) < 0)
     goto free_return;
 
+  if (loadPicturesIgsXmlFile(ctx) < 0)
+    goto free_return;
+
   if (parseCompositionsIgsXmlFile(ctx) < 0)
     goto free_return;
 
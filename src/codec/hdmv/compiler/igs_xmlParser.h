@@ -175,13 +175,13 @@ uint16_t addObjPicIgsCompilerComposition(
  * \brief Parse UO_mask_tables() structure from IGS XML description file.
  *
  * \param ctx Used context.
- * \param path Structure root path.
+ * \param node Structure 'uop' node.
  * \param maskDest Destination mask.
  * \return int A zero value on success, otherwise a negative value.
  */
 int parseParametersUopIgsXmlFile(
   IgsCompilerContextPtr ctx,
-  const char * path,
+  xmlNodePtr node,
   uint64_t * maskDest
 );
 
@@ -237,14 +237,14 @@ int parseCompositionParametersIgsXmlFile(
  * \brief Parse and return a picture from IGS XML description file.
  *
  * \param ctx Used context.
+ * \param node Picture 'img' node.
  * \param imgFilename Optionnal opened picture filename return (can be NULL).
  * \return HdmvPicturePtr Picture pointer on success
  * (NULL pointer otherwise).
- *
- * Use relative XPath format, root must be defined before call.
  */
 HdmvPicturePtr parseImgIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   lbc ** imgFilename
 );
 
@@ -252,23 +252,26 @@ HdmvPicturePtr parseImgIgsXmlFile(
  * \brief Parse and return a reference picture from IGS XML description file.
  *
  * \param ctx Used context.
+ * \param node Reference picture 'ref_pic' node.
  *
  * Fetch a previously parsed reference picture
  * (by #parseReferencePicturesIndexerIgsXmlFile()).
- * Use relative XPath format, root must be defined before call.
  */
 HdmvPicturePtr parseRefImgIgsXmlFile(
-  IgsCompilerContextPtr ctx
+  IgsCompilerContextPtr ctx,
+  xmlNodePtr node
 );
 
 /** \~english
  * \brief Parse reference pictures from IGS XML description file.
  *
  * \param ctx Used context.
+ * \param node Composition node.
  * \return int A zero value on success, otherwise a negative value.
  */
 int parseReferencePicturesIndexerIgsXmlFile(
-  IgsCompilerContextPtr ctx
+  IgsCompilerContextPtr ctx,
+  xmlNodePtr node
 );
 
 /** \~english
@@ -276,13 +279,15 @@ int parseReferencePicturesIndexerIgsXmlFile(
  * from IGS XML description file.
  *
  * \param ctx Used context.
+ * \param node BOG node.
  * \param bog Return parameters pointer.
- * \param index Bog index to parse.
+ * \param index Bog index in page, used in messages.
  * \param nextButtonId Next available button_id value.
  * \return int A zero value on success, otherwise a negative value.
  */
 int parsePageBogIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   HdmvButtonOverlapGroupParameters * bog,
   int index,
   uint16_t * nextButtonId
@@ -292,13 +297,15 @@ int parsePageBogIgsXmlFile(
  * \brief Parse a page() structure from IGS XML description file.
  *
  * \param ctx Used context.
+ * \param node Page node.
  * \param page Return parameters pointer.
- * \param index Page index to parse.
+ * \param index Page index in composition, used in messages.
  * \param nextPageId Next available page_id value.
  * \return int A zero value on success, otherwise a negative value.
  */
 int parsePageIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   HdmvPageParameters * page,
   int index,
   uint8_t * nextPageId
@@ -308,11 +315,13 @@ int parsePageIgsXmlFile(
  * \brief Parse composition pages from IGS XML description file.
  *
  * \param ctx Used context.
+ * \param node Composition node.
  * \param compo Return composition pointer.
  * \return int A zero value on success, otherwise a negative value.
  */
 int parsePagesIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   HdmvICParameters * compo
 );
 
@@ -320,11 +329,13 @@ int parsePagesIgsXmlFile(
  * \brief Parse a interactive composition from IGS XML description file.
  *
  * \param ctx Used context.
+ * \param node Composition node, defined as root.
  * \param compo Return composition pointer.
  * \return int A zero value on success, otherwise a negative value.
  */
 int parseCompositionIgsXmlFile(
   IgsCompilerContextPtr ctx,
+  xmlNodePtr node,
   IgsCompilerCompositionPtr compo
 );
 
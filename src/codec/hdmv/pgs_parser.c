@@ -461,6 +461,7 @@ int processCompletePgsDisplaySet(HdmvSegmentsContextPtr ctx)
 
 int parsePgsSupHeader(BitstreamReaderPtr pgsInput, HdmvSegmentsContextPtr ctx)
 {
+  uint8_t header[PGS_SUP_HEADER_LENGTH];
   uint32_t value;
 
   assert(NULL != pgsInput);
@@ -468,10 +469,13 @@ int parsePgsSupHeader(BitstreamReaderPtr pgsInput, HdmvSegmentsContextPtr ctx)
 
   LIBBLU_DEBUG_COM("0x%08" PRIX64 ": SUP Header.\n", tellPos(pgsInput));
 
-  /* [u16 format_identifier] */
-  if (readValueBigEndian(pgsInput, 2, &value) < 0)
+  /* Fixed-length header, fetched at once. */
+  if (readBytes(pgsInput, header, PGS_SUP_HEADER_LENGTH) < 0)
     return -1;
 
+  /* [u16 format_identifier] */
+  value = (header[0] << 8) | header[1];
+
   if (value != IGS_SUP_WORD)
     LIBBLU_HDMV_PGS_ERROR_RETURN(
       "Unknown SUP magic word, expect 0x%04X.\n",
@@ -485,8 +489,12 @@ int parsePgsSupHeader(BitstreamReaderPtr pgsInput, HdmvSegmentsContextPtr ctx)
   );
 
   /* [d32 pts] */
-  if (readValueBigEndian(pgsInput, 4, &value) < 0)
-    return -1;
+  value =
+    ((uint32_t) header[2] << 24)
+    | ((uint32_t) header[3] << 16)
+    | ((uint32_t) header[4] << 8)
+    | (uint32_t) header[5]
+  ;
   ctx->curSegProperties.pts = (int32_t) value;
 
   LIBBLU_DEBUG_COM(
@@ -496,8 +504,12 @@ int parsePgsSupHeader(BitstreamReaderPtr pgsInput, HdmvSegmentsContextPtr ctx)
   );
 
   /* [d32 dts] */
-  if (readValueBigEndian(pgsInput, 4, &value) < 0)
-    return -1;
+  value =
+    ((uint32_t) header[6] << 24)
+    | ((uint32_t) header[7] << 16)
+    | ((uint32_t) header[8] << 8)
+    | (uint32_t) header[9]
+  ;
   ctx->curSegProperties.dts = (int32_t) value;
 
   LIBBLU_DEBUG_COM(
@@ -81,6 +81,20 @@ free_return:
   );
 }
 
+static bool isScriptGenerationRequiredLibbluES(
+  const LibbluESSettings * settings,
+  bool forceRebuild
+)
+{
+  uint64_t scriptFlags;
+
+  if (forceRebuild)
+    return true;
+
+  scriptFlags = computeFlagsLibbluESSettingsOptions(settings->options);
+  return isAValidESMSFile(settings->scriptFilepath, scriptFlags, NULL) < 0;
+}
+
 static int checkScriptFileLibbluES(
   LibbluESPtr es,
   LibbluESFormatUtilities * esAssociatedUtilities,
@@ -90,15 +104,13 @@ static int checkScriptFileLibbluES(
   int ret;
 
   LibbluESFormatUtilities utilities;
-  uint64_t scriptFlags;
 
   LibbluESSettings * settings = es->settings;
   cleanLibbluESFormatUtilities(&utilities);
 
   /* Checking ESMS script file : */
-  scriptFlags = computeFlagsLibbluESSettingsOptions(settings->options);
   LIBBLU_SCRIPT_DEBUG("Check predefined script filepath.\n");
-  if (forceRebuild || isAValidESMSFile(settings->scriptFilepath, scriptFlags, NULL) < 0) {
+  if (isScriptGenerationRequiredLibbluES(settings, forceRebuild)) {
     /* Not valid/missing/forced rebuilding */
     LibbluStreamCodingType expectedCodingType;
 
@@ -151,12 +163,211 @@ static int checkScriptFileLibbluES(
   return 0;
 }
 
+/* ### Graphic streams scripts generation : ############################### */
+
+typedef struct {
+  LibbluESSettings * settings;  /**< Streams settings.                       */
+  unsigned * indexes;           /**< Generated streams settings indexes.     */
+  LibbluMessagesBuffer * messages;  /**< Per-script generation messages.     */
+  unsigned nbScripts;           /**< Number of generated scripts.            */
+  unsigned nbCompleted;         /**< Number of successfully generated ones.  */
+
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_t mutex;        /**< Progression reporting lock.             */
+#endif
+} LibbluESScriptsGeneration;
+
+static void printProgressionLibbluESScriptsGeneration(
+  const LibbluESScriptsGeneration * gen
+)
+{
+  unsigned percentage = 100 * gen->nbCompleted / gen->nbScripts;
+
+  lbc_printf(
+    "Analyzing graphic streams... [%.*s%.*s] %u/%u\r",
+    percentage / 5, "====================",
+    20 - (percentage / 5), "                    ",
+    gen->nbCompleted, gen->nbScripts
+  );
+  fflush(stdout);
+}
+
+static int generateScriptLibbluESScriptsGeneration(
+  void * genPtr,
+  unsigned taskIdx
+)
+{
+  LibbluESScriptsGeneration * gen = (LibbluESScriptsGeneration *) genPtr;
+  LibbluESSettings * settings = gen->settings + gen->indexes[taskIdx];
+  LibbluESFormatUtilities utilities;
+  int ret;
+
+  /* Messages are kept to be printed in scripts order once all are
+  completed. */
+  setMessagesBufferLibblu(&gen->messages[taskIdx]);
+
+  cleanLibbluESFormatUtilities(&utilities);
+  ret = initLibbluESFormatUtilities(&utilities, settings->codingType);
+  if (0 <= ret) {
+    ret = generateScriptES(
+      utilities,
+      settings->filepath,
+      settings->scriptFilepath,
+      settings->options
+    );
+    if (ret < 0)
+      LIBBLU_ERROR(
+        "Invalid input file '%" PRI_LBCS "', "
+        "unable to generate script.\n",
+        settings->filepath
+      );
+  }
+
+  setMessagesBufferLibblu(NULL);
+  if (ret < 0)
+    return -1;
+
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_lock(&gen->mutex);
+#endif
+  gen->nbCompleted++;
+  if (!isDebugEnabled())
+    printProgressionLibbluESScriptsGeneration(gen);
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_unlock(&gen->mutex);
+#endif
+
+  return 0;
+}
+
+static bool isConcurrentlyGeneratedScriptLibbluES(
+  const LibbluESSettings * settings
+)
+{
+  if (NULL == settings->filepath || NULL == settings->scriptFilepath)
+    return false;
+
+  switch (settings->codingType) {
+    case STREAM_CODING_TYPE_PG:
+      return true;
+
+    case STREAM_CODING_TYPE_IG:
+      /* IGS Compiler relies on process-wide XML library state. */
+      return !isIgsCompilerFile(settings->filepath);
+
+    default:
+      return false;
+  }
+}
+
+int generateGraphicScriptsLibbluES(
+  LibbluESSettings * settings,
+  unsigned nbSettings,
+  bool forceRebuild,
+  bool * generated
+)
+{
+  LibbluESScriptsGeneration gen;
+  unsigned i, j;
+  int ret;
+
+  assert(NULL != settings);
+  assert(NULL != generated);
+
+  for (i = 0; i < nbSettings; i++)
+    generated[i] = false;
+
+  gen.indexes = (unsigned *) malloc(nbSettings * sizeof(unsigned));
+  if (NULL == gen.indexes)
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  gen.settings = settings;
+  gen.nbScripts = 0;
+  gen.nbCompleted = 0;
+
+  for (i = 0; i < nbSettings; i++) {
+    if (!isConcurrentlyGeneratedScriptLibbluES(settings + i))
+      continue;
+
+    /* Shared scripts are generated once, by their first user. */
+    for (j = 0; j < i; j++) {
+      if (lbc_equal(settings[i].scriptFilepath, settings[j].scriptFilepath))
+        break;
+    }
+    if (j < i)
+      continue;
+
+    if (isScriptGenerationRequiredLibbluES(settings + i, forceRebuild))
+      gen.indexes[gen.nbScripts++] = i;
+  }
+
+  if (gen.nbScripts < 2) {
+    /* Nothing to share, scripts are generated when streams are prepared. */
+    free(gen.indexes);
+    return 0;
+  }
+
+  gen.messages = (LibbluMessagesBuffer *) malloc(
+    gen.nbScripts * sizeof(LibbluMessagesBuffer)
+  );
+  if (NULL == gen.messages) {
+    free(gen.indexes);
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  }
+  for (i = 0; i < gen.nbScripts; i++)
+    initLibbluMessagesBuffer(&gen.messages[i]);
+
+#if !defined(DISABLE_THREADS)
+  if (0 != pthread_mutex_init(&gen.mutex, NULL)) {
+    free(gen.messages);
+    free(gen.indexes);
+    LIBBLU_ERROR_RETURN("Unable to create scripts generation mutex.\n");
+  }
+#endif
+
+  LIBBLU_SCRIPT_DEBUG("Generate %u graphic streams scripts.\n", gen.nbScripts);
+
+  /* Each analyzer owns its context, only progression is shared. */
+  setHiddenFileParsingProgressionBar(true);
+  if (!isDebugEnabled())
+    printProgressionLibbluESScriptsGeneration(&gen);
+
+  ret = processTasksPool(
+    generateScriptLibbluESScriptsGeneration,
+    &gen,
+    gen.nbScripts,
+    getNbThreadsFromIniHdmv(settings->options.confHandle)
+  );
+
+  setHiddenFileParsingProgressionBar(false);
+  if (!isDebugEnabled())
+    lbc_printf("\n");
+
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_destroy(&gen.mutex);
+#endif
+
+  /* Diagnostics of each script, in streams order. */
+  for (i = 0; i < gen.nbScripts; i++) {
+    printLibbluMessagesBuffer(&gen.messages[i]);
+    cleanLibbluMessagesBuffer(gen.messages[i]);
+  }
+  free(gen.messages);
+
+  if (0 <= ret) {
+    for (i = 0; i < gen.nbScripts; i++)
+      generated[gen.indexes[i]] = true;
+  }
+
+  free(gen.indexes);
+  return ret;
+}
+
 static int parseScriptLibbluES(
   LibbluESPtr es
 )
 {
   BitstreamReaderPtr script;
-  int ret;
+  EsmsFileDirectories dirs;
 
   LibbluESSettings * settings = es->settings;
   uint64_t refPts, endPts;
@@ -166,10 +377,14 @@ static int parseScriptLibbluES(
   if (NULL == (script = createBitstreamReaderDefBuf(settings->scriptFilepath)))
     return -1;
 
+  /* Read directories once, every section is reached from this table. */
+  if (parseDirectoriesEsms(script, &dirs) < 0)
+    goto free_return;
+
   LIBBLU_SCRIPT_DEBUG("Parsing script properties.\n");
 
   /* Reading ES Properties section. */
-  if (seekESPropertiesEsms(settings->scriptFilepath, script) < 0)
+  if (seekESPropertiesEsms(script, &dirs) < 0)
     goto free_return;
   if (parseESPropertiesHeaderEsms(script, &es->prop, &refPts, &endPts) < 0)
     goto free_return;
@@ -180,24 +395,22 @@ static int parseScriptLibbluES(
 
   if (isConcernedESFmtPropertiesEsms(es->prop)) {
     /* Reading ES Format Properties section according to stream type. */
-    if (seekESFmtPropertiesEsms(settings->scriptFilepath, script) < 0)
+    if (seekESFmtPropertiesEsms(script, &dirs) < 0)
       goto free_return;
     if (parseESFmtPropertiesEsms(script, &es->prop, &es->fmtSpecProp) < 0)
       goto free_return;
   }
 
-  if ((ret = isPresentESDataBlocksDefinitionEsms(settings->scriptFilepath)) < 0)
-    goto free_return;
-  if (0 < ret) {
+  if (isPresentESDataBlocksDefinitionEsms(&dirs)) {
      /* Reading ES Data Blocks Definition section if present. */
-    if (seekESDataBlocksDefinitionEsms(settings->scriptFilepath, script) < 0)
+    if (seekESDataBlocksDefinitionEsms(script, &dirs) < 0)
       goto free_return;
     if (parseESDataBlocksDefinitionEsms(script, &es->scriptDataSections) < 0)
       goto free_return;
   }
 
   /* Seek to the ES PES Cutting section. */
-  if (seekESPesCuttingEsms(settings->scriptFilepath, script) < 0)
+  if (seekESPesCuttingEsms(script, &dirs) < 0)
     goto free_return;
   if (checkDirectoryMagic(script, PES_CUTTING_HEADER, 4) < 0)
     goto free_return;
@@ -463,6 +676,7 @@ int buildAndQueueNextPesPacketPropertiesLibbluES(
     es->pesPacketsScriptsQueueSize < LIBBLU_ES_MIN_BUF_PES_SCRIPT_PACKETS
     && !es->endOfScriptReached
   ) {
+    EsmsPesPacketNodePtr firstNewNode = NULL;
     unsigned i;
 
     for (
@@ -471,25 +685,36 @@ int buildAndQueueNextPesPacketPropertiesLibbluES(
       && !isEndReachedESPesCuttingEsms(es->scriptFile);
       i++
     ) {
+      LIBBLU_PROFILE_START(profTimer);
 
       esmsNode = parseFrameNodeESPesCuttingEsms(
         es->scriptFile,
         es->prop.codingType,
-        &es->scriptCommandParsing
+        &es->scriptCommandParsing,
+        &es->nodesPool.scriptNodes
       );
       if (NULL == esmsNode)
         return -1;
 
+      LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_ESMS_PARSING);
+
       if (NULL == es->pesPacketsScriptsQueue)
         es->pesPacketsScriptsQueue = esmsNode;
       else
         attachEsmsPesPacketNode(es->pesPacketsScriptsQueueLastNode, esmsNode);
       es->pesPacketsScriptsQueueLastNode = esmsNode;
       es->pesPacketsScriptsQueueSize++;
+
+      if (NULL == firstNewNode)
+        firstNewNode = esmsNode;
     }
 
     if (isEndReachedESPesCuttingEsms(es->scriptFile))
       es->endOfScriptReached = true;
+
+    /* Prefetch source files regions used by the newly queued packets */
+    if (!es->skipPayloadReads)
+      adviseReadAheadEsmsESSourceFiles(es->sourceFiles, firstNewNode);
   }
 
   if (NULL == (esmsNode = extractPesPacketScriptsQueueLibbluES(es)))
@@ -498,17 +723,17 @@ int buildAndQueueNextPesPacketPropertiesLibbluES(
     );
 
   node = prepareLibbluESPesPacketPropertiesNode(
+    &es->nodesPool,
     esmsNode,
     refPcr,
     es->refPts,
     preparePesHeader,
     es->prop.codingType
   );
+  releasePesPacketNodeEsmsNodesPool(&es->nodesPool.scriptNodes, esmsNode, false);
   if (NULL == node)
     return -1;
 
-  destroyEsmsPesPacketNode(esmsNode, false);
-
   if (NULL == es->pesPacketsQueue)
     es->pesPacketsQueue = node;
   else
@@ -597,7 +822,11 @@ int buildPesPacketDataLibbluES(
         );
         break;
 
-      case ESMS_ADD_PAYLOAD_DATA:
+      case ESMS_ADD_PAYLOAD_DATA: {
+        if (es->skipPayloadReads)
+          break; /* Simulation mode, payload content is not required. */
+
+        LIBBLU_PROFILE_START(profTimer);
         ret = applyEsmsAddPesPayloadCommand(
           command.data.addPesPayload,
           payload,
@@ -605,7 +834,9 @@ int buildPesPacketDataLibbluES(
           handlesEsmsESSourceFiles(es->sourceFiles),
           nbUsedFilesEsmsESSourceFiles(es->sourceFiles)
         );
+        LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_PAYLOAD_READS);
         break;
+      }
 
       case ESMS_ADD_PADDING_DATA:
         ret = applyEsmsAddPaddingCommand(
@@ -656,12 +887,12 @@ int buildNextPesPacketLibbluES(
 {
   LibbluESPesPacketPropertiesNodePtr node;
 
-  if (es->pesPacketsQueueSize < LIBBLU_ES_MIN_BUF_PES_PACKETS) {
+  if (es->pesPacketsQueueSize < es->pesPacketsQueueMinSize) {
     unsigned i;
 
     for (
       i = 0;
-      i < LIBBLU_ES_INC_BUF_PES_PACKETS
+      i < es->pesPacketsQueueIncSize
       && !endOfPesPacketsScriptsQueueLibbluES(*es);
       i++
     ) {
@@ -673,24 +904,40 @@ int buildNextPesPacketLibbluES(
   if (NULL == (node = extractPesPacketQueueLibbluES(es)))
     return 0; /* Empty queue */
 
+  /* Previous PES packet node is no longer required. */
+  releasePropertiesNodeLibbluESPesPacketNodesPool(
+    &es->nodesPool, es->curPesPacket.node, false
+  );
+  es->curPesPacket.node = node;
+
+  LIBBLU_PROFILE_START(profTimer);
   if (buildPesPacketDataLibbluES(es, &es->curPesPacket.data, node) < 0)
-    goto free_return;
+    return -1;
   es->curPesPacket.prop = node->prop;
+  LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_PES_ASSEMBLY);
 
   /* Add to stream buffering model chain if used */
   if (NULL != es->lnkdBufList) {
-    return addPesPacketToBdavStdLibbluES(
-      es,
-      node->prop,
-      pid,
-      refPcr
-    );
+    if (addPesPacketToBdavStdLibbluES(es, node->prop, pid, refPcr) < 0)
+      return -1;
   }
 
-  destroyLibbluESPesPacketPropertiesNode(node, false);
   return 1;
+}
 
-free_return:
-  destroyLibbluESPesPacketPropertiesNode(node, false);
-  return -1;
+int reloadCurrentPesPacketDataLibbluES(
+  LibbluESPtr es
+)
+{
+  size_t dataOffset;
+
+  if (NULL == es->curPesPacket.node)
+    return 0; /* No current PES packet */
+
+  dataOffset = es->curPesPacket.data.dataOffset;
+  if (buildPesPacketDataLibbluES(es, &es->curPesPacket.data, es->curPesPacket.node) < 0)
+    return -1;
+  es->curPesPacket.data.dataOffset = dataOffset;
+
+  return 0;
 }
\ No newline at end of file
@@ -88,6 +88,48 @@ static inline void cleanLibbluESSettings(
   free(settings.options.pbrFilepath);
 }
 
+/** \~english
+ * \brief Copy supplied #LibbluESSettings structure.
+ *
+ * \param dst Destination settings.
+ * \param src Source settings.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Owned filepaths are duplicated, destination must be released using
+ * #cleanLibbluESSettings().
+ */
+static inline int copyLibbluESSettings(
+  LibbluESSettings * dst,
+  const LibbluESSettings * src
+)
+{
+  *dst = *src;
+  dst->filepath = NULL;
+  dst->scriptFilepath = NULL;
+  dst->options.pbrFilepath = NULL;
+
+  if (NULL != src->filepath) {
+    if (NULL == (dst->filepath = lbc_strdup(src->filepath)))
+      goto free_return;
+  }
+  if (NULL != src->scriptFilepath) {
+    if (NULL == (dst->scriptFilepath = lbc_strdup(src->scriptFilepath)))
+      goto free_return;
+  }
+  if (NULL != src->options.pbrFilepath) {
+    dst->options.pbrFilepath = lbc_strdup(src->options.pbrFilepath);
+    if (NULL == dst->options.pbrFilepath)
+      goto free_return;
+  }
+
+  return 0;
+
+free_return:
+  cleanLibbluESSettings(*dst);
+  LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+}
+
 static inline int setFpsChangeLibbluESSettings(
   LibbluESSettings * dst,
   const lbc * expr
@@ -233,10 +275,21 @@ typedef struct {
   LibbluESPesPacketPropertiesNodePtr pesPacketsQueue;
   LibbluESPesPacketPropertiesNodePtr pesPacketsQueueLastNode;
   unsigned pesPacketsQueueSize;
+  unsigned pesPacketsQueueMinSize;  /**< PES packets lookahead, minimal
+    number of prepared PES packets properties.                               */
+  unsigned pesPacketsQueueIncSize;  /**< Number of PES packets properties
+    prepared when queue size falls below #pesPacketsQueueMinSize.            */
+
+  LibbluESPesPacketNodesPool nodesPool;  /**< Recycled PES packets nodes.   */
+  bool skipPayloadReads;  /**< Payload is not read from source files, PES
+    packets content is undefined, only their sizes and timings are valid
+    (simulation mode).                                                       */
 
   struct {
     LibbluESPesPacketProperties prop;
     LibbluESPesPacketData data;
+    LibbluESPesPacketPropertiesNodePtr node;  /**< Current PES packet
+      properties node, kept to allow data rebuilding.                        */
   } curPesPacket;
 
   /* Progression related */
@@ -277,6 +330,9 @@ static inline void initLibbluES(
     .pesPacketsQueue = NULL,
     .pesPacketsQueueLastNode = NULL,
     .pesPacketsQueueSize = 0,
+    .pesPacketsQueueMinSize = LIBBLU_ES_MIN_BUF_PES_PACKETS,
+    .pesPacketsQueueIncSize = LIBBLU_ES_INC_BUF_PES_PACKETS,
+    .skipPayloadReads = false,
 
     .parsedProperties = false,
     .initializedPesCutting = false,
@@ -289,6 +345,8 @@ static inline void initLibbluES(
   initEsmsDataBlocks(&dst->scriptDataSections);
   initEsmsESSourceFiles(&dst->sourceFiles);
   initLibbluESPesPacketData(&dst->curPesPacket.data);
+  dst->curPesPacket.node = NULL;
+  initLibbluESPesPacketNodesPool(&dst->nodesPool);
 }
 
 static inline void cleanLibbluES(
@@ -304,6 +362,26 @@ static inline void cleanLibbluES(
   destroyEsmsPesPacketNode(es.pesPacketsScriptsQueue, true);
   destroyLibbluESPesPacketPropertiesNode(es.pesPacketsQueue, true);
   cleanLibbluESPesPacketData(es.curPesPacket.data);
+  destroyLibbluESPesPacketPropertiesNode(es.curPesPacket.node, false);
+  cleanLibbluESPesPacketNodesPool(es.nodesPool);
+}
+
+/** \~english
+ * \brief Set the number of PES packets prepared in advance.
+ *
+ * \param es Elementary Stream handle.
+ * \param depth Minimal number of queued PES packets properties.
+ *
+ * When queue size falls below supplied depth, it is refilled by batches of
+ * max(depth, #LIBBLU_ES_INC_BUF_PES_PACKETS) PES packets.
+ */
+static inline void setPesPacketsLookaheadLibbluES(
+  LibbluESPtr es,
+  unsigned depth
+)
+{
+  es->pesPacketsQueueMinSize = depth;
+  es->pesPacketsQueueIncSize = MAX(depth, LIBBLU_ES_INC_BUF_PES_PACKETS);
 }
 
 int prepareLibbluES(
@@ -312,6 +390,30 @@ int prepareLibbluES(
   bool forceRebuild
 );
 
+/** \~english
+ * \brief Generate concurrently missing scripts of HDMV graphic streams.
+ *
+ * \param settings Elementary Streams settings, with defined script
+ * filepaths.
+ * \param nbSettings Number of settings.
+ * \param forceRebuild Scripts rebuilding is forced.
+ * \param generated Array of nbSettings booleans, set to true for each
+ * setting which script has been generated.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * PGS and IGS (out of IGS Compiler inputs) streams analyses are scheduled on
+ * a tasks pool, which size is defined by the 'threads' key of the INI
+ * '[HDMV]' section. Generation is left to prepareLibbluES() if less than two
+ * scripts are missing.
+ */
+int generateGraphicScriptsLibbluES(
+  LibbluESSettings * settings,
+  unsigned nbSettings,
+  bool forceRebuild,
+  bool * generated
+);
+
 /** \~english
  * \brief Return the number of bytes remaining in the current PES packet.
  *
@@ -369,4 +471,18 @@ int buildNextPesPacketLibbluES(
   LibbluESPesPacketHeaderPrepFun preparePesHeader
 );
 
+/** \~english
+ * \brief Rebuild current PES packet data.
+ *
+ * \param es Elementary Stream handle.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Current PES packet writing offset is preserved. Used to restore PES packet
+ * payload previously built with #skipPayloadReads set.
+ */
+int reloadCurrentPesPacketDataLibbluES(
+  LibbluESPtr es
+);
+
 #endif
\ No newline at end of file
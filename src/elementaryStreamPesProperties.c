@@ -310,7 +310,52 @@ LibbluESPesPacketPropertiesNodePtr createLibbluESPesPacketPropertiesNode(
   return node;
 }
 
+/* ### ES Pes Packet Nodes Pool : ########################################## */
+
+LibbluESPesPacketPropertiesNodePtr getPropertiesNodeLibbluESPesPacketNodesPool(
+  LibbluESPesPacketNodesPool * pool
+)
+{
+  LibbluESPesPacketPropertiesNodePtr node;
+
+  assert(NULL != pool);
+
+  if (NULL == (node = pool->propertiesNodes))
+    return createLibbluESPesPacketPropertiesNode();
+  pool->propertiesNodes = node->next;
+
+  node->next = NULL;
+  node->commands = NULL;
+  node->size = 0;
+
+  return node;
+}
+
+void releasePropertiesNodeLibbluESPesPacketNodesPool(
+  LibbluESPesPacketNodesPool * pool,
+  LibbluESPesPacketPropertiesNodePtr node,
+  bool recursive
+)
+{
+  assert(NULL != pool);
+
+  while (NULL != node) {
+    LibbluESPesPacketPropertiesNodePtr next = node->next;
+
+    releaseCommandNodeEsmsNodesPool(&pool->scriptNodes, node->commands, true);
+    node->commands = NULL;
+
+    node->next = pool->propertiesNodes;
+    pool->propertiesNodes = node;
+
+    if (!recursive)
+      break;
+    node = next;
+  }
+}
+
 LibbluESPesPacketPropertiesNodePtr prepareLibbluESPesPacketPropertiesNode(
+  LibbluESPesPacketNodesPool * pool,
   EsmsPesPacketNodePtr scriptNode,
   uint64_t refPcr,
   uint64_t refPts,
@@ -321,7 +366,7 @@ LibbluESPesPacketPropertiesNodePtr prepareLibbluESPesPacketPropertiesNode(
   LibbluESPesPacketPropertiesNodePtr node;
   EsmsCommandNodePtr commands;
 
-  if (NULL == (node = createLibbluESPesPacketPropertiesNode()))
+  if (NULL == (node = getPropertiesNodeLibbluESPesPacketNodesPool(pool)))
     return NULL;
 
   if (prepareLibbluESPesPacketProperties(&node->prop, scriptNode, refPcr, refPts, preparePesHeader, codingType) < 0)
@@ -336,7 +381,7 @@ LibbluESPesPacketPropertiesNodePtr prepareLibbluESPesPacketPropertiesNode(
   return node;
 
 free_return:
-  destroyLibbluESPesPacketPropertiesNode(node, false);
+  releasePropertiesNodeLibbluESPesPacketNodesPool(pool, node, false);
   return NULL;
 }
 
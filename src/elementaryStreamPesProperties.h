@@ -88,7 +88,66 @@ static inline void destroyLibbluESPesPacketPropertiesNode(
   free(node);
 }
 
+/* ### ES Pes Packet Nodes Pool : ########################################## */
+
+/** \~english
+ * \brief Elementary Stream PES packets nodes recycling pool.
+ *
+ * Holds released PES packet properties nodes and ESMS script nodes,
+ * reused by following PES packets of the same ES.
+ */
+typedef struct {
+  LibbluESPesPacketPropertiesNodePtr propertiesNodes;  /**< Free PES packet
+    properties nodes list.                                                   */
+  EsmsNodesPool scriptNodes;  /**< ESMS script nodes and commands pool.     */
+} LibbluESPesPacketNodesPool;
+
+static inline void initLibbluESPesPacketNodesPool(
+  LibbluESPesPacketNodesPool * dst
+)
+{
+  dst->propertiesNodes = NULL;
+  initEsmsNodesPool(&dst->scriptNodes);
+}
+
+static inline void cleanLibbluESPesPacketNodesPool(
+  LibbluESPesPacketNodesPool pool
+)
+{
+  destroyLibbluESPesPacketPropertiesNode(pool.propertiesNodes, true);
+  cleanEsmsNodesPool(pool.scriptNodes);
+}
+
+/** \~english
+ * \brief Return a PES packet properties node from supplied pool.
+ *
+ * \param pool Used pool.
+ * \return LibbluESPesPacketPropertiesNodePtr Upon success, a initialized
+ * node is returned (a new one is created if the pool is empty). Otherwise, a
+ * NULL pointer is returned.
+ */
+LibbluESPesPacketPropertiesNodePtr getPropertiesNodeLibbluESPesPacketNodesPool(
+  LibbluESPesPacketNodesPool * pool
+);
+
+/** \~english
+ * \brief Give back a PES packet properties node (and optionally its
+ * siblings) to supplied pool.
+ *
+ * \param pool Destination pool.
+ * \param node Released node.
+ * \param recursive If true, all the following nodes are released too.
+ *
+ * Attached ESMS commands are released in pool script nodes pool.
+ */
+void releasePropertiesNodeLibbluESPesPacketNodesPool(
+  LibbluESPesPacketNodesPool * pool,
+  LibbluESPesPacketPropertiesNodePtr node,
+  bool recursive
+);
+
 LibbluESPesPacketPropertiesNodePtr prepareLibbluESPesPacketPropertiesNode(
+  LibbluESPesPacketNodesPool * pool,
   EsmsPesPacketNodePtr scriptNode,
   uint64_t referentialStc,
   uint64_t referentialTs,
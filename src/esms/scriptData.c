@@ -111,7 +111,11 @@ int openAllEsmsESSourceFiles(
   for (i = 0; i < dst->nbUsedFiles; i++)
     dst->handles[i] = NULL;
   for (i = 0; i < dst->nbUsedFiles; i++) {
-    if (NULL == (dst->handles[i] = createBitstreamReaderDefBuf(dst->filepaths[i])))
+    dst->handles[i] = createBitstreamReader(
+      dst->filepaths[i],
+      ESMS_ES_SOURCE_FILE_BUFFER_LEN
+    );
+    if (NULL == dst->handles[i])
       return -1;
   }
 
@@ -442,10 +446,48 @@ EsmsCommandNodePtr createEsmsCommandNode(
 
   node->next = NULL;
   initEsmsCommand(&node->command, type);
+  node->recycledData = NULL;
+  node->recycledDataSize = 0;
 
   return node;
 }
 
+int setAddDataCommandEsmsCommandNode(
+  EsmsCommandNodePtr dst,
+  uint32_t offset,
+  EsmsDataInsertionMode mode,
+  const uint8_t * data,
+  uint16_t dataLength
+)
+{
+  assert(NULL != dst);
+  assert(NULL != data);
+  assert(0 < dataLength);
+
+  if (dst->recycledDataSize < dataLength)
+    return setEsmsAddDataCommand(
+      &dst->command.data.addData,
+      offset,
+      mode,
+      data,
+      dataLength
+    );
+
+  /* Reuse previous data array */
+  memcpy(dst->recycledData, data, dataLength);
+  dst->command.data.addData = (EsmsAddDataCommand) {
+    .offset = offset,
+    .mode = mode,
+    .data = dst->recycledData,
+    .dataLength = dataLength
+  };
+
+  dst->recycledData = NULL;
+  dst->recycledDataSize = 0;
+
+  return 0;
+}
+
 /* ### ESMS script PES packet node : ####################################### */
 
 EsmsPesPacketNodePtr createEsmsPesPacketNode(
@@ -469,6 +511,167 @@ EsmsPesPacketNodePtr createEsmsPesPacketNode(
   return node;
 }
 
+/* ### ESMS script nodes pool : ############################################ */
+
+EsmsCommandNodePtr getCommandNodeEsmsNodesPool(
+  EsmsNodesPool * pool,
+  EsmsCommandType type
+)
+{
+  EsmsCommandNodePtr node;
+
+  assert(NULL != pool);
+
+  if (NULL == (node = pool->commandNodes))
+    return createEsmsCommandNode(type);
+  pool->commandNodes = node->next;
+
+  node->next = NULL;
+  initEsmsCommand(&node->command, type);
+
+  return node;
+}
+
+void releaseCommandNodeEsmsNodesPool(
+  EsmsNodesPool * pool,
+  EsmsCommandNodePtr node,
+  bool recursive
+)
+{
+  assert(NULL != pool);
+
+  while (NULL != node) {
+    EsmsCommandNodePtr next = node->next;
+
+    if (
+      node->command.type == ESMS_ADD_DATA
+      && node->recycledDataSize <= node->command.data.addData.dataLength
+    ) {
+      /* Keep the data array for a next "Add data" command */
+      free(node->recycledData);
+      node->recycledData = node->command.data.addData.data;
+      node->recycledDataSize = node->command.data.addData.dataLength;
+    }
+    else
+      cleanEsmsCommand(node->command);
+    /* Reset to a type without attached allocation */
+    initEsmsCommand(&node->command, ESMS_ADD_PAYLOAD_DATA);
+
+    node->next = pool->commandNodes;
+    pool->commandNodes = node;
+
+    if (!recursive)
+      break;
+    node = next;
+  }
+}
+
+EsmsPesPacketNodePtr getPesPacketNodeEsmsNodesPool(
+  EsmsNodesPool * pool
+)
+{
+  EsmsPesPacketNodePtr node;
+
+  assert(NULL != pool);
+
+  if (NULL == (node = pool->pesPacketNodes))
+    return createEsmsPesPacketNode();
+  pool->pesPacketNodes = node->next;
+
+  node->next = NULL;
+  node->extensionFrame = false;
+  node->dtsPresent = false;
+  node->pts = 0;
+  node->dts = 0;
+  node->length = 0;
+  node->commands = NULL;
+
+  return node;
+}
+
+void releasePesPacketNodeEsmsNodesPool(
+  EsmsNodesPool * pool,
+  EsmsPesPacketNodePtr node,
+  bool recursive
+)
+{
+  assert(NULL != pool);
+
+  while (NULL != node) {
+    EsmsPesPacketNodePtr next = node->next;
+
+    releaseCommandNodeEsmsNodesPool(pool, node->commands, true);
+    node->commands = NULL;
+
+    node->next = pool->pesPacketNodes;
+    pool->pesPacketNodes = node;
+
+    if (!recursive)
+      break;
+    node = next;
+  }
+}
+
+static void adviseReadAheadSourceFile(
+  BitstreamReaderPtr handle,
+  unsigned fileIdx,
+  const EsmsPesPacketNodePtr nodes
+)
+{
+  EsmsPesPacketNodePtr node;
+  int64_t start, end;
+
+  start = end = -1;
+  for (node = nodes; NULL != node; node = node->next) {
+    EsmsCommandNodePtr commandNode;
+
+    for (
+      commandNode = node->commands;
+      NULL != commandNode;
+      commandNode = commandNode->next
+    ) {
+      EsmsAddPesPayloadCommand command;
+
+      if (commandNode->command.type != ESMS_ADD_PAYLOAD_DATA)
+        continue;
+      command = commandNode->command.data.addPesPayload;
+      if (command.fileIdx != fileIdx || !command.size)
+        continue;
+
+      if (
+        0 <= start
+        && start - ESMS_READ_AHEAD_MAX_GAP <= command.srcOffset
+        && command.srcOffset <= end + ESMS_READ_AHEAD_MAX_GAP
+      ) {
+        /* Merging with current region */
+        start = MIN(start, command.srcOffset);
+        end = MAX(end, command.srcOffset + command.size);
+        continue;
+      }
+
+      adviseBitstreamReader(handle, start, end - start);
+      start = command.srcOffset;
+      end = command.srcOffset + command.size;
+    }
+  }
+
+  adviseBitstreamReader(handle, start, end - start);
+}
+
+void adviseReadAheadEsmsESSourceFiles(
+  EsmsESSourceFiles srcFiles,
+  const EsmsPesPacketNodePtr nodes
+)
+{
+  unsigned i;
+
+  if (NULL == srcFiles.handles)
+    return; /* Source files not opened */
+
+  for (i = 0; i < srcFiles.nbUsedFiles; i++)
+    adviseReadAheadSourceFile(srcFiles.handles[i], i, nodes);
+}
+
 /* ### ESMS files utilities : ############################################## */
 
 const char * ESMSDirectoryIdStr(
@@ -602,6 +805,88 @@ int seekDirectoryOffset(
   return 0;
 }
 
+int parseDirectoriesEsms(
+  BitstreamReaderPtr script,
+  EsmsFileDirectories * dst
+)
+{
+  uint8_t i, directoryNb;
+
+  initEsmsFileDirectories(dst);
+
+  /* [u32 esmsFileHeader] */
+  /* [u8 formatVersion] */
+  /* [u8 completedFile] */
+  if (seekPos(script, 0x6, SEEK_SET) < 0)
+    return -1;
+
+  /* [u8 directoryNb] */
+  if (readByte(script, &directoryNb) < 0)
+    return -1;
+
+  if (ESMS_MAX_ALLOWED_DIR < directoryNb)
+    LIBBLU_ERROR_RETURN(
+      "Broken script, too many directories (%u).\n",
+      directoryNb
+    );
+
+  for (i = 0; i < directoryNb; i++) {
+    EsmsFileDirectory * dir = &dst->dirs[i];
+
+    /* [u8 directoryId] */
+    if (readByte(script, &dir->id) < 0)
+      return -1;
+
+    /* [u64 directoryOffset] */
+    if (readBytes(script, (uint8_t *) &dir->offset, 8) < 0)
+      return -1;
+  }
+  dst->nbUsedDirs = directoryNb;
+
+  return 0;
+}
+
+ESMSDirectoryFetcherErrorCodes getDirectoryOffsetEsmsFileDirectories(
+  const EsmsFileDirectories * dirs,
+  ESMSDirectoryId id,
+  uint64_t * offset
+)
+{
+  uint8_t i;
+
+  for (i = 0; i < dirs->nbUsedDirs; i++) {
+    if (dirs->dirs[i].id == id) {
+      if (NULL != offset)
+        *offset = dirs->dirs[i].offset;
+      return ESMS_DF_OK;
+    }
+  }
+
+  return ESMS_DF_NOT_FOUND;
+}
+
+int seekDirectoryEsmsFileDirectories(
+  BitstreamReaderPtr essHandle,
+  const EsmsFileDirectories * dirs,
+  ESMSDirectoryId id
+)
+{
+  uint64_t offset;
+
+  if (getDirectoryOffsetEsmsFileDirectories(dirs, id, &offset) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Broken script, unable to find directory \"%s\".\n",
+      ESMSDirectoryIdStr(id)
+    );
+
+  if (seekPos(essHandle, offset, SEEK_SET) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Broken script, offset pointing outside of file.\n"
+    );
+
+  return 0;
+}
+
 int checkDirectoryMagic(
   BitstreamReaderPtr script,
   const char * magic,
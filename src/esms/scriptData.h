@@ -259,6 +259,21 @@ static inline void setEsmsESSourceFile(
 #define ESMS_DEFAULT_NB_ES_SOURCE_FILES 2
 #define ESMS_MAX_SUPPORTED_NB_ES_SOURCE_FILES 255
 
+/** \~english
+ * \brief ESMS source files reading buffer size in bytes.
+ *
+ * Large enough to hold payload of several consecutive PES packets, source
+ * files are so readed using large sequential reads and backward seekings
+ * between sub-streams sharing a source file are done in memory.
+ */
+#define ESMS_ES_SOURCE_FILE_BUFFER_LEN  IO_VBUF_SIZE
+
+/** \~english
+ * \brief Max allowed gap in bytes between two payload ranges of a source file
+ * to merge them in a single read-ahead region.
+ */
+#define ESMS_READ_AHEAD_MAX_GAP  65536
+
 typedef struct {
   lbc ** filepaths;
   EsmsESSourceFile * properties;
@@ -734,6 +749,10 @@ static inline void cleanEsmsCommand(
 typedef struct EsmsCommandNode {
   struct EsmsCommandNode * next;
   EsmsCommand command;
+
+  uint8_t * recycledData;   /**< Data array of a previous "Add data" command
+    kept for reuse by recycled nodes (see #EsmsNodesPool).                   */
+  size_t recycledDataSize;  /**< Allocated size of #recycledData in bytes.  */
 } EsmsCommandNode, *EsmsCommandNodePtr;
 
 EsmsCommandNodePtr createEsmsCommandNode(
@@ -752,9 +771,32 @@ static inline void destroyEsmsCommandNode(
     destroyEsmsCommandNode(node->next, true);
 
   cleanEsmsCommand(node->command);
+  free(node->recycledData);
   free(node);
 }
 
+/** \~english
+ * \brief Set "Add data" command of supplied node.
+ *
+ * \param dst Destination command node.
+ * \param offset Data insertion offset.
+ * \param mode Data insertion mode.
+ * \param data Inserted data.
+ * \param dataLength Inserted data length in bytes.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Same as #setEsmsAddDataCommand(), but node recycled data array is reused
+ * if large enough.
+ */
+int setAddDataCommandEsmsCommandNode(
+  EsmsCommandNodePtr dst,
+  uint32_t offset,
+  EsmsDataInsertionMode mode,
+  const uint8_t * data,
+  uint16_t dataLength
+);
+
 static inline void attachEsmsCommandNode(
   EsmsCommandNodePtr root,
   const EsmsCommandNodePtr sibling
@@ -847,6 +889,109 @@ static inline EsmsCommandNodePtr claimCommandsEsmsPesPacketNode(
   return commands;
 }
 
+/* ### ESMS script nodes pool : ############################################ */
+
+/** \~english
+ * \brief ESMS script nodes recycling pool.
+ *
+ * Released nodes are kept in free lists and reused by following requests,
+ * avoiding per PES packet allocations while muxing.
+ */
+typedef struct {
+  EsmsCommandNodePtr commandNodes;      /**< Free command nodes list.       */
+  EsmsPesPacketNodePtr pesPacketNodes;  /**< Free PES packet nodes list.    */
+} EsmsNodesPool;
+
+static inline void initEsmsNodesPool(
+  EsmsNodesPool * dst
+)
+{
+  *dst = (EsmsNodesPool) {
+    .commandNodes = NULL,
+    .pesPacketNodes = NULL
+  };
+}
+
+static inline void cleanEsmsNodesPool(
+  EsmsNodesPool pool
+)
+{
+  destroyEsmsCommandNode(pool.commandNodes, true);
+  destroyEsmsPesPacketNode(pool.pesPacketNodes, true);
+}
+
+/** \~english
+ * \brief Return a command node from supplied pool.
+ *
+ * \param pool Used pool.
+ * \param type Command type.
+ * \return EsmsCommandNodePtr Upon success, a initialized command node is
+ * returned (a new one is created if the pool is empty). Otherwise, a NULL
+ * pointer is returned.
+ */
+EsmsCommandNodePtr getCommandNodeEsmsNodesPool(
+  EsmsNodesPool * pool,
+  EsmsCommandType type
+);
+
+/** \~english
+ * \brief Give back a command node (and optionally its siblings) to supplied
+ * pool.
+ *
+ * \param pool Destination pool.
+ * \param node Released node.
+ * \param recursive If true, all the following nodes are released too.
+ */
+void releaseCommandNodeEsmsNodesPool(
+  EsmsNodesPool * pool,
+  EsmsCommandNodePtr node,
+  bool recursive
+);
+
+/** \~english
+ * \brief Return a PES packet node from supplied pool.
+ *
+ * \param pool Used pool.
+ * \return EsmsPesPacketNodePtr Upon success, a initialized PES packet node
+ * is returned (a new one is created if the pool is empty). Otherwise, a NULL
+ * pointer is returned.
+ */
+EsmsPesPacketNodePtr getPesPacketNodeEsmsNodesPool(
+  EsmsNodesPool * pool
+);
+
+/** \~english
+ * \brief Give back a PES packet node (and optionally its siblings) to
+ * supplied pool.
+ *
+ * \param pool Destination pool.
+ * \param node Released node.
+ * \param recursive If true, all the following nodes are released too.
+ *
+ * Commands attached to released nodes are released too.
+ */
+void releasePesPacketNodeEsmsNodesPool(
+  EsmsNodesPool * pool,
+  EsmsPesPacketNodePtr node,
+  bool recursive
+);
+
+/** \~english
+ * \brief Announce source files regions readed by supplied PES packets.
+ *
+ * \param srcFiles Opened ESMS source files.
+ * \param nodes Queued PES packets nodes list.
+ *
+ * For each source file, "Add PES payload" commands of supplied nodes list
+ * are merged in contiguous regions (adjacent, overlapping or separated by
+ * less than #ESMS_READ_AHEAD_MAX_GAP bytes) and each region is announced to
+ * the operating system using #adviseBitstreamReader().
+ */
+void adviseReadAheadEsmsESSourceFiles(
+  EsmsESSourceFiles srcFiles,
+  const EsmsPesPacketNodePtr nodes
+);
+
 /* ### ESMS files utilities : ############################################## */
 
 typedef enum {
@@ -900,6 +1045,46 @@ int seekDirectoryOffset(
   ESMSDirectoryId id
 );
 
+/** \~english
+ * \brief Parse ESMS script file directories table.
+ *
+ * \param script ESMS script file handle, reading position is set after the
+ * table on success.
+ * \param dst Destination directories table.
+ * \return int On success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Allows to fetch every directory offset with a single reading of the script
+ * header, rather than re-opening the file for each lookup using
+ * #getDirectoryOffset().
+ */
+int parseDirectoriesEsms(
+  BitstreamReaderPtr script,
+  EsmsFileDirectories * dst
+);
+
+/** \~english
+ * \brief Fetch a directory by ID from a parsed directories table.
+ *
+ * \param dirs Directories table from #parseDirectoriesEsms().
+ * \param id Looked directory ID.
+ * \param offset On success, directory offset return pointer
+ * (can be NULL).
+ * \return ESMSDirectoryFetcherErrorCodes On success, a zero value is
+ * returned. Otherwise, #ESMS_DF_NOT_FOUND is returned.
+ */
+ESMSDirectoryFetcherErrorCodes getDirectoryOffsetEsmsFileDirectories(
+  const EsmsFileDirectories * dirs,
+  ESMSDirectoryId id,
+  uint64_t * offset
+);
+
+int seekDirectoryEsmsFileDirectories(
+  BitstreamReaderPtr essHandle,
+  const EsmsFileDirectories * dirs,
+  ESMSDirectoryId id
+);
+
 int checkDirectoryMagic(
   BitstreamReaderPtr script,
   const char * magic,
@@ -96,43 +96,6 @@ int parseESPropertiesHeaderEsms(
   return 0;
 }
 
-static int checkCrcEntryESPropertiesSourceFilesEsms(
-  const lbc * filepath,
-  EsmsESSourceFile prop
-)
-{
-  uint8_t * buf;
-  BitstreamReaderPtr file;
-  uint32_t crcResult;
-
-  if (NULL == (buf = (uint8_t *) malloc(prop.crcCheckedBytes)))
-    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
-
-  if (NULL == (file = createBitstreamReaderDefBuf(filepath)))
-    LIBBLU_ERROR_FRETURN("Unable to open source file.\n");
-
-  if (readBytes(file, buf, prop.crcCheckedBytes) < 0)
-    return -1;
-
-  crcResult = lb_compute_crc32(buf, 0, prop.crcCheckedBytes);
-
-  closeBitstreamReader(file);
-  free(buf);
-
-  if (crcResult != prop.crc32)
-    LIBBLU_ERROR_RETURN(
-      "Source file '%" PRI_LBCS "' checksum error.\n",
-      filepath
-    );
-
-  return 0;
-
-free_return:
-  closeBitstreamReader(file);
-  free(buf);
-  return -1;
-}
-
 static int parseEntryESPropertiesSourceFilesEsms(
   BitstreamReaderPtr script,
   EsmsESSourceFiles * dst
@@ -172,9 +135,8 @@ static int parseEntryESPropertiesSourceFilesEsms(
 
   setEsmsESSourceFile(&prop, crcValue, crcCoveredSize);
 
-  /* Check CRC-32 */
-  if (checkCrcEntryESPropertiesSourceFilesEsms(convFilepath, prop) < 0)
-    goto free_return;
+  /* CRC-32 is not checked again here, source files have already been
+  verified by isAValidESMSFile() or checksummed during script generation. */
 
   /* Save file */
   if (appendEsmsESSourceFiles(dst, convFilepath, prop) < 0)
@@ -630,8 +592,8 @@ static int parseScriptAddDataCommandEsmsPesPacketNode(
       data->dataUsedSize
     );
 
-  return setEsmsAddDataCommand(
-    &dst->command.data.addData,
+  return setAddDataCommandEsmsCommandNode(
+    dst,
     offset,
     mode,
     data->data + ADD_DATA_COM_LEN,
@@ -828,7 +790,8 @@ static int parseScriptAddDataBlockCommandEsmsPesPacketNode(
 static int parseScriptCommandsEsmsPesPacketNode(
   EsmsPesPacketNodePtr dst,
   BitstreamReaderPtr script,
-  EsmsCommandParsingData * data
+  EsmsCommandParsingData * data,
+  EsmsNodesPool * pool
 )
 {
   unsigned i, nbScriptCommands;
@@ -849,12 +812,12 @@ static int parseScriptCommandsEsmsPesPacketNode(
     /* [u8 commandType] */
     READ_VALUE(script, 1, &commandId, return -1);
 
-    if (NULL == (curCommand = createEsmsCommandNode(commandId)))
+    if (NULL == (curCommand = getCommandNodeEsmsNodesPool(pool, commandId)))
       return -1;
 
     /* [u16 commandRawDataSize] [vn rawData] */
     if (readRawDataEsmsCommandParsingData(data, script) < 0)
-      return -1;
+      goto free_return;
 
     switch (commandId) {
       case ESMS_ADD_DATA: /* 0x00 : Add data */
@@ -880,13 +843,13 @@ static int parseScriptCommandsEsmsPesPacketNode(
         break;
 
       default:
-        LIBBLU_ERROR_RETURN(
+        LIBBLU_ERROR_FRETURN(
           "Unknown command type value 0x%x.\n",
           commandId
         );
     }
     if (ret < 0)
-      return -1;
+      goto free_return;
 
     /* Adding frame node : */
     if (NULL == dst->commands)
@@ -897,6 +860,10 @@ static int parseScriptCommandsEsmsPesPacketNode(
   }
 
   return 0;
+
+free_return:
+  releaseCommandNodeEsmsNodesPool(pool, curCommand, false);
+  return -1;
 }
 
 #undef READ_VALUE
@@ -907,18 +874,23 @@ static int parseScriptCommandsEsmsPesPacketNode(
 EsmsPesPacketNodePtr parseFrameNodeESPesCuttingEsms(
   BitstreamReaderPtr script,
   LibbluStreamCodingType codingType,
-  EsmsCommandParsingData * data
+  EsmsCommandParsingData * data,
+  EsmsNodesPool * pool
 )
 {
   EsmsPesPacketNodePtr node;
 
-  if (NULL == (node = createEsmsPesPacketNode()))
+  if (NULL == (node = getPesPacketNodeEsmsNodesPool(pool)))
     return NULL;
 
   if (parsePropertiesEsmsPesPacketNode(node, script, codingType) < 0)
-    return NULL;
+    goto free_return;
 
-  if (parseScriptCommandsEsmsPesPacketNode(node, script, data) < 0)
-    return NULL;
+  if (parseScriptCommandsEsmsPesPacketNode(node, script, data, pool) < 0)
+    goto free_return;
   return node;
+
+free_return:
+  releasePesPacketNodeEsmsNodesPool(pool, node, false);
+  return NULL;
 }
\ No newline at end of file
@@ -18,13 +18,13 @@
 /* ### ESMS ES Properties section : ######################################## */
 
 static inline int seekESPropertiesEsms(
-  const lbc * scriptFilename,
-  BitstreamReaderPtr scriptHandle
+  BitstreamReaderPtr scriptHandle,
+  const EsmsFileDirectories * dirs
 )
 {
-  return seekDirectoryOffset(
+  return seekDirectoryEsmsFileDirectories(
     scriptHandle,
-    scriptFilename,
+    dirs,
     ESMS_DIRECTORY_ID_ES_PROP
   );
 }
@@ -51,13 +51,13 @@ static inline bool isConcernedESFmtPropertiesEsms(
 }
 
 static inline int seekESFmtPropertiesEsms(
-  const lbc * scriptFilename,
-  BitstreamReaderPtr scriptHandle
+  BitstreamReaderPtr scriptHandle,
+  const EsmsFileDirectories * dirs
 )
 {
-  return seekDirectoryOffset(
+  return seekDirectoryEsmsFileDirectories(
     scriptHandle,
-    scriptFilename,
+    dirs,
     ESMS_DIRECTORY_ID_ES_FMT_PROP
   );
 }
@@ -70,24 +70,25 @@ int parseESFmtPropertiesEsms(
 
 /* ### ESMS ES Data Blocks Definition section : ############################ */
 
-static inline int isPresentESDataBlocksDefinitionEsms(
-  const lbc * scriptFilename
+static inline bool isPresentESDataBlocksDefinitionEsms(
+  const EsmsFileDirectories * dirs
 )
 {
-  return isPresentDirectory(
-    scriptFilename,
-    ESMS_DIRECTORY_ID_ES_DATA_BLK_DEF
+  return ESMS_DF_OK == getDirectoryOffsetEsmsFileDirectories(
+    dirs,
+    ESMS_DIRECTORY_ID_ES_DATA_BLK_DEF,
+    NULL
   );
 }
 
 static inline int seekESDataBlocksDefinitionEsms(
-  const lbc * scriptFilename,
-  BitstreamReaderPtr scriptHandle
+  BitstreamReaderPtr scriptHandle,
+  const EsmsFileDirectories * dirs
 )
 {
-  return seekDirectoryOffset(
+  return seekDirectoryEsmsFileDirectories(
     scriptHandle,
-    scriptFilename,
+    dirs,
     ESMS_DIRECTORY_ID_ES_DATA_BLK_DEF
   );
 }
@@ -100,13 +101,13 @@ int parseESDataBlocksDefinitionEsms(
 /* ### ESMS ES PES Cutting section : ####################################### */
 
 static inline int seekESPesCuttingEsms(
-  const lbc * scriptFilename,
-  BitstreamReaderPtr scriptHandle
+  BitstreamReaderPtr scriptHandle,
+  const EsmsFileDirectories * dirs
 )
 {
-  return seekDirectoryOffset(
+  return seekDirectoryEsmsFileDirectories(
     scriptHandle,
-    scriptFilename,
+    dirs,
     ESMS_DIRECTORY_ID_ES_PES_CUTTING
   );
 }
@@ -139,11 +140,6 @@ static inline void cleanEsmsCommandParsingData(
 
 /* ######################################################################### */
 
-int seekESPesCuttingEsms(
-  const lbc * scriptFilename,
-  BitstreamReaderPtr scriptHandle
-);
-
 static inline bool isEndReachedESPesCuttingEsms(
   BitstreamReaderPtr script
 )
@@ -152,10 +148,22 @@ static inline bool isEndReachedESPesCuttingEsms(
   return (0xFF == nextUint8(script));
 }
 
+/** \~english
+ * \brief Parse next PES frame of a ESMS "PES cutting" section.
+ *
+ * \param script ESMS script handle.
+ * \param codingType ES coding type.
+ * \param data Commands parsing working data.
+ * \param pool Nodes pool used to obtain returned node and its commands.
+ * \return EsmsPesPacketNodePtr Upon success, parsed PES packet node is
+ * returned. It shall be given back to the pool after use. Otherwise, a NULL
+ * pointer is returned.
+ */
 EsmsPesPacketNodePtr parseFrameNodeESPesCuttingEsms(
   BitstreamReaderPtr script,
   LibbluStreamCodingType codingType,
-  EsmsCommandParsingData * data
+  EsmsCommandParsingData * data,
+  EsmsNodesPool * pool
 );
 
 #endif
\ No newline at end of file
@@ -64,6 +64,18 @@ static int parseHeaderMetaFile(
           );
         break;
 
+      case LBMETA_OPT__PES_LOOKAHEAD:
+        if (setPesLookaheadLibbluMuxingSettings(dst, argument.u64) < 0)
+          LIBBLU_ERROR_RETURN(
+            "Invalid '%" PRI_LBCS "' option value, "
+            "expect a value between %u (inclusive) "
+            "and %u (inclusive).\n",
+            option.name,
+            LIBBLU_MIN_PES_LOOKAHEAD,
+            LIBBLU_MAX_PES_LOOKAHEAD
+          );
+        break;
+
       case LBMETA_OPT__DVD_MEDIA:
         LIBBLU_MUX_SETTINGS_SET_GLB_OPTION(dst, dvdMedia, true);
         break;
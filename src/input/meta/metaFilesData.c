@@ -31,6 +31,8 @@ static const LibbluMetaOption options[] = {
     (HRD)),
   D_(         LBMETA_OPT__MUX_RATE,          "mux-rate", LBMETA_OPTARG_UINT64,
     (HRD)),
+  D_(    LBMETA_OPT__PES_LOOKAHEAD,     "pes-lookahead", LBMETA_OPTARG_UINT64,
+    (HRD)),
 
   D_(    LBMETA_OPT__DISABLE_FIXES,     "disable-fixes", LBMETA_OPTARG_NO_ARG,
     (STREAM_CODING_TYPE_AVC)),
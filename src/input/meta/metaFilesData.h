@@ -17,6 +17,7 @@ typedef enum {
 
   LBMETA_OPT__START_TIME,
   LBMETA_OPT__MUX_RATE,
+  LBMETA_OPT__PES_LOOKAHEAD,
 
   LBMETA_OPT__DVD_MEDIA,
 
@@ -2,9 +2,11 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <getopt.h>
 #include <string.h>
 #include <time.h>
+#include <errno.h>
 #include <assert.h>
 
 #include "util.h"
@@ -48,6 +50,19 @@ static void printHelp(
   P("     mainMuxer [options] -i <infile> [-o <outfile>]                    ");
   P("                                                                       ");
   P(" Options:                                                              ");
+  P("  --auto-mux-rate          Search the lowest multiplex rate (not above ");
+  P("                           the requested one) passing the T-STD        ");
+  P("                           buffering model, using fast simulations,    ");
+  P("                           then mux at this rate.                      ");
+  P("                                                                       ");
+  P("  --batch <manifest>       Process every mux job listed in the supplied");
+  P("                           manifest, one job per line with input META  ");
+  P("                           and output filenames separated by a tab.    ");
+  P("                           Other options apply to every job. A result  ");
+  P("                           line starting with \"BATCH\" is printed per ");
+  P("                           job (tab-separated index, OK/FAILED status, ");
+  P("                           input, output and duration in seconds).     ");
+  P("                                                                       ");
   P("  -c <configfile>          Use supplied INI file as configuration file.");
   P("  --config <configfile>                                                ");
   P("                                                                       ");
@@ -56,6 +71,13 @@ static void printHelp(
   P("                           See list of available debugging options in  ");
   P("                           dedicated section.                          ");
   P("                                                                       ");
+  P("  --decode-trace <trace>   Print as text the muxer decisions recorded  ");
+  P("                           in the supplied trace (see --trace) and     ");
+  P("                           exit. Events may be filtered using:         ");
+  P("    --trace-pid <pid>        Only events of the supplied PID;          ");
+  P("    --trace-range <s>:<e>    Only events between supplied STC values   ");
+  P("                             (27MHz ticks, inclusive).                 ");
+  P("                                                                       ");
   P("  -e --only-esms           Only performs input files scripts (ESMS     ");
   P("                           files) generation without muxing.           ");
   P("                                                                       ");
@@ -67,12 +89,52 @@ static void printHelp(
   P("  -i <infile>              Set the input mux instructions file (META). ");
   P("  --input <infile>                                                     ");
   P("                                                                       ");
-  P("  -o <outfile>             Set the output file.                        ");
-  P("  --output <outfile>                                                   ");
+  P("  -n --dry-run             Simulate the mux without writing output.    ");
+  P("                           T-STD buffering model is still applied and  ");
+  P("                           statistics are displayed (packets per PID,  ");
+  P("                           NULL packets ratio, buffers peak levels).   ");
+  P("                                                                       ");
+  P("  -o <outfile>             Set the output file. If \"-\" is used, the  ");
+  P("  --output <outfile>       stream is written on standard output (e.g.  ");
+  P("                           a pipe), program messages are then written  ");
+  P("                           on standard error.                          ");
   P("                                                                       ");
   P("  --printdebug             Display every debugging option with a short ");
   P("                           description.                                ");
   P("                                                                       ");
+  P("  --profile[=<file>]       Display time spent in main muxing phases    ");
+  P("                           (ESMS parsing, payload reads, PES assembly, ");
+  P("                           TS packetisation, T-STD, heap, flushes).    ");
+  P("                           If a filename is supplied, the summary is   ");
+  P("                           also written in JSON format. In batch mode, ");
+  P("                           it is written for each job next to its      ");
+  P("                           output file (<outfile>.profile.json).       ");
+  P("                                                                       ");
+  P("  --realtime               Write the output at multiplex rate, paced to");
+  P("                           wall-clock time (e.g. to feed a player      ");
+  P("                           through a FIFO or a pipe). Emission jitter  ");
+  P("                           statistics are displayed.                   ");
+  P("                                                                       ");
+  P("  --resume                 Resume an interrupted mux from the last     ");
+  P("                           checkpoint saved next to the output file    ");
+  P("                           (<outfile>.ckpt). Same inputs and settings  ");
+  P("                           must be used.                               ");
+  P("                                                                       ");
+  P("  --stats[=<file>]         Write a JSON statistics report (packets per ");
+  P("                           PID, PCR intervals, NULL packets ratio,     ");
+  P("                           T-STD buffers occupancy). By default, it is ");
+  P("                           written next to the output file             ");
+  P("                           (<outfile>.stats.json).                     ");
+  P("                                                                       ");
+  P("  --timeline[=<file>]      Write a CSV timeline of T-STD buffers       ");
+  P("                           filling levels, sampled every 1024 packets  ");
+  P("                           (by default <outfile>.timeline.csv).        ");
+  P("                                                                       ");
+  P("  --trace[=<file>]         Record muxer decisions (muxed packets, PID, ");
+  P("                           STC, timestamps, T-STD buffers levels,      ");
+  P("                           delayed injections) in a compact binary     ");
+  P("                           trace file (by default <outfile>.trace).    ");
+  P("                                                                       ");
   P(" If no output filename is specified, \"out.m2ts\" default filename     ");
   P(" is used.                                                              ");
   P("                                                                       ");
@@ -225,6 +287,10 @@ static void printHelp(
   P("                      (range: 500000 - 120000000).                     ");
   P("                      Default: 48000000 (48Mbps)                       ");
   P("                                                                       ");
+  P("  --pes-lookahead=<value>                                              ");
+  P("                      Number of PES packets prepared in advance for    ");
+  P("                      each stream (range: 1 - 10000). Default: 30      ");
+  P("                                                                       ");
   P("  --force-esms        Force regeneration of an input stream script file");
   P("                      regardless of a compatible existent one (which   ");
   P("                      will be erased if present).                      ");
@@ -391,6 +457,253 @@ static void printDebugOptions(
   lbc_printf("\n");
 }
 
+/** \~english
+ * \brief Command line modes, applied to each mux job.
+ */
+typedef struct {
+  bool esmsGenerationOnly;
+  bool forceRemakeScripts;
+  bool dryRun;
+  bool autoMuxRate;
+  bool resume;
+  bool realtime;
+  bool stats;                    /**< Write a JSON statistics report.      */
+  const lbc * statsFilepath;     /**< Statistics report filepath, if NULL
+    derivated from the output filename.                                      */
+  bool timeline;                 /**< Write a buffers occupancy timeline.  */
+  const lbc * timelineFilepath;  /**< Timeline filepath, if NULL derivated
+    from the output filename.                                                */
+  bool trace;                    /**< Record muxer decisions trace.        */
+  bool profileReport;            /**< Write a JSON profiling summary.      */
+  const lbc * profileFilepath;   /**< Profiling summary filepath, if NULL
+    derivated from the output filename.                                      */
+  const lbc * traceFilepath;     /**< Trace filepath, if NULL derivated
+    from the output filename.                                                */
+} MuxingModes;
+
+/** \~english
+ * \brief Process a mux job.
+ *
+ * \param inputFilepath Input META filename.
+ * \param outputFilepath Output filename, if NULL default one is used.
+ * \param outputStream Non-seekable output stream, if not NULL, used instead
+ * of the output filename.
+ * \param confFile Shared configuration file handle (may be NULL).
+ * \param modes Command line modes.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+static int processMuxJob(
+  const lbc * inputFilepath,
+  const lbc * outputFilepath,
+  FILE * outputStream,
+  IniFileContextPtr confFile,
+  const MuxingModes * modes
+)
+{
+  LibbluMuxingSettings param;
+
+  if (initLibbluMuxingSettings(&param, outputFilepath, confFile) < 0)
+    return -1;
+  param.outputStream = outputStream;
+
+  LIBBLU_MUX_SETTINGS_SET_OPTION(
+    &param,
+    forceRebuildScripts,
+    modes->forceRemakeScripts
+  );
+  LIBBLU_MUX_SETTINGS_SET_OPTION(
+    &param,
+    dryRun,
+    modes->dryRun
+  );
+  LIBBLU_MUX_SETTINGS_SET_OPTION(
+    &param,
+    autoMuxRate,
+    modes->autoMuxRate
+  );
+  LIBBLU_MUX_SETTINGS_SET_OPTION(
+    &param,
+    resume,
+    modes->resume
+  );
+  LIBBLU_MUX_SETTINGS_SET_OPTION(
+    &param,
+    realtime,
+    modes->realtime
+  );
+
+  if (modes->stats) {
+    if (setStatsFilepathLibbluMuxingSettings(&param, modes->statsFilepath) < 0) {
+      cleanLibbluMuxingSettings(param);
+      return -1;
+    }
+  }
+  if (modes->timeline) {
+    if (setTimelineFilepathLibbluMuxingSettings(&param, modes->timelineFilepath) < 0) {
+      cleanLibbluMuxingSettings(param);
+      return -1;
+    }
+  }
+  if (modes->profileReport) {
+    if (setProfileFilepathLibbluMuxingSettings(&param, modes->profileFilepath) < 0) {
+      cleanLibbluMuxingSettings(param);
+      return -1;
+    }
+  }
+  if (modes->trace) {
+    if (setTraceFilepathLibbluMuxingSettings(&param, modes->traceFilepath) < 0) {
+      cleanLibbluMuxingSettings(param);
+      return -1;
+    }
+  }
+
+  if (parseMetaFile(inputFilepath, &param) < 0) {
+    cleanLibbluMuxingSettings(param);
+    return -1;
+  }
+
+  /* DO NOT clean muxing settings since these are managed by the context. */
+  if (!modes->esmsGenerationOnly)
+    return mainMux(param);
+  else {
+    LibbluMuxingContextPtr ctx;
+
+    param.options.disableTStdBufVerifier = true;
+
+    /* Create muxing context and destroy it immediately */
+    if (NULL == (ctx = createLibbluMuxingContext(param)))
+      return -1;
+    destroyLibbluMuxingContext(ctx);
+  }
+
+  return 0;
+}
+
+/** \~english
+ * \brief Process every mux job listed in a batch manifest.
+ *
+ * \param manifestFilepath Manifest filename.
+ * \param confFile Shared configuration file handle (may be NULL).
+ * \param modes Command line modes.
+ * \return int If every job succeed, a zero value is returned. Otherwise, a
+ * negative value is returned.
+ *
+ * Manifest is a UTF-8 text file listing a job per line, with the input META
+ * filename and the output filename separated by a tabulation. Empty lines
+ * and lines starting with '#' are ignored. Jobs are processed in order, a
+ * failing job does not stop the batch. Each job result is reported on a
+ * tab-separated line starting with "BATCH".
+ */
+static int processBatchManifest(
+  const lbc * manifestFilepath,
+  IniFileContextPtr confFile,
+  const MuxingModes * modes
+)
+{
+  FILE * manifest;
+  char line[2 * PATH_BUFSIZE];
+  unsigned lineIdx, nbJobs, nbFailedJobs;
+
+  if (NULL == (manifest = lbc_fopen(manifestFilepath, "r")))
+    LIBBLU_ERROR_RETURN(
+      "Unable to open batch manifest '%" PRI_LBCS "', %s (errno: %d).\n",
+      manifestFilepath,
+      strerror(errno),
+      errno
+    );
+
+  lineIdx = nbJobs = nbFailedJobs = 0;
+  while (NULL != fgets(line, sizeof(line), manifest)) {
+    lbc * inputFilepath, * outputFilepath;
+    char * separator;
+    double jobStart, jobEnd;
+    int ret;
+
+    lineIdx++;
+    line[strcspn(line, "\r\n")] = '\0';
+    if ('\0' == line[0] || '#' == line[0])
+      continue; /* Empty line or comment */
+
+    nbJobs++;
+    if (NULL != (separator = strchr(line, '\t')))
+      *separator = '\0';
+
+    inputFilepath = lbc_utf8_convto((unsigned char *) line);
+    outputFilepath = lbc_utf8_convto(
+      (unsigned char *) ((NULL != separator) ? separator + 1 : "")
+    );
+    if (NULL == inputFilepath || NULL == outputFilepath) {
+      free(inputFilepath);
+      free(outputFilepath);
+      fclose(manifest);
+      LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+    }
+
+    lbc_printf(
+      "== Batch job %u: '%" PRI_LBCS "' ==\n",
+      nbJobs,
+      inputFilepath
+    );
+
+    /* Wall-clock duration, jobs may use several threads. Informative only,
+      left to zero if unavailable. */
+    jobStart = jobEnd = 0.0;
+    if (lb_get_monotonic_time(&jobStart) < 0)
+      jobStart = 0.0;
+    if (NULL == separator) {
+      LIBBLU_ERROR(
+        "Batch manifest line %u: expect '<input META>\\t<output>'.\n",
+        lineIdx
+      );
+      ret = -1;
+    }
+    else if (lbc_equal(outputFilepath, LIBBLU_STDOUT_OUTPUT_FILENAME)) {
+      LIBBLU_ERROR(
+        "Batch manifest line %u: standard output is not allowed.\n",
+        lineIdx
+      );
+      ret = -1;
+    }
+    else
+      ret = processMuxJob(inputFilepath, outputFilepath, NULL, confFile, modes);
+    if (ret < 0)
+      nbFailedJobs++;
+    if (0.0 < jobStart && lb_get_monotonic_time(&jobEnd) < 0)
+      jobEnd = jobStart;
+
+    lbc_printf(
+      "BATCH\t%u\t%s\t%" PRI_LBCS "\t%" PRI_LBCS "\t%.2f\n",
+      nbJobs,
+      (ret < 0) ? "FAILED" : "OK",
+      inputFilepath,
+      outputFilepath,
+      jobEnd - jobStart
+    );
+
+    free(inputFilepath);
+    free(outputFilepath);
+  }
+
+  if (ferror(manifest)) {
+    fclose(manifest);
+    LIBBLU_ERROR_RETURN(
+      "Error happen during batch manifest reading, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+  }
+  fclose(manifest);
+
+  lbc_printf(
+    "Batch completed: %u job(s), %u failed.\n",
+    nbJobs,
+    nbFailedJobs
+  );
+
+  return (0 < nbFailedJobs) ? -1 : 0;
+}
+
 int main(
   int argc,
   char ** argv
@@ -400,7 +713,6 @@ int main(
   clock_t duration, start;
   bool cont;
 
-  LibbluMuxingSettings param;
   IniFileContextPtr confFile = NULL;
 
 #if !defined(DISABLE_INI)
@@ -408,9 +720,15 @@ int main(
 #endif
   const lbc * inputInstructionsFilepath = NULL;
   const lbc * outputTsFilepath = NULL;
+  const lbc * batchManifestFilepath = NULL;
 
-  bool esmsGenerationOnlyMode;
-  bool forceRemakeScripts;
+  FILE * outputStream = NULL;
+
+  const lbc * decodeTraceFilepath = NULL;
+  LibbluMuxingTraceFilter traceFilter;
+
+  MuxingModes modes;
+  int ret;
 
 #if defined(ARCH_WIN32)
   int argc_wchar;
@@ -418,6 +736,8 @@ int main(
 #endif
 
   static const struct option programOptions[] = {
+    {"auto-mux-rate"   , no_argument      , NULL,  'a'},
+    {"batch"           , required_argument, NULL,  'b'},
     {"conf"            , required_argument, NULL,  'c'},
     {"d"               , optional_argument, NULL,  'd'},
     {"debug"           , optional_argument, NULL,  'd'},
@@ -429,9 +749,20 @@ int main(
     {"help"            , no_argument      , NULL,  'h'},
     {"i"               , required_argument, NULL,  'i'},
     {"input"           , required_argument, NULL,  'i'},
+    {"n"               , no_argument      , NULL,  'n'},
+    {"dry-run"         , no_argument      , NULL,  'n'},
     {"o"               , required_argument, NULL,  'o'},
     {"output"          , required_argument, NULL,  'o'},
     {"printdebug"      , no_argument      , NULL,  'p'},
+    {"profile"         , optional_argument, NULL,  'P'},
+    {"realtime"        , no_argument      , NULL,  't'},
+    {"stats"           , optional_argument, NULL,  's'},
+    {"timeline"        , optional_argument, NULL,  'l'},
+    {"trace"           , optional_argument, NULL,  'T'},
+    {"decode-trace"    , required_argument, NULL,  'D'},
+    {"trace-pid"       , required_argument, NULL,  'I'},
+    {"trace-range"     , required_argument, NULL,  'R'},
+    {"resume"          , no_argument      , NULL,  'r'},
     {NULL              , no_argument      , NULL, '\0'}
   };
 
@@ -454,8 +785,23 @@ int main(
 #endif
 
   opterr = 0;
-  esmsGenerationOnlyMode = false;
-  forceRemakeScripts = false;
+  modes = (MuxingModes) {
+    .esmsGenerationOnly = false,
+    .forceRemakeScripts = false,
+    .dryRun = false,
+    .autoMuxRate = false,
+    .resume = false,
+    .realtime = false,
+    .stats = false,
+    .statsFilepath = NULL,
+    .timeline = false,
+    .timelineFilepath = NULL,
+    .trace = false,
+    .traceFilepath = NULL,
+    .profileReport = false,
+    .profileFilepath = NULL
+  };
+  traceFilter = LIBBLU_TRACE_NO_FILTER;
 
   start = clock();
 
@@ -471,8 +817,6 @@ int main(
   exit(0);
 #endif
 
-  lbc_printf(PROG_INFOS " (" PROG_ARCH ")\n\n");
-
   /* defineDebugVerboseLevel(1); */
 
 #if defined(ARCH_WIN32)
@@ -489,6 +833,16 @@ int main(
     )
   ) {
     switch (option) {
+      case 'a':
+        modes.autoMuxRate = true;
+        break;
+
+      case 'b':
+        if (NULL == optarg)
+          LIBBLU_ERROR_RETURN("Expect a manifest filename after '--batch'.\n");
+        batchManifestFilepath = ARG_VAL;
+        break;
+
       case 'c':
 #if !defined(DISABLE_INI)
         if (NULL == optarg)
@@ -505,15 +859,16 @@ int main(
         break;
 
       case 'e':
-        esmsGenerationOnlyMode = true;
+        modes.esmsGenerationOnly = true;
         break;
 
       case 'f':
-        forceRemakeScripts = true;
+        modes.forceRemakeScripts = true;
         break;
 
       case 'h':
         /* Help */
+        lbc_printf(PROG_INFOS " (" PROG_ARCH ")\n\n");
         printHelp();
         return 0;
 
@@ -524,6 +879,10 @@ int main(
         inputInstructionsFilepath = ARG_VAL;
         break;
 
+      case 'n':
+        modes.dryRun = true;
+        break;
+
       case 'o':
         /* Output */
         if (NULL == optarg)
@@ -532,9 +891,73 @@ int main(
         break;
 
       case 'p':
+        lbc_printf(PROG_INFOS " (" PROG_ARCH ")\n\n");
         printDebugOptions();
         return 0;
 
+      case 'P':
+        if (enableLibbluProfiling() < 0)
+          return -1;
+        modes.profileReport = (NULL != optarg);
+        modes.profileFilepath = (NULL != optarg) ? ARG_VAL : NULL;
+        break;
+
+      case 'r':
+        modes.resume = true;
+        break;
+
+      case 's':
+        modes.stats = true;
+        modes.statsFilepath = (NULL != optarg) ? ARG_VAL : NULL;
+        break;
+
+      case 't':
+        modes.realtime = true;
+        break;
+
+      case 'l':
+        modes.timeline = true;
+        modes.timelineFilepath = (NULL != optarg) ? ARG_VAL : NULL;
+        break;
+
+      case 'T':
+        modes.trace = true;
+        modes.traceFilepath = (NULL != optarg) ? ARG_VAL : NULL;
+        break;
+
+      case 'D':
+        if (NULL == optarg)
+          LIBBLU_ERROR_RETURN(
+            "Expect a trace filename after '--decode-trace'.\n"
+          );
+        decodeTraceFilepath = ARG_VAL;
+        break;
+
+      case 'I': {
+        char * end;
+        long pid;
+
+        pid = (NULL != optarg) ? strtol(optarg, &end, 0) : -1;
+        if (NULL == optarg || '\0' != *end || pid < 0 || 0x1FFF < pid)
+          LIBBLU_ERROR_RETURN("Expect a valid PID value after '--trace-pid'.\n");
+        traceFilter.pid = pid;
+        break;
+      }
+
+      case 'R':
+        if (
+          NULL == optarg
+          || 2 != sscanf(
+            optarg, "%" SCNu64 ":%" SCNu64,
+            &traceFilter.startStc,
+            &traceFilter.endStc
+          )
+        )
+          LIBBLU_ERROR_RETURN(
+            "Expect a '<start>:<end>' STC range after '--trace-range'.\n"
+          );
+        break;
+
       case -1:
         /* End of options */
         cont = false;
@@ -550,6 +973,22 @@ int main(
 
 #undef ARG_VAL
 
+  if (NULL != decodeTraceFilepath) {
+    /* Trace decoding only, output is kept free of program messages. */
+    return decodeLibbluMuxingTrace(decodeTraceFilepath, traceFilter);
+  }
+
+  if (
+    NULL != outputTsFilepath
+    && lbc_equal(outputTsFilepath, LIBBLU_STDOUT_OUTPUT_FILENAME)
+  ) {
+    /* Streaming output, program messages are moved to standard error. */
+    if (NULL == (outputStream = lb_detach_stdout()))
+      return -1;
+  }
+
+  lbc_printf(PROG_INFOS " (" PROG_ARCH ")\n\n");
+
 #if !defined(DISABLE_INI)
   if (NULL == confFilepath) {
     if (0 <= lbc_access_fp(PROG_CONF_FILENAME, "r")) {
@@ -563,37 +1002,58 @@ int main(
   }
 #endif
 
-  if (NULL == inputInstructionsFilepath)
-    LIBBLU_ERROR_RETURN(
-      "Expect a input META filename (see -h/--help).\n"
-    );
-
-  if (initLibbluMuxingSettings(&param, outputTsFilepath, confFile) < 0)
-    goto free_return;
-
-  LIBBLU_MUX_SETTINGS_SET_OPTION(
-    &param,
-    forceRebuildScripts,
-    forceRemakeScripts
-  );
-
-  if (parseMetaFile(inputInstructionsFilepath, &param) < 0)
-    goto free_return;
-
-  if (!esmsGenerationOnlyMode) {
-    if (mainMux(param) < 0)
-      return -1;
+  if (NULL != batchManifestFilepath) {
+    if (NULL != inputInstructionsFilepath || NULL != outputTsFilepath) {
+      destroyIniFileContext(confFile);
+      LIBBLU_ERROR_RETURN(
+        "Options '-i' and '-o' cannot be used in batch mode.\n"
+      );
+    }
+    if (
+      NULL != modes.statsFilepath
+      || NULL != modes.timelineFilepath
+      || NULL != modes.traceFilepath
+      || NULL != modes.profileFilepath
+    ) {
+      destroyIniFileContext(confFile);
+      LIBBLU_ERROR_RETURN(
+        "Statistics, trace and profiling filenames cannot be set in batch "
+        "mode, these are derivated from each output filename.\n"
+      );
+    }
+    /* Each job writes its own profiling summary. */
+    modes.profileReport = isEnabledLibbluProfiling();
+    ret = processBatchManifest(batchManifestFilepath, confFile, &modes);
   }
   else {
-    LibbluMuxingContextPtr ctx;
-
-    param.options.disableTStdBufVerifier = true;
-
-    /* Create muxing context and destroy it immediately */
-    if (NULL == (ctx = createLibbluMuxingContext(param)))
-      goto free_return;
-    destroyLibbluMuxingContext(ctx);
+    if (NULL == inputInstructionsFilepath) {
+      destroyIniFileContext(confFile);
+      LIBBLU_ERROR_RETURN(
+        "Expect a input META filename (see -h/--help).\n"
+      );
+    }
+    if (
+      NULL != outputStream
+      && (
+        (modes.stats && NULL == modes.statsFilepath)
+        || (modes.timeline && NULL == modes.timelineFilepath)
+      )
+    ) {
+      destroyIniFileContext(confFile);
+      LIBBLU_ERROR_RETURN(
+        "Statistics filenames must be set when writing on standard output.\n"
+      );
+    }
+    ret = processMuxJob(
+      inputInstructionsFilepath,
+      outputTsFilepath,
+      outputStream,
+      confFile,
+      &modes
+    );
   }
+  if (ret < 0)
+    goto free_return;
 
 #if defined(ARCH_WIN32)
   /* On windows, release the iconv libary handle */
@@ -604,12 +1064,10 @@ int main(
   duration = clock() - start;
   lbc_printf("Total execution time: %ld ticks (%.2fs, %ld ticks/s).\n", duration, (float) duration / CLOCKS_PER_SEC, (clock_t) CLOCKS_PER_SEC);
 
-  /* DO NOT clean muxing settings since these has been managed by mainMux(). */
   destroyIniFileContext(confFile);
   return 0;
 
 free_return:
-  cleanLibbluMuxingSettings(param);
   destroyIniFileContext(confFile);
 
   duration = clock() - start;
@@ -10,14 +10,13 @@
 #include "mainMuxer.h"
 
 static void printProgressBar(
-  double progression
+  double progression,
+  double * lastPercentage
 )
 {
   double percentage;
   int barSize;
 
-  static double lastPercentage = -1;
-
   static const unsigned targetedDecima = 1;
   static const double pow10[10] = {
     1,
@@ -38,9 +37,9 @@ static void printProgressBar(
     progression * pow10[targetedDecima+2]
   ) / pow10[targetedDecima];
 
-  if (percentage <= lastPercentage)
+  if (percentage <= *lastPercentage)
     return;
-  lastPercentage = percentage;
+  *lastPercentage = percentage;
 
   percentage = MIN(percentage, 100);
 
@@ -80,6 +79,186 @@ static void printBytes(
   lbc_printf("%.1f %s", mantissa, divSuf[nbDiv]);
 }
 
+static void printDryRunSummary(
+  const LibbluMuxingContextPtr ctx
+)
+{
+  unsigned nbNullPackets = ctx->null->packetNb;
+
+  lbc_printf("== Dry-run summary ====================================================================\n");
+  lbc_printf("No output written.\n");
+  lbc_printf(
+    "NULL packets: %u packets (%.1f%%).\n",
+    nbNullPackets,
+    ((float) nbNullPackets / MAX(1, ctx->nbTsPacketsMuxed)) * 100
+  );
+
+  if (!isEnabledTStdModelLibbluMuxingContext(ctx)) {
+    lbc_printf("T-STD buffering model disabled.\n");
+    return;
+  }
+
+  /* A completed mux never met any buffering model violation. */
+  lbc_printf("T-STD: No buffer overflow or underflow.\n");
+  if (0 < ctx->nbTStdDelayedPackets)
+    lbc_printf(
+      "T-STD: %u packets delayed to avoid overflow, "
+      "first delayed at STC %" PRIu64 " (PID 0x%04" PRIX16 ").\n",
+      ctx->nbTStdDelayedPackets,
+      ctx->firstTStdDelayStc,
+      ctx->firstTStdDelayPid
+    );
+  else
+    lbc_printf("T-STD: No packet delayed to avoid overflow.\n");
+
+  lbc_printf("T-STD buffers peak levels:\n");
+  printPeakLevelsBufModelBufferingChain(ctx->tStdModel, 1);
+}
+
+/** \~english
+ * \brief Simulate the mux at supplied multiplex rate.
+ *
+ * \param settings Muxing settings (copied, not modified).
+ * \param muxingRate Evaluated multiplex rate in bits per second.
+ * \param quiet If true, messages echoed by the simulation are discarded,
+ * unless it fails.
+ * \param compliant On success, set to true if the complete mux has been
+ * simulated without any buffering model violation.
+ * \return int Upon success, a zero value is returned. Otherwise, if the
+ * simulation cannot be initialized or fails for another reason than a
+ * buffering model violation, a negative value is returned.
+ */
+static int simulateMuxingRate(
+  const LibbluMuxingSettings * settings,
+  uint64_t muxingRate,
+  bool quiet,
+  bool * compliant
+)
+{
+  LibbluMessagesBuffer messages;
+  LibbluMuxingSettings simSettings;
+  LibbluMuxingContextPtr ctx = NULL;
+  BitstreamWriterPtr output = NULL;
+
+  initLibbluMessagesBuffer(&messages);
+  if (quiet)
+    setMessagesBufferLibblu(&messages);
+
+  if (copyLibbluMuxingSettings(&simSettings, settings) < 0)
+    goto free_return;
+  simSettings.targetMuxingRate = muxingRate;
+  LIBBLU_MUX_SETTINGS_SET_OPTION(&simSettings, dryRun, true);
+
+  /* simSettings is managed by the context, even on failure */
+  if (NULL == (ctx = createLibbluMuxingContext(simSettings)))
+    goto free_return;
+
+  if (NULL == (output = createNullBitstreamWriter(IO_VBUF_SIZE)))
+    goto free_return;
+
+  *compliant = true;
+  while (dataRemainingLibbluMuxingContext(ctx)) {
+    if (muxNextPacketLibbluMuxingContext(ctx, output) < 0) {
+      if (BUF_MODEL_NO_VIOLATION == ctx->tStdViolation)
+        goto free_return; /* Not related to the multiplex rate */
+      *compliant = false;
+      break;
+    }
+  }
+
+  closeBitstreamWriter(output);
+  destroyLibbluMuxingContext(ctx);
+  setMessagesBufferLibblu(NULL);
+  cleanLibbluMessagesBuffer(messages);
+
+  return 0;
+
+free_return:
+  closeBitstreamWriter(output);
+  destroyLibbluMuxingContext(ctx);
+  setMessagesBufferLibblu(NULL);
+  printLibbluMessagesBuffer(&messages);
+  cleanLibbluMessagesBuffer(messages);
+
+  return -1;
+}
+
+/** \~english
+ * \brief Search the lowest compliant multiplex rate.
+ *
+ * \param settings Muxing settings, on success 'targetMuxingRate' is set to
+ * the found rate.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Multiplex rate is bisected between #LIBBLU_MIN_MUXING_RATE and the
+ * supplied settings rate using payload-free simulations (see
+ * #simulateMuxingRate()). Only a buffering model violation rejects a
+ * candidate rate, any other error aborts the search.
+ *
+ * Candidates are evaluated sequentially, each bisection step depends on the
+ * previous one result. Spreading several candidates of a step over the
+ * tasks pool would only shorten the search logarithmically, at the cost of
+ * as many more simulations.
+ */
+static int searchMuxingRate(
+  LibbluMuxingSettings * settings
+)
+{
+  uint64_t lowRate, highRate;
+  bool compliant;
+
+  if (LIBBLU_MUX_SETTINGS_OPTION(settings, disableTStdBufVerifier))
+    LIBBLU_ERROR_RETURN(
+      "Automatic multiplex rate search requires the T-STD buffering model.\n"
+    );
+
+  lowRate = LIBBLU_MIN_MUXING_RATE;
+  highRate = settings->targetMuxingRate;
+
+  lbc_printf("Searching lowest compliant multiplex rate...\n");
+
+  /* Check upper bound, it also generates scripts if required. Its messages
+  are kept, reporting scripts generation or why streams cannot be muxed. */
+  if (simulateMuxingRate(settings, highRate, false, &compliant) < 0)
+    return -1;
+  LIBBLU_DEBUG_COM(
+    "Multiplex rate %" PRIu64 " bps: %s.\n",
+    highRate, compliant ? "compliant" : "non-compliant"
+  );
+  if (!compliant)
+    LIBBLU_ERROR_RETURN(
+      "Unable to mux streams at maximum multiplex rate %" PRIu64 " bps.\n",
+      highRate
+    );
+  /* Scripts are now up to date, do not rebuild them anymore. */
+  LIBBLU_MUX_SETTINGS_SET_OPTION(settings, forceRebuildScripts, false);
+
+  while (LIBBLU_AUTO_MUXING_RATE_PRECISION < highRate - lowRate) {
+    uint64_t rate = lowRate + (highRate - lowRate) / 2;
+
+    if (simulateMuxingRate(settings, rate, true, &compliant) < 0)
+      LIBBLU_ERROR_RETURN(
+        "Multiplex rate search aborted at %" PRIu64 " bps.\n",
+        rate
+      );
+    LIBBLU_DEBUG_COM(
+      "Multiplex rate %" PRIu64 " bps: %s.\n",
+      rate, compliant ? "compliant" : "non-compliant"
+    );
+
+    if (compliant)
+      highRate = rate;
+    else
+      lowRate = rate;
+  }
+
+  lbc_printf("Using multiplex rate: %" PRIu64 " bps.\n\n", highRate);
+  settings->targetMuxingRate = highRate;
+
+  return 0;
+}
+
 int mainMux(
   LibbluMuxingSettings settings
 )
@@ -87,36 +266,203 @@ int mainMux(
   BitstreamWriterPtr output = NULL;
 
   LibbluMuxingContextPtr ctx;
+  LibbluMuxingCheckpoint checkpoint;
+  lbc * checkpointFilepath;
+  uint32_t settingsHash;
+  unsigned lastCheckpointNbTsPackets;
+  LibbluMuxingPacer pacer;
+  LibbluMuxingTimeline timeline;
 
   unsigned nbSystemPackets, i;
-  bool debugMode;
+  bool debugMode, dryRun, resume, realtime;
+  double lastPercentage;
 
   LIBBLU_DEBUG_COM("Verbose output activated.\n");
   debugMode = isDebugEnabled() /* || true */;
+  dryRun = settings.options.dryRun;
+  resume = settings.options.resume;
+  realtime = settings.options.realtime;
+  ctx = NULL;
+  checkpointFilepath = NULL;
+  settingsHash = 0;
+  timeline.file = NULL;
+
+  if (dryRun && resume) {
+    cleanLibbluMuxingSettings(settings);
+    LIBBLU_ERROR_RETURN("Dry-run mode cannot resume a mux.\n");
+  }
+  if (dryRun && realtime) {
+    cleanLibbluMuxingSettings(settings);
+    LIBBLU_ERROR_RETURN("Dry-run mode cannot be paced in real-time.\n");
+  }
+  if (NULL != settings.outputStream && resume) {
+    cleanLibbluMuxingSettings(settings);
+    LIBBLU_ERROR_RETURN("Unable to resume a mux written on standard output.\n");
+  }
+
+  if (LIBBLU_MUX_SETTINGS_OPTION(&settings, autoMuxRate)) {
+    if (searchMuxingRate(&settings) < 0) {
+      cleanLibbluMuxingSettings(settings);
+      return -1;
+    }
+  }
+
+  if (!dryRun && NULL == settings.outputStream) {
+    /* Checkpoints require a regular output file. */
+    checkpointFilepath = buildFilepathLibbluMuxingCheckpoint(
+      settings.outputTsFilename
+    );
+    if (NULL == checkpointFilepath) {
+      cleanLibbluMuxingSettings(settings);
+      return -1;
+    }
+  }
 
   if (NULL == (ctx = createLibbluMuxingContext(settings)))
     goto free_return;
 
-  if (NULL == (output = createBitstreamWriter(settings.outputTsFilename, WRITE_BUFFER_LEN)))
-    goto free_return;
+  if (NULL != checkpointFilepath) {
+    if (computeSettingsHashLibbluMuxingCheckpoint(&settingsHash, ctx) < 0)
+      goto free_return;
+  }
+
+  if (resume) {
+    if (loadLibbluMuxingCheckpoint(&checkpoint, checkpointFilepath, settingsHash, &ctx->settings) < 0)
+      goto free_return;
+  }
+
+  /* Profiled period starts once scripts, generated by worker threads, are
+  ready. */
+  if (isEnabledLibbluProfiling()) {
+    if (startLibbluProfiling() < 0)
+      goto free_return;
+  }
+
+  if (dryRun) {
+    /* Simulation, written data is only counted. */
+    if (NULL == (output = createNullBitstreamWriter(IO_VBUF_SIZE)))
+      goto free_return;
+  }
+  else if (NULL != settings.outputStream) {
+    /* Streaming, packets are written sequentially without any seeking. */
+    output = createStreamBitstreamWriter(settings.outputStream, IO_VBUF_SIZE);
+    if (NULL == output)
+      goto free_return;
+  }
+  else if (resume) {
+    lbc_printf(
+      "Resuming from checkpoint (%u packets muxed)...\n",
+      checkpoint.nbTsPacketsMuxed
+    );
+    if (replayLibbluMuxingCheckpoint(ctx, &checkpoint) < 0)
+      goto free_return;
+
+    /* Following data is overwritten, muxing being deterministic, it is
+    identical to the content left by the interrupted mux. */
+    output = createResumingBitstreamWriter(
+      ctx->settings.outputTsFilename,
+      checkpoint.nbBytesWritten,
+      IO_VBUF_SIZE
+    );
+    if (NULL == output)
+      goto free_return;
+  }
+  else {
+    if (NULL == (output = createBitstreamWriter(settings.outputTsFilename, IO_VBUF_SIZE)))
+      goto free_return;
+    /* Discard checkpoint from a previous interrupted mux. */
+    lbc_remove(checkpointFilepath);
+  }
+  lastCheckpointNbTsPackets = ctx->nbTsPacketsMuxed;
+  lastPercentage = -1;
+
+  if (realtime) {
+    if (initLibbluMuxingPacer(&pacer, ctx) < 0)
+      goto free_return;
+  }
+
+  if (NULL != ctx->settings.timelineFilepath) {
+    if (openLibbluMuxingTimeline(&timeline, ctx->settings.timelineFilepath, ctx) < 0)
+      goto free_return;
+  }
+
+  if (NULL != ctx->settings.traceFilepath) {
+    if (NULL == (ctx->trace = createLibbluMuxingTrace(ctx->settings.traceFilepath)))
+      goto free_return;
+  }
 
   /* Mux packets while remain data */
   while (dataRemainingLibbluMuxingContext(ctx)) {
     if (muxNextPacketLibbluMuxingContext(ctx, output) < 0)
       goto free_return;
 
+    if (
+      NULL != checkpointFilepath
+      && isDueLibbluMuxingCheckpoint(ctx, lastCheckpointNbTsPackets)
+    ) {
+      if (saveLibbluMuxingCheckpoint(checkpointFilepath, ctx, settingsHash, output) < 0)
+        goto free_return;
+      lastCheckpointNbTsPackets = ctx->nbTsPacketsMuxed;
+    }
+
+    if (realtime && isDueLibbluMuxingPacer(&pacer, ctx)) {
+      if (paceLibbluMuxingPacer(&pacer, ctx, output) < 0)
+        goto free_return;
+    }
+
+    if (NULL != timeline.file && isDueLibbluMuxingTimeline(&timeline, ctx)) {
+      if (sampleLibbluMuxingTimeline(&timeline, ctx) < 0)
+        goto free_return;
+    }
+
     if (!debugMode)
-      printProgressBar(ctx->progress);
+      printProgressBar(ctx->progress, &lastPercentage);
   }
 
   /* Padding aligned unit (= 32 TS p.) with NULL packets : */
   if (padAlignedUnitLibbluMuxingContext(ctx, output) < 0)
     goto free_return;
 
+  if (realtime && isDueLibbluMuxingPacer(&pacer, ctx)) {
+    /* Last aligned unit completed by padding */
+    if (paceLibbluMuxingPacer(&pacer, ctx, output) < 0)
+      goto free_return;
+  }
+
   lbc_printf("Multiplexing... [====================] 100%% Finished !\n\n");
 
+  if (NULL != timeline.file) {
+    /* Last sample at end of mux */
+    if (timeline.lastNbTsPackets != ctx->nbTsPacketsMuxed) {
+      if (sampleLibbluMuxingTimeline(&timeline, ctx) < 0)
+        goto free_return;
+    }
+    if (closeLibbluMuxingTimeline(&timeline) < 0)
+      goto free_return;
+  }
+
+  if (NULL != ctx->settings.statsFilepath) {
+    if (writeReportLibbluMuxingStatistics(ctx->settings.statsFilepath, ctx) < 0)
+      goto free_return;
+  }
+
+  if (NULL != ctx->trace) {
+    LibbluMuxingTracePtr trace = ctx->trace;
+
+    lbc_printf("Muxer trace: %" PRIu64 " events recorded.\n", trace->nbEvents);
+    ctx->trace = NULL;
+    if (closeLibbluMuxingTrace(trace) < 0)
+      goto free_return;
+  }
+
   closeBitstreamWriter(output);
 
+  if (NULL != checkpointFilepath) {
+    /* Mux completed, checkpoint is no longer required. */
+    lbc_remove(checkpointFilepath);
+    free(checkpointFilepath);
+  }
+
   lbc_printf("== Multiplexing summary ===============================================================\n");
   lbc_printf("Muxed: %u packets (", ctx->nbTsPacketsMuxed);
   printBytes(ctx->nbBytesWritten);
@@ -134,13 +480,47 @@ int mainMux(
   }
   lbc_printf(" - System packets : %d packets (%.1f%%).\n", nbSystemPackets, ((float) nbSystemPackets / ctx->nbTsPacketsMuxed) * 100);
 
+  if (dryRun)
+    printDryRunSummary(ctx);
+  if (realtime)
+    printStatsLibbluMuxingPacer(&pacer);
+
+  if (isEnabledLibbluProfiling()) {
+    if (reportLibbluProfiling(ctx->settings.profileFilepath) < 0) {
+      destroyLibbluMuxingContext(ctx);
+      return -1;
+    }
+  }
+
   lbc_printf("=======================================================================================\n");
   destroyLibbluMuxingContext(ctx);
 
   return 0;
 
 free_return:
+  if (NULL != ctx && BUF_MODEL_NO_VIOLATION != ctx->tStdViolation)
+    printBufModelBufferingChain(ctx->tStdModel);
+  if (dryRun && NULL != ctx) {
+    lbc_printf(
+      "\nDry-run failed at STC %" PRIu64 " (%u packets muxed).\n",
+      ctx->currentStcTs,
+      ctx->nbTsPacketsMuxed
+    );
+    if (BUF_MODEL_NO_VIOLATION != ctx->tStdViolation)
+      lbc_printf(
+        "T-STD: First %s in %s at STC %" PRIu64 " (PID 0x%04" PRIX16 ").\n",
+        bufModelViolationStr(ctx->tStdViolation),
+        ctx->tStdViolationPath,
+        ctx->tStdViolationStc,
+        ctx->tStdViolationPid
+      );
+  }
+  stopLibbluProfiling();
+  closeLibbluMuxingTimeline(&timeline);
+  if (NULL != ctx)
+    closeLibbluMuxingTrace(ctx->trace); /* Keep events up to the failure */
   closeBitstreamWriter(output);
   destroyLibbluMuxingContext(ctx);
+  free(checkpointFilepath);
   return -1;
 }
\ No newline at end of file
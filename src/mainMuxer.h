@@ -13,6 +13,9 @@
 #include "util.h"
 #include "muxingSettings.h"
 #include "muxingContext.h"
+#include "muxingCheckpoint.h"
+#include "muxingPacing.h"
+#include "muxingStatistics.h"
 
 /** \~english
  * \brief Multiplexer main function.
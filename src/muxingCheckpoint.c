@@ -0,0 +1,410 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "muxingCheckpoint.h"
+
+lbc * buildFilepathLibbluMuxingCheckpoint(
+  const lbc * outputFilename
+)
+{
+  lbc * filepath;
+
+  assert(NULL != outputFilename);
+
+  if (lbc_asprintf(&filepath, "%" PRI_LBCS LIBBLU_CHECKPOINT_EXT, outputFilename) < 0)
+    LIBBLU_ERROR_NRETURN(
+      "Unable to set checkpoint filename, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+
+  return filepath;
+}
+
+static uint32_t hashValue(
+  uint32_t hash,
+  uint64_t value
+)
+{
+  uint8_t bytes[8];
+  unsigned i;
+
+  /* Hashed in big-endian order, independently from host endianness. */
+  for (i = 0; i < 8; i++)
+    bytes[i] = value >> (56 - 8 * i);
+
+  return fnv1aBufHash(hash, bytes, 8);
+}
+
+static uint32_t hashString(
+  uint32_t hash,
+  const lbc * string
+)
+{
+  size_t length;
+
+  if (NULL == string)
+    return hashValue(hash, 0);
+
+  length = lbc_strlen(string);
+  hash = hashValue(hash, length);
+  return fnv1aBufHash(hash, string, length * sizeof(lbc));
+}
+
+static uint32_t hashESSettingsOptions(
+  uint32_t hash,
+  const LibbluESSettingsOptions * options
+)
+{
+  hash = hashValue(hash, options->dvdMedia);
+  hash = hashValue(hash, options->secondaryStream);
+  hash = hashValue(hash, options->disableFixes);
+  hash = hashValue(hash, options->extractCore);
+  hash = hashString(hash, options->pbrFilepath);
+  hash = hashValue(hash, options->doubleFrameTiming);
+  hash = hashValue(hash, options->fpsChange);
+  hash = hashValue(hash, options->arChange.idc);
+  hash = hashValue(hash, options->arChange.x);
+  hash = hashValue(hash, options->arChange.y);
+  hash = hashValue(hash, options->levelChange);
+  hash = hashValue(hash, options->forceRebuildSei);
+  hash = hashValue(hash, options->discardSei);
+  hash = hashValue(hash, options->disableHrdVerifier);
+
+  return hash;
+}
+
+static uint32_t hashDtcpSettings(
+  uint32_t hash,
+  const LibbluDtcpSettings * dtcp
+)
+{
+  hash = hashValue(hash, dtcp->caSystemId);
+  hash = hashValue(hash, dtcp->retentionMoveMode);
+  hash = hashValue(hash, dtcp->retentionState);
+  hash = hashValue(hash, dtcp->epn);
+  hash = hashValue(hash, dtcp->dtcpCci);
+  hash = hashValue(hash, dtcp->dot);
+  hash = hashValue(hash, dtcp->ast);
+  hash = hashValue(hash, dtcp->imageConstraintToken);
+  hash = hashValue(hash, dtcp->aps);
+
+  return hash;
+}
+
+/** \~english
+ * \brief Hash the whole content of an ESMS script file.
+ */
+static int hashScriptFile(
+  uint32_t * hash,
+  const lbc * filepath
+)
+{
+  uint8_t buffer[4096];
+  size_t size;
+  FILE * file;
+
+  if (NULL == (file = lbc_fopen(filepath, "rb")))
+    LIBBLU_ERROR_RETURN(
+      "Unable to open script file '%" PRI_LBCS "', %s (errno: %d).\n",
+      filepath,
+      strerror(errno),
+      errno
+    );
+
+  while (0 < (size = fread(buffer, 1, sizeof(buffer), file)))
+    *hash = fnv1aBufHash(*hash, buffer, size);
+
+  if (ferror(file)) {
+    fclose(file);
+    LIBBLU_ERROR_RETURN(
+      "Unable to read script file '%" PRI_LBCS "'.\n",
+      filepath
+    );
+  }
+
+  fclose(file);
+  return 0;
+}
+
+int computeSettingsHashLibbluMuxingCheckpoint(
+  uint32_t * dst,
+  const LibbluMuxingContextPtr ctx
+)
+{
+  const LibbluMuxingSettings * settings;
+  const LibbluMuxingOptions * options;
+  uint32_t hash;
+  unsigned i, j;
+
+  assert(NULL != dst);
+  assert(NULL != ctx);
+
+  settings = &ctx->settings;
+  options = &settings->options;
+  hash = FNV1A_32_OFFSET_BASIS;
+
+  /* Multiplex settings */
+  hash = hashValue(hash, settings->targetMuxingRate);
+  hash = hashValue(hash, settings->initialPresentationTime);
+  hash = hashValue(hash, (uint64_t) (settings->initialTStdBufDuration * 1e6));
+  hash = hashValue(hash, settings->pesLookahead);
+  hash = hashDtcpSettings(hash, &settings->dtcpParameters);
+
+  hash = hashValue(hash, options->cbrMuxing);
+  hash = hashValue(hash, options->writeTPExtraHeaders);
+  hash = hashValue(hash, options->pcrOnESPackets);
+  hash = hashValue(hash, options->disableTStdBufVerifier);
+  hash = hashValue(hash, options->pcrPID);
+  hash = hashESSettingsOptions(hash, &options->globalSharedOptions);
+
+  /* Elementary Streams, as resolved by the muxer context */
+  hash = hashValue(hash, nbESLibbluMuxingContext(ctx));
+  for (i = 0; i < nbESLibbluMuxingContext(ctx); i++) {
+    const LibbluStream * stream = ctx->elementaryStreams[i];
+    const LibbluES * es = &stream->es;
+
+    hash = hashValue(hash, stream->pid);
+    hash = hashValue(hash, es->prop.codingType);
+    hash = hashString(hash, es->settings->filepath);
+    hash = hashString(hash, es->settings->scriptFilepath);
+    hash = hashESSettingsOptions(hash, &es->settings->options);
+
+    /* Source files content, identified by CRC-32 values recorded in
+    script. */
+    hash = hashValue(hash, es->sourceFiles.nbUsedFiles);
+    for (j = 0; j < es->sourceFiles.nbUsedFiles; j++) {
+      hash = hashValue(hash, es->sourceFiles.properties[j].crc32);
+      hash = hashValue(hash, es->sourceFiles.properties[j].crcCheckedBytes);
+    }
+
+    if (hashScriptFile(&hash, es->settings->scriptFilepath) < 0)
+      return -1;
+  }
+
+  *dst = hash;
+  return 0;
+}
+
+int saveLibbluMuxingCheckpoint(
+  const lbc * filepath,
+  const LibbluMuxingContextPtr ctx,
+  uint32_t settingsHash,
+  BitstreamWriterPtr output
+)
+{
+  BitstreamWriterPtr file;
+  lbc * tmpFilepath;
+
+  assert(0 == (ctx->nbTsPacketsMuxed % 32));
+
+  /* Checkpoint shall never be ahead of output content. */
+  if (flushBitstreamWriter(output) < 0)
+    return -1;
+
+  /* Written aside then renamed, an interruption shall never leave a
+  truncated checkpoint. */
+  if (lbc_asprintf(&tmpFilepath, "%" PRI_LBCS ".tmp", filepath) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Unable to set checkpoint temporary filename, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+
+  if (NULL == (file = createBitstreamWriter(tmpFilepath, 64))) {
+    free(tmpFilepath);
+    return -1;
+  }
+
+  if (writeBytes(file, (uint8_t *) LIBBLU_CHECKPOINT_MAGIC, 4) < 0)
+    goto free_return;
+  if (writeByte(file, LIBBLU_CHECKPOINT_VERSION) < 0)
+    goto free_return;
+  if (writeUint32(file, settingsHash) < 0)
+    goto free_return;
+  if (writeUint64(file, ctx->settings.targetMuxingRate) < 0)
+    goto free_return;
+  if (writeByte(file, ctx->settings.nbInputStreams) < 0)
+    goto free_return;
+  if (writeUint32(file, ctx->nbTsPacketsMuxed) < 0)
+    goto free_return;
+  if (writeUint64(file, ctx->nbBytesWritten) < 0)
+    goto free_return;
+
+  if (flushBitstreamWriter(file) < 0)
+    goto free_return;
+  closeBitstreamWriter(file);
+
+#if defined(ARCH_WIN32)
+  /* Renaming does not replace an existing file on Windows. */
+  lbc_remove(filepath);
+#endif
+  if (lbc_rename(tmpFilepath, filepath) < 0) {
+    lbc_remove(tmpFilepath);
+    free(tmpFilepath);
+    LIBBLU_ERROR_RETURN(
+      "Unable to write checkpoint file, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+  }
+  free(tmpFilepath);
+
+  LIBBLU_DEBUG_COM(
+    "Checkpoint saved at %u packets (%zu bytes).\n",
+    ctx->nbTsPacketsMuxed,
+    ctx->nbBytesWritten
+  );
+
+  return 0;
+
+free_return:
+  closeBitstreamWriter(file);
+  lbc_remove(tmpFilepath);
+  free(tmpFilepath);
+  LIBBLU_ERROR_RETURN("Unable to write checkpoint file.\n");
+}
+
+int loadLibbluMuxingCheckpoint(
+  LibbluMuxingCheckpoint * dst,
+  const lbc * filepath,
+  uint32_t settingsHash,
+  const LibbluMuxingSettings * settings
+)
+{
+  BitstreamReaderPtr file;
+  uint8_t magic[4], version, nbInputStreams;
+  uint32_t value;
+  int64_t outputSize;
+
+  assert(NULL != dst);
+  assert(NULL != filepath);
+  assert(NULL != settings);
+
+  if (lbc_access_fp(filepath, "rb") < 0)
+    LIBBLU_ERROR_RETURN(
+      "No checkpoint file '%" PRI_LBCS "', no mux to resume.\n",
+      filepath
+    );
+
+  if (NULL == (file = createBitstreamReader(filepath, 64)))
+    return -1;
+
+  if (readBytes(file, magic, 4) < 0)
+    goto free_return;
+  if (0 != memcmp(magic, LIBBLU_CHECKPOINT_MAGIC, 4))
+    goto free_return;
+  if (readByte(file, &version) < 0)
+    goto free_return;
+  if (LIBBLU_CHECKPOINT_VERSION != version) {
+    closeBitstreamReader(file);
+    LIBBLU_ERROR_RETURN(
+      "Unsupported checkpoint file version %u.\n",
+      version
+    );
+  }
+
+  if (readValueBigEndian(file, 4, &dst->settingsHash) < 0)
+    goto free_return;
+  if (readValue64BigEndian(file, 8, &dst->muxingRate) < 0)
+    goto free_return;
+  if (readByte(file, &nbInputStreams) < 0)
+    goto free_return;
+  dst->nbInputStreams = nbInputStreams;
+  if (readValueBigEndian(file, 4, &value) < 0)
+    goto free_return;
+  dst->nbTsPacketsMuxed = value;
+  if (readValue64BigEndian(file, 8, &dst->nbBytesWritten) < 0)
+    goto free_return;
+
+  closeBitstreamReader(file);
+
+  /* Check consistency with resumed mux */
+  if (
+    dst->settingsHash != settingsHash
+    || dst->muxingRate != settings->targetMuxingRate
+    || dst->nbInputStreams != settings->nbInputStreams
+  )
+    LIBBLU_ERROR_RETURN(
+      "Checkpoint does not match current muxing settings, "
+      "unable to resume.\n"
+    );
+
+  if (getFileSize(settings->outputTsFilename, &outputSize) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Unable to get output file '%" PRI_LBCS "' size.\n",
+      settings->outputTsFilename
+    );
+  if ((uint64_t) outputSize < dst->nbBytesWritten)
+    LIBBLU_ERROR_RETURN(
+      "Output file is shorter than checkpoint (%" PRIu64 " bytes, "
+      "expect at least %" PRIu64 " bytes), unable to resume.\n",
+      (uint64_t) outputSize,
+      dst->nbBytesWritten
+    );
+
+  return 0;
+
+free_return:
+  closeBitstreamReader(file);
+  LIBBLU_ERROR_RETURN("Broken checkpoint file, unable to resume.\n");
+}
+
+static void setSkipPayloadReads(
+  LibbluMuxingContextPtr ctx,
+  bool skip
+)
+{
+  unsigned i;
+
+  for (i = 0; i < nbESLibbluMuxingContext(ctx); i++)
+    ctx->elementaryStreams[i]->es.skipPayloadReads = skip;
+}
+
+int replayLibbluMuxingCheckpoint(
+  LibbluMuxingContextPtr ctx,
+  const LibbluMuxingCheckpoint * checkpoint
+)
+{
+  BitstreamWriterPtr output;
+  unsigned i;
+
+  assert(NULL != ctx);
+  assert(NULL != checkpoint);
+
+  if (NULL == (output = createNullBitstreamWriter(IO_VBUF_SIZE)))
+    return -1;
+
+  setSkipPayloadReads(ctx, true);
+  while (ctx->nbTsPacketsMuxed < checkpoint->nbTsPacketsMuxed) {
+    if (!dataRemainingLibbluMuxingContext(ctx))
+      LIBBLU_ERROR_FRETURN("Unexpected end of data while resuming.\n");
+    if (muxNextPacketLibbluMuxingContext(ctx, output) < 0)
+      goto free_return;
+  }
+  setSkipPayloadReads(ctx, false);
+
+  if (ctx->nbBytesWritten != checkpoint->nbBytesWritten)
+    LIBBLU_ERROR_FRETURN(
+      "Replayed mux does not match checkpoint, unable to resume.\n"
+    );
+
+  /* Restore payloads of partially muxed PES packets */
+  for (i = 0; i < nbESLibbluMuxingContext(ctx); i++) {
+    if (reloadCurrentPesPacketDataLibbluES(&ctx->elementaryStreams[i]->es) < 0)
+      goto free_return;
+  }
+
+  closeBitstreamWriter(output);
+  return 0;
+
+free_return:
+  closeBitstreamWriter(output);
+  return -1;
+}
@@ -0,0 +1,149 @@
+/** \~english
+ * \file muxingCheckpoint.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Muxing checkpoints module.
+ *
+ * A checkpoint records the progression of a mux at a BDAV "Aligned unit"
+ * boundary in a sidecar file next to the output. Since muxing is
+ * deterministic, an interrupted mux is resumed by replaying the muxer
+ * decisions up to the checkpoint without reading payloads nor writing data,
+ * then by writing the following packets from the checkpoint offset.
+ */
+
+#ifndef __LIBBLU_MUXER__MUXING_CHECKPOINT_H__
+#define __LIBBLU_MUXER__MUXING_CHECKPOINT_H__
+
+#include "util.h"
+#include "muxingSettings.h"
+#include "muxingContext.h"
+
+#define LIBBLU_CHECKPOINT_MAGIC  "LBCK"
+#define LIBBLU_CHECKPOINT_VERSION  2
+
+/** \~english
+ * \brief Checkpoint sidecar filename extension, appended to the output
+ * filename.
+ */
+#define LIBBLU_CHECKPOINT_EXT  ".ckpt"
+
+/** \~english
+ * \brief Minimal number of transport packets between two checkpoints.
+ *
+ * Shall be a multiple of the BDAV "Aligned unit" size (32 packets).
+ */
+#define LIBBLU_CHECKPOINT_INTERVAL  (32 * 4096)
+
+typedef struct {
+  uint32_t settingsHash;      /**< Muxing settings fingerprint.             */
+  uint64_t muxingRate;        /**< Multiplex rate in bits per second.       */
+  unsigned nbInputStreams;    /**< Number of muxed Elementary Streams.      */
+  unsigned nbTsPacketsMuxed;  /**< Number of transport packets muxed.       */
+  uint64_t nbBytesWritten;    /**< Output length in bytes.                  */
+} LibbluMuxingCheckpoint;
+
+/** \~english
+ * \brief Return the checkpoint sidecar filepath associated with supplied
+ * output filename.
+ *
+ * \param outputFilename Mux output filename.
+ * \return lbc* Upon success, the allocated filepath is returned (to be
+ * released after use). Otherwise, a NULL pointer is returned.
+ */
+lbc * buildFilepathLibbluMuxingCheckpoint(
+  const lbc * outputFilename
+);
+
+/** \~english
+ * \brief Return true if a checkpoint shall be saved at the current muxing
+ * state.
+ *
+ * \param ctx Muxer context.
+ * \param lastNbTsPackets Number of transport packets muxed at the last
+ * checkpoint.
+ */
+static inline bool isDueLibbluMuxingCheckpoint(
+  const LibbluMuxingContextPtr ctx,
+  unsigned lastNbTsPackets
+)
+{
+  return
+    0 == (ctx->nbTsPacketsMuxed % 32)
+    && LIBBLU_CHECKPOINT_INTERVAL <= ctx->nbTsPacketsMuxed - lastNbTsPackets
+  ;
+}
+
+/** \~english
+ * \brief Compute the fingerprint of the settings defining the muxing
+ * decisions.
+ *
+ * \param dst Destination fingerprint.
+ * \param ctx Freshly created muxer context.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Covers resolved multiplex and Elementary Streams settings (PIDs, coding
+ * types, options), source files CRC-32 values and the content of the ESMS
+ * scripts. Used to prevent resuming a mux using different inputs.
+ */
+int computeSettingsHashLibbluMuxingCheckpoint(
+  uint32_t * dst,
+  const LibbluMuxingContextPtr ctx
+);
+
+/** \~english
+ * \brief Save the current muxing state checkpoint.
+ *
+ * \param filepath Checkpoint sidecar filepath.
+ * \param ctx Muxer context.
+ * \param settingsHash Muxing settings fingerprint.
+ * \param output Mux output, flushed prior to the checkpoint writing.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int saveLibbluMuxingCheckpoint(
+  const lbc * filepath,
+  const LibbluMuxingContextPtr ctx,
+  uint32_t settingsHash,
+  BitstreamWriterPtr output
+);
+
+/** \~english
+ * \brief Load and check a checkpoint against supplied settings.
+ *
+ * \param dst Destination checkpoint.
+ * \param filepath Checkpoint sidecar filepath.
+ * \param settingsHash Fingerprint of the resumed mux settings.
+ * \param settings Settings of the resumed mux.
+ * \return int Upon success, a zero value is returned. Otherwise, if the
+ * checkpoint is missing, broken or does not match supplied settings and
+ * output file, a negative value is returned.
+ */
+int loadLibbluMuxingCheckpoint(
+  LibbluMuxingCheckpoint * dst,
+  const lbc * filepath,
+  uint32_t settingsHash,
+  const LibbluMuxingSettings * settings
+);
+
+/** \~english
+ * \brief Replay the mux up to supplied checkpoint.
+ *
+ * \param ctx Freshly created muxer context.
+ * \param checkpoint Reached checkpoint.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Payloads are not read and muxed packets are discarded, current PES
+ * packets data of each Elementary Stream is then reloaded. On success,
+ * the mux can be continued on an output placed at checkpoint
+ * 'nbBytesWritten' offset.
+ */
+int replayLibbluMuxingCheckpoint(
+  LibbluMuxingContextPtr ctx,
+  const LibbluMuxingCheckpoint * checkpoint
+);
+
+#endif
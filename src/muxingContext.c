@@ -424,6 +424,38 @@ static bool isSharedUsedScript(
   return false;
 }
 
+/** \~english
+ * \brief Return the already registered ES sharing the same script as
+ * supplied one, if any.
+ *
+ * Scripts are shared between ES using the same source file with the same
+ * stream coding type and script flags.
+ */
+static LibbluESSettings * findSharingESScript(
+  const LibbluESSettings * settings,
+  LibbluESSettings * alreadyRegisteredES,
+  unsigned alreadyRegisteredESNb
+)
+{
+  uint64_t scriptFlags;
+  unsigned i;
+
+  scriptFlags = computeFlagsLibbluESSettingsOptions(settings->options);
+
+  for (i = 0; i < alreadyRegisteredESNb; i++) {
+    LibbluESSettings * regES = alreadyRegisteredES + i;
+
+    if (
+      lbc_equal(settings->filepath, regES->filepath)
+      && settings->codingType == regES->codingType
+      && scriptFlags == computeFlagsLibbluESSettingsOptions(regES->options)
+    )
+      return regES;
+  }
+
+  return NULL;
+}
+
 static int findValidESScript(
   LibbluESSettings * settings,
   LibbluESSettings * ardyRegES,
@@ -431,12 +463,23 @@ static int findValidESScript(
 )
 {
   lbc scriptFilepath[PATH_BUFSIZE];
+  LibbluESSettings * sharingES;
   uint64_t scriptFlags;
   unsigned increment;
   int fpSize;
 
   increment = 0;
 
+  if (NULL == settings->scriptFilepath) {
+    /* Identical inputs share a single script, generated once. */
+    sharingES = findSharingESScript(settings, ardyRegES, ardyRegESNb);
+    if (NULL != sharingES) {
+      if (NULL == (settings->scriptFilepath = lbc_strdup(sharingES->scriptFilepath)))
+        LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+      return 0;
+    }
+  }
+
   if (NULL != settings->scriptFilepath)
     fpSize = lbc_snprintf(
       scriptFilepath,
@@ -509,6 +552,7 @@ LibbluMuxingContextPtr createLibbluMuxingContext(
 
   bool tStdBufModelEnabled;
   bool forcedScriptBuilding;
+  bool generatedScripts[LIBBLU_MAX_NB_STREAMS];
 
   LibbluStreamPtr stream;
 
@@ -545,6 +589,19 @@ LibbluMuxingContextPtr createLibbluMuxingContext(
   ctx->null = NULL;
   ctx->nbTsPacketsMuxed = 0;
   ctx->nbBytesWritten = 0;
+  ctx->nbTStdDelayedPackets = 0;
+  ctx->firstTStdDelayStc = 0;
+  ctx->firstTStdDelayPid = 0;
+  ctx->tStdViolation = BUF_MODEL_NO_VIOLATION;
+  ctx->tStdViolationPath[0] = '\0';
+  ctx->tStdViolationStc = 0;
+  ctx->tStdViolationPid = 0;
+  ctx->trace = NULL;
+  ctx->nbPcrInjected = 0;
+  ctx->lastPcrStc = 0;
+  ctx->pcrIntervalMin = 0;
+  ctx->pcrIntervalMax = 0;
+  ctx->pcrIntervalSum = 0;
   ctx->progress = 0;
   ctx->tStdModel = BUF_MODEL_NEW_NODE();
   ctx->tStdSystemBuffersList = NULL;
@@ -581,29 +638,53 @@ LibbluMuxingContextPtr createLibbluMuxingContext(
       goto free_return;
   }
 
+  LIBBLU_DEBUG_COM("Check Elementary Streams script filepaths.\n");
+  for (i = 0; i < ctx->settings.nbInputStreams; i++) {
+    /* Find/check script filename */
+    LIBBLU_DEBUG_COM(" Check script filepath.\n");
+    if (findValidESScript(ctx->settings.inputStreams + i, ctx->settings.inputStreams, i) < 0)
+      goto free_return;
+  }
+
+  /* Analyze graphic streams concurrently */
+  LIBBLU_DEBUG_COM("Generation of graphic streams scripts.\n");
+  ret = generateGraphicScriptsLibbluES(
+    ctx->settings.inputStreams,
+    ctx->settings.nbInputStreams,
+    forcedScriptBuilding,
+    generatedScripts
+  );
+  if (ret < 0)
+    goto free_return;
+
   LIBBLU_DEBUG_COM("Initialization of Elementary Streams.\n");
   for (i = 0; i < ctx->settings.nbInputStreams; i++) {
     LibbluESSettings * esSettings;
+    bool forcedRebuild;
     uint16_t pid;
 
     LibbluESFormatUtilities utilities;
 
     esSettings = ctx->settings.inputStreams + i;
 
-    /* Find/check script filename */
-    LIBBLU_DEBUG_COM(" Check script filepath.\n");
-    if (findValidESScript(esSettings, ctx->settings.inputStreams, i) < 0)
-      goto free_return;
-
     LIBBLU_DEBUG_COM(" Creation of the Elementary Stream handle.\n");
     stream = createElementaryLibbluStream(esSettings);
     if (NULL == stream)
       goto free_return;
     ctx->elementaryStreams[i] = stream;
+    setPesPacketsLookaheadLibbluES(&stream->es, ctx->settings.pesLookahead);
+    stream->es.skipPayloadReads = ctx->settings.options.dryRun;
 
     /* Prepare the ES */
     LIBBLU_DEBUG_COM(" Preparation of the Elementary Stream handle.\n");
-    if (prepareLibbluES(&stream->es, &utilities, forcedScriptBuilding) < 0)
+    /* Forced rebuilding of a shared script is done once by its first
+    user. */
+    forcedRebuild = (
+      forcedScriptBuilding
+      && !generatedScripts[i]
+      && !isSharedUsedScript(esSettings->scriptFilepath, ctx->settings.inputStreams, i)
+    );
+    if (prepareLibbluES(&stream->es, &utilities, forcedRebuild) < 0)
       goto free_return;
 
     /* Choose and set stream PID value */
@@ -785,13 +866,85 @@ static bool checkBufferingModelAvailability(
   size_t size
 )
 {
-  return checkBufModel(
+  bool available;
+
+  LIBBLU_PROFILE_START(profTimer);
+  available = checkBufModel(
     ctx->tStdModel,
     ctx->currentStcTs,
     size * 8,
     ctx->settings.targetMuxingRate,
     stream
   );
+  LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_T_STD);
+
+  return available;
+}
+
+static void registerTStdDelayLibbluMuxingContext(
+  LibbluMuxingContextPtr ctx,
+  LibbluStreamPtr stream
+)
+{
+  if (!ctx->nbTStdDelayedPackets) {
+    ctx->firstTStdDelayStc = ctx->currentStcTs;
+    ctx->firstTStdDelayPid = stream->pid;
+  }
+  ctx->nbTStdDelayedPackets++;
+}
+
+/** \~english
+ * \brief Record a muxer decision in the trace, if enabled.
+ */
+static int traceEventLibbluMuxingContext(
+  LibbluMuxingContextPtr ctx,
+  LibbluMuxingTraceEventType type,
+  LibbluStreamPtr stream,
+  uint64_t tsPt,
+  bool pcr
+)
+{
+  LibbluMuxingTraceEvent event;
+  BufModelBuffersListPtr buffers;
+  unsigned i;
+
+  if (NULL == ctx->trace)
+    return 0;
+
+  event = (LibbluMuxingTraceEvent) {
+    .type = type,
+    .flags = (pcr) ? LIBBLU_TRACE_FLAG_PCR : 0,
+    .pid = stream->pid,
+    .packetIdx = ctx->nbTsPacketsMuxed,
+    .stc = ctx->currentStcTs,
+    .tsPt = tsPt
+  };
+
+  if (isESLibbluStream(stream))
+    buffers = stream->es.lnkdBufList;
+  else
+    buffers = ctx->tStdSystemBuffersList;
+
+  for (i = 0; NULL != buffers && i < MIN(2, buffers->nbUsedBuffers); i++)
+    event.levels[i] = buffers->buffers[i]->header.bufferFillingLevel;
+
+  return recordLibbluMuxingTrace(ctx->trace, event);
+}
+
+static void registerPcrLibbluMuxingContext(
+  LibbluMuxingContextPtr ctx
+)
+{
+  if (0 < ctx->nbPcrInjected) {
+    uint64_t interval = ctx->currentStcTs - ctx->lastPcrStc;
+
+    if (1 == ctx->nbPcrInjected || interval < ctx->pcrIntervalMin)
+      ctx->pcrIntervalMin = interval;
+    ctx->pcrIntervalMax = MAX(ctx->pcrIntervalMax, interval);
+    ctx->pcrIntervalSum += interval;
+  }
+  ctx->lastPcrStc = ctx->currentStcTs;
+  ctx->nbPcrInjected++;
 }
 
 int putDataToBufferingModel(
@@ -807,6 +960,7 @@ int putDataToBufferingModel(
     size, stream->pid, ctx->currentStcTs
   );
 
+  LIBBLU_PROFILE_START(profTimer);
   ret = updateBufModel(
     ctx->tStdModel,
     ctx->currentStcTs,
@@ -814,6 +968,7 @@ int putDataToBufferingModel(
     ctx->settings.targetMuxingRate,
     stream
   );
+  LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_T_STD);
   if (ret < 0) {
     /* Error case */
     LIBBLU_ERROR(
@@ -822,7 +977,18 @@ int putDataToBufferingModel(
       stream->pid,
       ctx->currentStcTs
     );
-    printBufModelBufferingChain(ctx->tStdModel);
+
+    /* Keep the violation, if any, apart from other update errors. The
+    caller reports it (and prints the buffering chain if relevant). */
+    if (
+      findViolationBufModelBufferingChain(
+        ctx->tStdModel, &ctx->tStdViolation,
+        ctx->tStdViolationPath, STR_BUFSIZE
+      ) < 0
+    )
+      return -1;
+    ctx->tStdViolationStc = ctx->currentStcTs;
+    ctx->tStdViolationPid = stream->pid;
   }
 
   return ret;
@@ -897,6 +1063,8 @@ static int muxNextSystemStreamPacket(
         injectedPacket = checkBufferingModelAvailability(
           ctx, tpStream, TP_SIZE
         );
+        if (!injectedPacket)
+          registerTStdDelayLibbluMuxingContext(ctx, tpStream);
       }
     }
 
@@ -931,6 +1099,9 @@ static int muxNextSystemStreamPacket(
       if (ret < 0)
         return -1;
 
+      if (pcrPresence)
+        registerPcrLibbluMuxingContext(ctx);
+
       LIBBLU_DEBUG(
         LIBBLU_DEBUG_MUXER_DECISION, "Muxer decisions",
         "0x%" PRIX64 " - %" PRIu64 ", Sys packet muxed (0x%04" PRIX16 ").\n",
@@ -961,6 +1132,12 @@ static int muxNextSystemStreamPacket(
           return -1;
       }
 
+      ret = traceEventLibbluMuxingContext(
+        ctx, LIBBLU_TRACE_SYS_PACKET, tpStream, tpTimeData.tsPt, pcrPresence
+      );
+      if (ret < 0)
+        return -1;
+
       if (tpStream->sys.firstFullTableSupplied) {
         /* Increment the timestamp only after the table has been fully
         emitted once. */
@@ -1010,12 +1187,19 @@ static int muxNextESPacket(
       if (!checkBufferingModelAvailability(ctx, tpStream, TP_SIZE)) {
         /* ES tp insertion leads to overflow, increase its timestamp and try
         with another ES. */
+        registerTStdDelayLibbluMuxingContext(ctx, tpStream);
 
         LIBBLU_T_STD_VERIF_TEST_DEBUG(
           "Skipping injection PID 0x%04" PRIX16 " at %" PRIi64 ".\n",
           tpStream->pid,
           ctx->currentStcTs
         );
+
+        ret = traceEventLibbluMuxingContext(
+          ctx, LIBBLU_TRACE_ES_DELAYED, tpStream, tpTimeData.tsPt, false
+        );
+        if (ret < 0)
+          return -1;
         /* printf("%" PRIu64 "\n", tpTimeData.tsPt); */
 
         /* printBufModelBufferingChain(ctx->tStdModel); */
@@ -1059,6 +1243,9 @@ static int muxNextESPacket(
   if (ret < 0)
     return -1;
 
+  if (pcrInjection)
+    registerPcrLibbluMuxingContext(ctx);
+
   LIBBLU_DEBUG(
     LIBBLU_DEBUG_MUXER_DECISION, "Muxer decisions",
     "0x%" PRIX64 " - %" PRIu64 ", ES packet muxed "
@@ -1096,6 +1283,12 @@ static int muxNextESPacket(
       return -1;
   }
 
+  ret = traceEventLibbluMuxingContext(
+    ctx, LIBBLU_TRACE_ES_PACKET, tpStream, tpTimeData.tsPt, pcrInjection
+  );
+  if (ret < 0)
+    return -1;
+
   /* Check remaining data in processed PES packet : */
   if (0 == remainingPesDataLibbluES(tpStream->es)) {
     /* If no more data, build new PES packet */
@@ -1144,6 +1337,12 @@ static int muxNextESPacket(
       tpTimeData.pesTsNb,
       tpTimeData.tsPt
     );
+
+    ret = traceEventLibbluMuxingContext(
+      ctx, LIBBLU_TRACE_PES_BUILT, tpStream, tpTimeData.tsPt, false
+    );
+    if (ret < 0)
+      return -1;
   }
   else {
 #if 1
@@ -1196,6 +1395,9 @@ static int muxNullPacket(
   ctx->nbTsPacketsMuxed++;
   ctx->nbBytesWritten += TP_SIZE;
 
+  if (traceEventLibbluMuxingContext(ctx, LIBBLU_TRACE_NULL_PACKET, ctx->null, 0, false) < 0)
+    return -1;
+
   return 0;
 }
 
@@ -26,6 +26,7 @@
 #include "codecsUtilities.h"
 #include "tsPackets.h"
 #include "tStdVerifier/bdavStd.h"
+#include "muxingTrace.h"
 
 #define SHIFT_PACKETS_BEFORE_DTS true
 #define USE_AVERAGE_PES_SIZE false
@@ -83,8 +84,32 @@ typedef struct {
   size_t nbBytesWritten;
   double progress;            /**< Progression state between 0 and 1.        */
 
+  /* Buffering model statistics */
+  unsigned nbTStdDelayedPackets;  /**< Number of transport packets injections
+    delayed to avoid a buffering model overflow.                             */
+  uint64_t firstTStdDelayStc;     /**< STC value of the first delayed
+    injection.                                                               */
+  uint16_t firstTStdDelayPid;     /**< PID of the first delayed injection.   */
+  BufModelViolation tStdViolation;  /**< Buffering model violation which
+    stopped the mux, if any. Set on #putDataToBufferingModel() failure.      */
+  char tStdViolationPath[STR_BUFSIZE];  /**< Violated buffer path in the
+    buffering model chain.                                                   */
+  uint64_t tStdViolationStc;      /**< STC value of the violation.           */
+  uint16_t tStdViolationPid;      /**< PID of the injection which caused the
+    violation.                                                               */
+
+  /* PCR statistics, intervals in #MAIN_CLOCK_27MHZ ticks */
+  unsigned nbPcrInjected;         /**< Number of PCR values written.         */
+  uint64_t lastPcrStc;            /**< STC value of the last PCR.            */
+  uint64_t pcrIntervalMin;        /**< Shortest interval between two PCR.    */
+  uint64_t pcrIntervalMax;        /**< Longest interval between two PCR.     */
+  uint64_t pcrIntervalSum;        /**< Sum of intervals between PCR.         */
+
   BufModelNode tStdModel;
   BufModelBuffersListPtr tStdSystemBuffersList;
+
+  LibbluMuxingTracePtr trace;  /**< Muxer decisions trace, if not NULL. Not
+    owned by the context.                                                    */
 } LibbluMuxingContext, *LibbluMuxingContextPtr;
 
 /** \~english
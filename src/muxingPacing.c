@@ -0,0 +1,149 @@
+#if defined(__linux__)
+   /* Required for clock_nanosleep() */
+#  define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#include "muxingPacing.h"
+
+#if defined(ARCH_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#endif
+
+/** \~english
+ * \brief Sleep until supplied monotonic wall-clock time in seconds.
+ *
+ * An absolute deadline is used to avoid accumulating wake-up delays.
+ */
+static int sleepUntil(
+  double deadline
+)
+{
+#if defined(ARCH_WIN32)
+  double now;
+
+  if (lb_get_monotonic_time(&now) < 0)
+    return -1;
+  if (now < deadline)
+    Sleep((DWORD) ((deadline - now) * 1000));
+#else
+  struct timespec ts;
+  int ret;
+
+  ts.tv_sec = (time_t) deadline;
+  ts.tv_nsec = (long) ((deadline - ts.tv_sec) * 1e9);
+
+  do {
+    ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+  } while (EINTR == ret);
+
+  if (0 != ret)
+    LIBBLU_ERROR_RETURN(
+      "Unable to wait for the next emission, %s (errno: %d).\n",
+      strerror(ret),
+      ret
+    );
+#endif
+
+  return 0;
+}
+
+int initLibbluMuxingPacer(
+  LibbluMuxingPacer * dst,
+  const LibbluMuxingContextPtr ctx
+)
+{
+  assert(NULL != dst);
+  assert(NULL != ctx);
+
+  *dst = (LibbluMuxingPacer) {
+    .startStc = ctx->currentStc,
+    .lastNbTsPackets = ctx->nbTsPacketsMuxed
+  };
+
+  return lb_get_monotonic_time(&dst->startTime);
+}
+
+int paceLibbluMuxingPacer(
+  LibbluMuxingPacer * pacer,
+  const LibbluMuxingContextPtr ctx,
+  BitstreamWriterPtr output
+)
+{
+  double deadline, now, jitter;
+
+  assert(isDueLibbluMuxingPacer(pacer, ctx));
+
+  deadline =
+    pacer->startTime
+    + (ctx->currentStc - pacer->startStc) / MAIN_CLOCK_27MHZ
+  ;
+
+  if (sleepUntil(deadline) < 0)
+    return -1;
+
+  if (flushBitstreamWriter(output) < 0)
+    return -1;
+  if (NULL != output->file && EOF == fflush(output->file))
+    LIBBLU_ERROR_RETURN(
+      "Error happen during output file writing, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+
+  if (lb_get_monotonic_time(&now) < 0)
+    return -1;
+
+  /* Update jitter statistics */
+  jitter = MAX(0, now - deadline) * 1e6;
+  pacer->sumJitter += jitter;
+  pacer->sumSqJitter += jitter * jitter;
+  pacer->maxJitter = MAX(pacer->maxJitter, jitter);
+  if (LIBBLU_PACING_LATE_THRESHOLD < jitter)
+    pacer->nbLateUnits++;
+  pacer->nbUnits++;
+
+  pacer->lastNbTsPackets = ctx->nbTsPacketsMuxed;
+  return 0;
+}
+
+void printStatsLibbluMuxingPacer(
+  const LibbluMuxingPacer * pacer
+)
+{
+  double mean, variance;
+
+  if (0 == pacer->nbUnits) {
+    lbc_printf("Real-time pacing: No aligned unit emitted.\n");
+    return;
+  }
+
+  mean = pacer->sumJitter / pacer->nbUnits;
+  variance = pacer->sumSqJitter / pacer->nbUnits - mean * mean;
+
+  lbc_printf(
+    "Real-time pacing: %u aligned units, emission jitter mean %.1f us, "
+    "std dev %.1f us, max %.1f us.\n",
+    pacer->nbUnits,
+    mean,
+    sqrt(MAX(0, variance)),
+    pacer->maxJitter
+  );
+  lbc_printf(
+    " - Late units (> %u us): %u (%.1f%%).\n",
+    LIBBLU_PACING_LATE_THRESHOLD,
+    pacer->nbLateUnits,
+    ((float) pacer->nbLateUnits / pacer->nbUnits) * 100
+  );
+}
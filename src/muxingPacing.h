@@ -0,0 +1,102 @@
+/** \~english
+ * \file muxingPacing.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Real-time muxing output pacing module.
+ *
+ * In real-time mode, each BDAV "Aligned unit" is written to the output
+ * when the wall-clock time reaches the System Time Clock value of its last
+ * transport packet, the transport stream being so delivered at multiplex
+ * rate (e.g. to a player or an analyser reading a FIFO or a pipe).
+ * Emission jitter (delay between the scheduled time and the effective
+ * writing) is measured for each unit.
+ */
+
+#ifndef __LIBBLU_MUXER__MUXING_PACING_H__
+#define __LIBBLU_MUXER__MUXING_PACING_H__
+
+#include "util.h"
+#include "muxingContext.h"
+
+/** \~english
+ * \brief Emission delay above which an aligned unit is counted as late,
+ * in microseconds.
+ */
+#define LIBBLU_PACING_LATE_THRESHOLD  1000
+
+typedef struct {
+  double startTime;         /**< Wall-clock time of the pacing start, in
+    seconds.                                                                 */
+  double startStc;          /**< STC value at the pacing start, in
+    #MAIN_CLOCK_27MHZ ticks.                                                 */
+  unsigned lastNbTsPackets; /**< Number of transport packets muxed at the
+    last emission.                                                           */
+
+  /* Jitter statistics, in microseconds */
+  unsigned nbUnits;         /**< Number of emitted aligned units.            */
+  unsigned nbLateUnits;     /**< Number of units emitted later than
+    #LIBBLU_PACING_LATE_THRESHOLD.                                           */
+  double sumJitter;
+  double sumSqJitter;
+  double maxJitter;
+} LibbluMuxingPacer;
+
+/** \~english
+ * \brief Start pacing from the current muxing state.
+ *
+ * \param dst Pacer to initialize.
+ * \param ctx Muxer context.
+ * \return int Upon success, a zero value is returned. Otherwise, if no
+ * suitable clock is available, a negative value is returned.
+ */
+int initLibbluMuxingPacer(
+  LibbluMuxingPacer * dst,
+  const LibbluMuxingContextPtr ctx
+);
+
+/** \~english
+ * \brief Return true if an aligned unit has been completed since the last
+ * emission and shall be paced.
+ *
+ * \param pacer Pacer.
+ * \param ctx Muxer context.
+ */
+static inline bool isDueLibbluMuxingPacer(
+  const LibbluMuxingPacer * pacer,
+  const LibbluMuxingContextPtr ctx
+)
+{
+  return
+    0 == (ctx->nbTsPacketsMuxed % 32)
+    && pacer->lastNbTsPackets != ctx->nbTsPacketsMuxed
+  ;
+}
+
+/** \~english
+ * \brief Wait for the scheduled time of the completed aligned unit and
+ * write it.
+ *
+ * \param pacer Pacer.
+ * \param ctx Muxer context.
+ * \param output Mux output, flushed down to the output file.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int paceLibbluMuxingPacer(
+  LibbluMuxingPacer * pacer,
+  const LibbluMuxingContextPtr ctx,
+  BitstreamWriterPtr output
+);
+
+/** \~english
+ * \brief Print emission jitter statistics.
+ *
+ * \param pacer Pacer.
+ */
+void printStatsLibbluMuxingPacer(
+  const LibbluMuxingPacer * pacer
+);
+
+#endif
@@ -19,16 +19,151 @@ int initLibbluMuxingSettings(
 
   if (NULL == (dst->outputTsFilename = lbc_strdup(outputTsFilename)))
     LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  dst->outputStream = NULL;
+  dst->statsFilepath = NULL;
+  dst->timelineFilepath = NULL;
+  dst->traceFilepath = NULL;
+  dst->profileFilepath = NULL;
 
   dst->nbInputStreams = 0;
 
   dst->targetMuxingRate = LIBBLU_DEFAULT_MUXING_RATE;
   dst->initialPresentationTime = LIBBLU_DEFAULT_INIT_PRES_TIME;
   dst->initialTStdBufDuration = LIBBLU_DEFAULT_INIT_TSTD_DUR;
+  dst->pesLookahead = LIBBLU_DEFAULT_PES_LOOKAHEAD;
 
   setHdmvDefaultUnencryptedLibbluDtcpSettings(&dst->dtcpParameters);
 
   defaultLibbluMuxingOptions(&dst->options, confHandle);
 
   return 0;
-}
\ No newline at end of file
+}
+
+static int copyOptionalFilepath(
+  lbc ** dst,
+  const lbc * src
+)
+{
+  if (NULL != src) {
+    if (NULL == (*dst = lbc_strdup(src)))
+      LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  }
+  return 0;
+}
+
+int copyLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const LibbluMuxingSettings * src
+)
+{
+  unsigned i;
+
+  assert(NULL != dst);
+  assert(NULL != src);
+
+  *dst = *src;
+  dst->nbInputStreams = 0;
+  dst->statsFilepath = NULL;
+  dst->timelineFilepath = NULL;
+  dst->traceFilepath = NULL;
+  dst->profileFilepath = NULL;
+
+  if (NULL == (dst->outputTsFilename = lbc_strdup(src->outputTsFilename)))
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  dst->outputStream = NULL; /* Output stream is not shared */
+
+  if (copyOptionalFilepath(&dst->statsFilepath, src->statsFilepath) < 0)
+    goto free_return;
+  if (copyOptionalFilepath(&dst->timelineFilepath, src->timelineFilepath) < 0)
+    goto free_return;
+  if (copyOptionalFilepath(&dst->traceFilepath, src->traceFilepath) < 0)
+    goto free_return;
+  if (copyOptionalFilepath(&dst->profileFilepath, src->profileFilepath) < 0)
+    goto free_return;
+
+  for (i = 0; i < src->nbInputStreams; i++) {
+    if (copyLibbluESSettings(dst->inputStreams + i, src->inputStreams + i) < 0)
+      goto free_return;
+    dst->nbInputStreams++;
+  }
+
+  return 0;
+
+free_return:
+  cleanLibbluMuxingSettings(*dst);
+  return -1;
+}
+static int setReportFilepath(
+  lbc ** dst,
+  const lbc * filepath,
+  const lbc * outputTsFilename,
+  const lbc * defaultExt
+)
+{
+  lbc * copy;
+
+  if (NULL != filepath)
+    copy = lbc_strdup(filepath);
+  else {
+    if (lbc_asprintf(&copy, "%" PRI_LBCS "%" PRI_LBCS, outputTsFilename, defaultExt) < 0)
+      copy = NULL;
+  }
+  if (NULL == copy)
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+
+  free(*dst);
+  *dst = copy;
+  return 0;
+}
+
+int setStatsFilepathLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const lbc * filepath
+)
+{
+  return setReportFilepath(
+    &dst->statsFilepath,
+    filepath,
+    dst->outputTsFilename,
+    LIBBLU_DEFAULT_STATS_EXT
+  );
+}
+
+int setTimelineFilepathLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const lbc * filepath
+)
+{
+  return setReportFilepath(
+    &dst->timelineFilepath,
+    filepath,
+    dst->outputTsFilename,
+    LIBBLU_DEFAULT_TIMELINE_EXT
+  );
+}
+
+int setTraceFilepathLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const lbc * filepath
+)
+{
+  return setReportFilepath(
+    &dst->traceFilepath,
+    filepath,
+    dst->outputTsFilename,
+    LIBBLU_DEFAULT_TRACE_EXT
+  );
+}
+
+int setProfileFilepathLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const lbc * filepath
+)
+{
+  return setReportFilepath(
+    &dst->profileFilepath,
+    filepath,
+    dst->outputTsFilename,
+    LIBBLU_DEFAULT_PROFILE_EXT
+  );
+}
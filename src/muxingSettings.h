@@ -19,6 +19,12 @@
 
 typedef struct {
   bool forceRebuildScripts;
+  bool dryRun;  /**< Simulation only mux, no output is written.            */
+  bool autoMuxRate;  /**< Search the lowest BDAV-STD compliant multiplex
+    rate (not exceeding the supplied one) prior to muxing.                   */
+  bool resume;  /**< Resume an interrupted mux from its checkpoint.        */
+  bool realtime;  /**< Pace output writing to wall-clock time at multiplex
+    rate.                                                                    */
   bool cbrMuxing;
   bool writeTPExtraHeaders;
   bool pcrOnESPackets;
@@ -35,6 +41,10 @@ static inline void defaultLibbluMuxingOptions(
 )
 {
   dst->forceRebuildScripts = false;
+  dst->dryRun = false;
+  dst->autoMuxRate = false;
+  dst->resume = false;
+  dst->realtime = false;
   dst->cbrMuxing = false;
   dst->writeTPExtraHeaders = true;
   dst->pcrOnESPackets = false;
@@ -47,18 +57,71 @@ static inline void defaultLibbluMuxingOptions(
 
 #define LIBBLU_DEFAULT_OUTPUT_TS_FILENAME  lbc_str("out.m2ts")
 
+/** \~english
+ * \brief Output filename used to write the transport stream on standard
+ * output.
+ */
+#define LIBBLU_STDOUT_OUTPUT_FILENAME  lbc_str("-")
+
 #define LIBBLU_MIN_MUXING_RATE  500000
 #define LIBBLU_MAX_MUXING_RATE  120000000
 #define LIBBLU_DEFAULT_MUXING_RATE  48000000
 
+/** \~english
+ * \brief Automatic multiplex rate search precision in bits per second.
+ *
+ * Search stops when the interval between the highest non-compliant and the
+ * lowest compliant rates falls below this value.
+ */
+#define LIBBLU_AUTO_MUXING_RATE_PRECISION  50000
+
 #define LIBBLU_MIN_INIT_PRES_TIME  SUB_CLOCK_90KHZ
 #define LIBBLU_MAX_INIT_PRES_TIME  ((uint64_t) SUB_CLOCK_90KHZ * 60 * 60 * 5000)
 #define LIBBLU_DEFAULT_INIT_PRES_TIME  ((uint64_t) 54000000 * 300)
 
 #define LIBBLU_DEFAULT_INIT_TSTD_DUR  0.9
 
+#define LIBBLU_MIN_PES_LOOKAHEAD  1
+#define LIBBLU_MAX_PES_LOOKAHEAD  10000
+#define LIBBLU_DEFAULT_PES_LOOKAHEAD  LIBBLU_ES_MIN_BUF_PES_PACKETS
+
+/** \~english
+ * \brief Default statistics report filename extension, appended to the
+ * output filename.
+ */
+#define LIBBLU_DEFAULT_STATS_EXT  lbc_str(".stats.json")
+
+/** \~english
+ * \brief Default buffers occupancy timeline filename extension, appended
+ * to the output filename.
+ */
+#define LIBBLU_DEFAULT_TIMELINE_EXT  lbc_str(".timeline.csv")
+
+/** \~english
+ * \brief Default muxer decisions trace filename extension, appended to the
+ * output filename.
+ */
+#define LIBBLU_DEFAULT_TRACE_EXT  lbc_str(".trace")
+
+/** \~english
+ * \brief Default JSON profiling summary filename extension, appended to the
+ * output filename.
+ */
+#define LIBBLU_DEFAULT_PROFILE_EXT  lbc_str(".profile.json")
+
 typedef struct {
   lbc * outputTsFilename;
+  FILE * outputStream;  /**< Non-seekable output stream, if not NULL, used
+    instead of #outputTsFilename (which is then equal to
+    #LIBBLU_STDOUT_OUTPUT_FILENAME).                                         */
+  lbc * statsFilepath;     /**< JSON statistics report filepath, if not
+    NULL.                                                                    */
+  lbc * timelineFilepath;  /**< CSV buffers occupancy timeline filepath, if
+    not NULL.                                                                */
+  lbc * traceFilepath;     /**< Binary muxer decisions trace filepath, if
+    not NULL.                                                                */
+  lbc * profileFilepath;   /**< JSON profiling summary filepath, if not
+    NULL.                                                                    */
 
   LibbluESSettings inputStreams[LIBBLU_MAX_NB_STREAMS];
   unsigned nbInputStreams;
@@ -66,6 +129,8 @@ typedef struct {
   uint64_t targetMuxingRate;
   uint64_t initialPresentationTime;
   float initialTStdBufDuration;
+  unsigned pesLookahead;  /**< Number of PES packets prepared in advance
+    for each ES.                                                             */
 
   LibbluDtcpSettings dtcpParameters;
 
@@ -100,6 +165,22 @@ int initLibbluMuxingSettings(
   IniFileContextPtr confHandle
 );
 
+/** \~english
+ * \brief Copy supplied #LibbluMuxingSettings structure.
+ *
+ * \param dst Destination settings.
+ * \param src Source settings.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Owned strings are duplicated, destination must be released using
+ * #cleanLibbluMuxingSettings() (or passed to a muxing context).
+ */
+int copyLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const LibbluMuxingSettings * src
+);
+
 /** \~english
  * \brief Release memory allocation used by #LibbluMuxingSettings.
  *
@@ -112,6 +193,10 @@ static inline void cleanLibbluMuxingSettings(
   unsigned i;
 
   free(settings.outputTsFilename);
+  free(settings.statsFilepath);
+  free(settings.timelineFilepath);
+  free(settings.traceFilepath);
+  free(settings.profileFilepath);
 
   for (i = 0; i < settings.nbInputStreams; i++)
     cleanLibbluESSettings(settings.inputStreams[i]);
@@ -141,6 +226,62 @@ static inline LibbluESSettings * getNewESLibbluMuxingSettings(
   return initLibbluESSettings(es);
 }
 
+/** \~english
+ * \brief Set the JSON statistics report filepath.
+ *
+ * \param dst Destination muxing settings structure.
+ * \param filepath Report filepath, if NULL, the output filename with
+ * #LIBBLU_DEFAULT_STATS_EXT extension is used.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int setStatsFilepathLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const lbc * filepath
+);
+
+/** \~english
+ * \brief Set the CSV buffers occupancy timeline filepath.
+ *
+ * \param dst Destination muxing settings structure.
+ * \param filepath Timeline filepath, if NULL, the output filename with
+ * #LIBBLU_DEFAULT_TIMELINE_EXT extension is used.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int setTimelineFilepathLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const lbc * filepath
+);
+
+/** \~english
+ * \brief Set the binary muxer decisions trace filepath.
+ *
+ * \param dst Destination muxing settings structure.
+ * \param filepath Trace filepath, if NULL, the output filename with
+ * #LIBBLU_DEFAULT_TRACE_EXT extension is used.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int setTraceFilepathLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const lbc * filepath
+);
+
+/** \~english
+ * \brief Set the JSON profiling summary filepath.
+ *
+ * \param dst Destination muxing settings structure.
+ * \param filepath Summary filepath, if NULL, the output filename with
+ * #LIBBLU_DEFAULT_PROFILE_EXT extension is used.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int setProfileFilepathLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  const lbc * filepath
+);
+
 /** \~english
  * \brief Set the muxing target multiplex rate value.
  *
@@ -185,6 +326,28 @@ static inline int setInitPresTimeLibbluMuxingSettings(
   return 0;
 }
 
+/** \~english
+ * \brief Set the number of PES packets prepared in advance for each ES.
+ *
+ * \param dst Destination muxing settings structure.
+ * \param value Number of PES packets.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned, indicating supplied value exceed parameter limits.
+ */
+static inline int setPesLookaheadLibbluMuxingSettings(
+  LibbluMuxingSettings * dst,
+  uint64_t value
+)
+{
+  if (value < LIBBLU_MIN_PES_LOOKAHEAD)
+    return -1;
+  if (LIBBLU_MAX_PES_LOOKAHEAD < value)
+    return -1;
+
+  dst->pesLookahead = value;
+  return 0;
+}
+
 static inline int setFpsChangeLibbluMuxingSettings(
   LibbluMuxingSettings * dst,
   const lbc * expr
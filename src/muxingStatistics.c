@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "muxingStatistics.h"
+
+/* ### JSON report : ####################################################### */
+
+static void writeJsonStreamEntry(
+  FILE * file,
+  const LibbluStreamPtr stream,
+  const char * type,
+  size_t packetSize,
+  bool last
+)
+{
+  fprintf(
+    file,
+    "    {\"pid\": %" PRIu16 ", \"type\": \"%s\", "
+    "\"packets\": %" PRIu32 ", \"bytes\": %" PRIu64 "}%s\n",
+    stream->pid,
+    type,
+    stream->packetNb,
+    (uint64_t) stream->packetNb * packetSize,
+    (last) ? "" : ","
+  );
+}
+
+typedef struct {
+  FILE * file;
+  unsigned nbBuffers;
+} JsonBuffersWriting;
+
+static int writeJsonBufferEntry(
+  BufModelBufferPtr buf,
+  const char * path,
+  void * opaque
+)
+{
+  JsonBuffersWriting * writing = (JsonBuffersWriting *) opaque;
+
+  fprintf(
+    writing->file,
+    "%s    {\"path\": \"%s\", \"size\": %zu, \"updates\": %" PRIu64 ", "
+    "\"min\": %zu, \"max\": %zu, "
+    "\"p50\": %zu, \"p95\": %zu, \"p99\": %zu}",
+    (0 < writing->nbBuffers) ? ",\n" : "",
+    path,
+    buf->header.param.bufferSize,
+    buf->header.nbUpdates,
+    buf->header.bufferFillingLevelMin,
+    buf->header.bufferFillingLevelMax,
+    percentileFillingLevelBufModelBuffer(buf, 50),
+    percentileFillingLevelBufModelBuffer(buf, 95),
+    percentileFillingLevelBufModelBuffer(buf, 99)
+  );
+  writing->nbBuffers++;
+
+  return 0;
+}
+
+int writeReportLibbluMuxingStatistics(
+  const lbc * filepath,
+  const LibbluMuxingContextPtr ctx
+)
+{
+  FILE * file;
+  size_t packetSize;
+  unsigned i;
+
+  assert(NULL != filepath);
+  assert(NULL != ctx);
+
+  if (NULL == (file = lbc_fopen(filepath, "w")))
+    LIBBLU_ERROR_RETURN(
+      "Unable to open statistics report file '%" PRI_LBCS "', "
+      "%s (errno: %d).\n",
+      filepath,
+      strerror(errno),
+      errno
+    );
+
+  packetSize = TP_SIZE;
+  if (LIBBLU_MUX_SETTINGS_OPTION(&ctx->settings, writeTPExtraHeaders))
+    packetSize += 4; /* tp_extra_header() */
+
+  fprintf(file, "{\n");
+  fprintf(file, "  \"muxing_rate\": %" PRIu64 ",\n", ctx->settings.targetMuxingRate);
+  fprintf(file, "  \"packets\": %u,\n", ctx->nbTsPacketsMuxed);
+  fprintf(file, "  \"bytes\": %zu,\n", ctx->nbBytesWritten);
+  fprintf(
+    file, "  \"null_packets_percentage\": %.3f,\n",
+    100.0 * ctx->null->packetNb / MAX(1, ctx->nbTsPacketsMuxed)
+  );
+
+  /* Per PID */
+  fprintf(file, "  \"streams\": [\n");
+  for (i = 0; i < nbESLibbluMuxingContext(ctx); i++)
+    writeJsonStreamEntry(file, ctx->elementaryStreams[i], "es", packetSize, false);
+  writeJsonStreamEntry(file, ctx->pat, "pat", packetSize, false);
+  writeJsonStreamEntry(file, ctx->pmt, "pmt", packetSize, false);
+  writeJsonStreamEntry(file, ctx->sit, "sit", packetSize, false);
+  writeJsonStreamEntry(file, ctx->pcr, "pcr", packetSize, false);
+  writeJsonStreamEntry(file, ctx->null, "null", packetSize, true);
+  fprintf(file, "  ],\n");
+
+  /* PCR intervals, in 27MHz ticks */
+  fprintf(file, "  \"pcr\": {\n");
+  fprintf(file, "    \"count\": %u,\n", ctx->nbPcrInjected);
+  fprintf(file, "    \"interval_min\": %" PRIu64 ",\n", ctx->pcrIntervalMin);
+  fprintf(file, "    \"interval_max\": %" PRIu64 ",\n", ctx->pcrIntervalMax);
+  fprintf(
+    file, "    \"interval_mean\": %.1f\n",
+    (1 < ctx->nbPcrInjected) ?
+      (double) ctx->pcrIntervalSum / (ctx->nbPcrInjected - 1)
+    :
+      0.0
+  );
+  fprintf(file, "  },\n");
+
+  /* T-STD */
+  if (isEnabledTStdModelLibbluMuxingContext(ctx)) {
+    JsonBuffersWriting writing = {.file = file};
+
+    fprintf(file, "  \"t_std\": {\n");
+    fprintf(file, "    \"delayed_injections\": %u,\n", ctx->nbTStdDelayedPackets);
+    fprintf(file, "    \"buffers\": [\n");
+    if (walkBufModelBufferingChain(ctx->tStdModel, writeJsonBufferEntry, &writing) < 0)
+      goto free_return;
+    fprintf(file, "\n    ]\n");
+    fprintf(file, "  }\n");
+  }
+  else
+    fprintf(file, "  \"t_std\": null\n");
+  fprintf(file, "}\n");
+
+  if (fclose(file) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Unable to write statistics report file, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+
+  return 0;
+
+free_return:
+  fclose(file);
+  return -1;
+}
+
+/* ### CSV timeline : ###################################################### */
+
+static int writeCsvBufferName(
+  BufModelBufferPtr buf,
+  const char * path,
+  void * opaque
+)
+{
+  (void) buf;
+  fprintf((FILE *) opaque, ",%s", path);
+  return 0;
+}
+
+static int writeCsvBufferLevel(
+  BufModelBufferPtr buf,
+  const char * path,
+  void * opaque
+)
+{
+  (void) path;
+  fprintf((FILE *) opaque, ",%zu", buf->header.bufferFillingLevel);
+  return 0;
+}
+
+int openLibbluMuxingTimeline(
+  LibbluMuxingTimeline * dst,
+  const lbc * filepath,
+  const LibbluMuxingContextPtr ctx
+)
+{
+  assert(NULL != dst);
+  assert(NULL != filepath);
+
+  if (!isEnabledTStdModelLibbluMuxingContext(ctx))
+    LIBBLU_ERROR_RETURN(
+      "Buffers occupancy timeline requires the T-STD buffering model.\n"
+    );
+
+  if (NULL == (dst->file = lbc_fopen(filepath, "w")))
+    LIBBLU_ERROR_RETURN(
+      "Unable to open timeline file '%" PRI_LBCS "', %s (errno: %d).\n",
+      filepath,
+      strerror(errno),
+      errno
+    );
+  dst->lastNbTsPackets = ctx->nbTsPacketsMuxed;
+
+  fprintf(dst->file, "stc,packets");
+  if (walkBufModelBufferingChain(ctx->tStdModel, writeCsvBufferName, dst->file) < 0)
+    return -1;
+  fprintf(dst->file, "\n");
+
+  return 0;
+}
+
+int sampleLibbluMuxingTimeline(
+  LibbluMuxingTimeline * timeline,
+  const LibbluMuxingContextPtr ctx
+)
+{
+  fprintf(
+    timeline->file,
+    "%" PRIu64 ",%u",
+    ctx->currentStcTs,
+    ctx->nbTsPacketsMuxed
+  );
+  if (walkBufModelBufferingChain(ctx->tStdModel, writeCsvBufferLevel, timeline->file) < 0)
+    return -1;
+  if (fprintf(timeline->file, "\n") < 0)
+    LIBBLU_ERROR_RETURN(
+      "Unable to write timeline file, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+
+  timeline->lastNbTsPackets = ctx->nbTsPacketsMuxed;
+  return 0;
+}
+
+int closeLibbluMuxingTimeline(
+  LibbluMuxingTimeline * timeline
+)
+{
+  if (NULL == timeline->file)
+    return 0;
+
+  if (fclose(timeline->file) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Unable to write timeline file, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+  timeline->file = NULL;
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+/** \~english
+ * \file muxingStatistics.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Machine-readable muxing statistics module.
+ *
+ * Exports a JSON statistics report at the end of a mux (per-PID packets,
+ * PCR intervals, NULL packets ratio, T-STD buffers occupancy and delayed
+ * injections) and an optional decimated CSV timeline of T-STD buffers
+ * filling levels. Statistics are collected during muxing by the context
+ * and the buffering model, at a negligible cost.
+ */
+
+#ifndef __LIBBLU_MUXER__MUXING_STATISTICS_H__
+#define __LIBBLU_MUXER__MUXING_STATISTICS_H__
+
+#include "util.h"
+#include "muxingContext.h"
+
+/** \~english
+ * \brief Number of transport packets between two timeline samples.
+ *
+ * Shall be a multiple of the BDAV "Aligned unit" size (32 packets).
+ */
+#define LIBBLU_STATS_TIMELINE_INTERVAL  1024
+
+/** \~english
+ * \brief Write the JSON statistics report of a completed mux.
+ *
+ * \param filepath Report filepath.
+ * \param ctx Muxer context.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int writeReportLibbluMuxingStatistics(
+  const lbc * filepath,
+  const LibbluMuxingContextPtr ctx
+);
+
+typedef struct {
+  FILE * file;
+  unsigned lastNbTsPackets;  /**< Number of transport packets muxed at the
+    last sample.                                                             */
+} LibbluMuxingTimeline;
+
+/** \~english
+ * \brief Create the buffers occupancy timeline file and write its header.
+ *
+ * \param dst Timeline to initialize.
+ * \param filepath Timeline CSV filepath.
+ * \param ctx Muxer context, using the T-STD buffering model.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * A column is written for each buffer of the T-STD buffering model, named
+ * from its path in the model (e.g. "0x1011/EB").
+ */
+int openLibbluMuxingTimeline(
+  LibbluMuxingTimeline * dst,
+  const lbc * filepath,
+  const LibbluMuxingContextPtr ctx
+);
+
+/** \~english
+ * \brief Return true if a timeline sample shall be written at the current
+ * muxing state.
+ *
+ * \param timeline Timeline.
+ * \param ctx Muxer context.
+ */
+static inline bool isDueLibbluMuxingTimeline(
+  const LibbluMuxingTimeline * timeline,
+  const LibbluMuxingContextPtr ctx
+)
+{
+  return
+    0 == (ctx->nbTsPacketsMuxed % LIBBLU_STATS_TIMELINE_INTERVAL)
+    && timeline->lastNbTsPackets != ctx->nbTsPacketsMuxed
+  ;
+}
+
+/** \~english
+ * \brief Write a timeline sample of the current buffers filling levels.
+ *
+ * \param timeline Timeline.
+ * \param ctx Muxer context.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Sampled levels are the ones of the last update of each buffer, in bits.
+ */
+int sampleLibbluMuxingTimeline(
+  LibbluMuxingTimeline * timeline,
+  const LibbluMuxingContextPtr ctx
+);
+
+/** \~english
+ * \brief Close the timeline file.
+ *
+ * \param timeline Timeline.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int closeLibbluMuxingTimeline(
+  LibbluMuxingTimeline * timeline
+);
+
+#endif
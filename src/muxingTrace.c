@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+
+#include "muxingTrace.h"
+
+LibbluMuxingTracePtr createLibbluMuxingTrace(
+  const lbc * filepath
+)
+{
+  LibbluMuxingTracePtr trace;
+
+  assert(NULL != filepath);
+
+  if (NULL == (trace = (LibbluMuxingTracePtr) malloc(sizeof(LibbluMuxingTrace))))
+    LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
+  trace->nbEvents = 0;
+
+  trace->file = createBitstreamWriter(
+    filepath,
+    LIBBLU_TRACE_BUFFER_NB_EVENTS * LIBBLU_TRACE_EVENT_SIZE
+  );
+  if (NULL == trace->file)
+    goto free_return;
+
+  if (writeBytes(trace->file, (uint8_t *) LIBBLU_TRACE_MAGIC, 4) < 0)
+    goto free_return;
+  if (writeByte(trace->file, LIBBLU_TRACE_VERSION) < 0)
+    goto free_return;
+
+  return trace;
+
+free_return:
+  closeBitstreamWriter(trace->file);
+  free(trace);
+  return NULL;
+}
+
+int closeLibbluMuxingTrace(
+  LibbluMuxingTracePtr trace
+)
+{
+  int ret;
+
+  if (NULL == trace)
+    return 0;
+
+  ret = flushBitstreamWriter(trace->file);
+  closeBitstreamWriter(trace->file);
+  free(trace);
+
+  return ret;
+}
+
+int recordLibbluMuxingTrace(
+  LibbluMuxingTracePtr trace,
+  LibbluMuxingTraceEvent event
+)
+{
+  uint8_t * rec;
+
+  /* Event is serialized directly in writing buffer */
+  if (NULL == (rec = reserveBytesBitstreamWriter(trace->file, LIBBLU_TRACE_EVENT_SIZE)))
+    return -1;
+
+  rec[0] = event.type;
+  rec[1] = event.flags;
+  lb_put_be_value(rec +  2, event.pid, 2);
+  lb_put_be_value(rec +  4, event.packetIdx, 4);
+  lb_put_be_value(rec +  8, event.stc, 8);
+  lb_put_be_value(rec + 16, event.tsPt, 8);
+  lb_put_be_value(rec + 24, event.levels[0], 4);
+  lb_put_be_value(rec + 28, event.levels[1], 4);
+
+  trace->nbEvents++;
+  return 0;
+}
+
+/* ### Decoding : ########################################################## */
+
+static const char * eventTypeStr(
+  uint8_t type
+)
+{
+  static const char * names[] = {
+    "UNKNOWN",
+    "SYS",
+    "ES",
+    "NULL",
+    "ES_DELAYED",
+    "PES_BUILT"
+  };
+
+  if (ARRAY_SIZE(names) <= type)
+    return names[0];
+  return names[type];
+}
+
+int decodeLibbluMuxingTrace(
+  const lbc * filepath,
+  LibbluMuxingTraceFilter filter
+)
+{
+  BitstreamReaderPtr file;
+  uint8_t magic[4], version;
+  uint8_t rec[LIBBLU_TRACE_EVENT_SIZE];
+
+  if (NULL == (file = createBitstreamReader(filepath, READ_BUFFER_LEN)))
+    return -1;
+
+  if (readBytes(file, magic, 4) < 0 || readByte(file, &version) < 0)
+    goto free_return;
+  if (0 != memcmp(magic, LIBBLU_TRACE_MAGIC, 4))
+    LIBBLU_ERROR_FRETURN("Input file is not a muxer trace.\n");
+  if (LIBBLU_TRACE_VERSION != version)
+    LIBBLU_ERROR_FRETURN("Unsupported trace file version %u.\n", version);
+
+  while (!isEof(file)) {
+    uint16_t pid;
+    uint64_t stc;
+
+    if (readBytes(file, rec, LIBBLU_TRACE_EVENT_SIZE) < 0)
+      LIBBLU_ERROR_FRETURN("Truncated trace file.\n");
+
+    pid = lb_get_be_value(rec + 2, 2);
+    stc = lb_get_be_value(rec + 8, 8);
+    if (0 <= filter.pid && pid != filter.pid)
+      continue;
+    if (stc < filter.startStc || filter.endStc < stc)
+      continue;
+
+    lbc_printf(
+      "%10" PRIu64 " STC %" PRIu64 " %-10s PID 0x%04" PRIX16
+      " tsPt %" PRIu64 " levels %" PRIu64 "/%" PRIu64 "%s\n",
+      lb_get_be_value(rec + 4, 4),
+      stc,
+      eventTypeStr(rec[0]),
+      pid,
+      lb_get_be_value(rec + 16, 8),
+      lb_get_be_value(rec + 24, 4),
+      lb_get_be_value(rec + 28, 4),
+      (rec[1] & LIBBLU_TRACE_FLAG_PCR) ? " PCR" : ""
+    );
+  }
+
+  closeBitstreamReader(file);
+  return 0;
+
+free_return:
+  closeBitstreamReader(file);
+  return -1;
+}
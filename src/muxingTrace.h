@@ -0,0 +1,136 @@
+/** \~english
+ * \file muxingTrace.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Binary muxer decisions trace module.
+ *
+ * Muxer decisions (muxed packets, delayed injections, built PES packets)
+ * are recorded as fixed-size binary events in a large in-memory buffer,
+ * written to the trace file by blocks. This is far cheaper than text
+ * debugging output and can be kept enabled on complete titles. A trace is
+ * converted back to text by the decoding mode (see
+ * #decodeLibbluMuxingTrace()).
+ *
+ * Trace file format (big-endian):
+ *  - Header: #LIBBLU_TRACE_MAGIC, #LIBBLU_TRACE_VERSION (1 byte);
+ *  - Events (#LIBBLU_TRACE_EVENT_SIZE bytes each):
+ *      type (1 byte), flags (1 byte), PID (2 bytes),
+ *      packet index (4 bytes), STC (8 bytes), tsPt (8 bytes),
+ *      first and second buffers filling levels in bits (4 bytes each).
+ */
+
+#ifndef __LIBBLU_MUXER__MUXING_TRACE_H__
+#define __LIBBLU_MUXER__MUXING_TRACE_H__
+
+#include "util.h"
+#include "stream.h"
+
+#define LIBBLU_TRACE_MAGIC  "LBTR"
+#define LIBBLU_TRACE_VERSION  1
+
+/** \~english
+ * \brief Trace event size in bytes.
+ */
+#define LIBBLU_TRACE_EVENT_SIZE  32
+
+/** \~english
+ * \brief Trace in-memory buffer size in events.
+ */
+#define LIBBLU_TRACE_BUFFER_NB_EVENTS  (64 * 1024)
+
+typedef enum {
+  LIBBLU_TRACE_SYS_PACKET   = 0x01,  /**< System packet muxed.              */
+  LIBBLU_TRACE_ES_PACKET    = 0x02,  /**< ES packet muxed.                  */
+  LIBBLU_TRACE_NULL_PACKET  = 0x03,  /**< NULL packet muxed.                */
+  LIBBLU_TRACE_ES_DELAYED   = 0x04,  /**< ES packet injection delayed to
+    avoid a T-STD buffer overflow.                                           */
+  LIBBLU_TRACE_PES_BUILT    = 0x05   /**< New PES packet built.             */
+} LibbluMuxingTraceEventType;
+
+/** \~english
+ * \brief Trace event flags.
+ */
+#define LIBBLU_TRACE_FLAG_PCR  0x01  /**< Packet carries a PCR.              */
+
+typedef struct {
+  LibbluMuxingTraceEventType type;
+  uint8_t flags;
+  uint16_t pid;
+  uint32_t packetIdx;  /**< Number of packets muxed at the event record.    */
+  uint64_t stc;        /**< STC value in #MAIN_CLOCK_27MHZ ticks.           */
+  uint64_t tsPt;       /**< Stream next transport packet timestamp.         */
+  uint32_t levels[2];  /**< Filling levels of the stream first two T-STD
+    buffers (e.g. TB and B) after the event, in bits, or zero.               */
+} LibbluMuxingTraceEvent;
+
+typedef struct {
+  BitstreamWriterPtr file;
+  uint64_t nbEvents;
+} LibbluMuxingTrace, *LibbluMuxingTracePtr;
+
+/** \~english
+ * \brief Create a muxer decisions trace.
+ *
+ * \param filepath Trace filepath.
+ * \return LibbluMuxingTracePtr Upon success, the created trace is returned.
+ * Otherwise, a NULL pointer is returned.
+ */
+LibbluMuxingTracePtr createLibbluMuxingTrace(
+  const lbc * filepath
+);
+
+/** \~english
+ * \brief Write pending events and close the trace.
+ *
+ * \param trace Trace to close (may be NULL).
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int closeLibbluMuxingTrace(
+  LibbluMuxingTracePtr trace
+);
+
+/** \~english
+ * \brief Record a trace event.
+ *
+ * \param trace Destination trace.
+ * \param event Event to record.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int recordLibbluMuxingTrace(
+  LibbluMuxingTracePtr trace,
+  LibbluMuxingTraceEvent event
+);
+
+/** \~english
+ * \brief Trace decoding filters.
+ */
+typedef struct {
+  int pid;            /**< Only PID events, if not negative.                 */
+  uint64_t startStc;  /**< Only events from STC value (inclusive).           */
+  uint64_t endStc;    /**< Only events until STC value (inclusive).          */
+} LibbluMuxingTraceFilter;
+
+/** \~english
+ * \brief Default trace decoding filters, keeping every event.
+ */
+#define LIBBLU_TRACE_NO_FILTER                                                \
+  ((LibbluMuxingTraceFilter) {.pid = -1, .startStc = 0, .endStc = UINT64_MAX})
+
+/** \~english
+ * \brief Print as text the events of a trace.
+ *
+ * \param filepath Trace filepath.
+ * \param filter Events filters.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int decodeLibbluMuxingTrace(
+  const lbc * filepath,
+  LibbluMuxingTraceFilter filter
+);
+
+#endif
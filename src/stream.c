@@ -249,7 +249,10 @@ int requestESPIDLibbluStream(
       );
 
     /* Try to insert value */
-    ret = insertLibbluRegisteredPIDValues(&values->registeredValues, basePid);
+    ret = insertLibbluRegisteredPIDValues(
+      &values->registeredValues,
+      selectedPid
+    );
     switch (ret) {
       case 0: /* Unable to inser value */
         selectedPid++;
@@ -197,6 +197,8 @@ int addStreamHeap(
   assert(NULL != heap);
   assert(NULL != stream);
 
+  LIBBLU_PROFILE_START(profTimer);
+
   if (heap->allocatedSize <= heap->usedSize) {
     /* Heap limit reached, increase heap size. */
     if (increaseSizeStreamHeap(heap) < 0)
@@ -211,6 +213,7 @@ int addStreamHeap(
   /* Shift up in heap if required: */
   shiftUpStreamHeap(heap, idx);
 
+  LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_HEAP);
   return 0;
 }
 
@@ -228,20 +231,21 @@ void extractStreamHeap(
       "attempt to extract from a corrupted stream heap.\n"
     );
 
+  LIBBLU_PROFILE_START(profTimer);
+
   if (NULL != timer)
     *timer = heap->content[0].timer;
   if (NULL != stream)
     *stream  = heap->content[0].stream;
   heap->usedSize--;
 
-  if (!heap->usedSize)
-    return;
-
-  assert(0 < heap->usedSize);
+  if (0 < heap->usedSize) {
+    editStreamHeap(
+      heap, 0,
+      heap->content[heap->usedSize].timer,
+      heap->content[heap->usedSize].stream
+    );
+  }
 
-  editStreamHeap(
-    heap, 0,
-    heap->content[heap->usedSize].timer,
-    heap->content[heap->usedSize].stream
-  );
+  LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_HEAP);
 }
\ No newline at end of file
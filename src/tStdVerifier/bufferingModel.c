@@ -489,6 +489,31 @@ bool checkBufModelBuffer(
   return ret;
 }
 
+/** \~english
+ * \brief Update filling level statistics of supplied buffer.
+ *
+ * Called on each buffer update, cheap enough to be always enabled.
+ */
+static void updateFillingLevelStatsBufModelBuffer(
+  BufModelBufferPtr buf
+)
+{
+  size_t level = buf->header.bufferFillingLevel;
+  size_t size = MAX(1, buf->header.param.bufferSize);
+
+  buf->header.bufferFillingLevelMax = MAX(
+    buf->header.bufferFillingLevelMax,
+    level
+  );
+  if (!buf->header.nbUpdates || level < buf->header.bufferFillingLevelMin)
+    buf->header.bufferFillingLevelMin = level;
+
+  buf->header.bufferFillingLevelHist[
+    MIN(level * 100 / size, BUF_MODEL_LEVEL_HIST_SIZE - 1)
+  ]++;
+  buf->header.nbUpdates++;
+}
+
 int updateBufModelBuffer(
   BufModelBufferPtr buf,
   uint64_t timestamp,
@@ -538,6 +563,7 @@ int updateBufModelBuffer(
 
   /* Check if output data is greater than buffer occupancy. */
   if (buf->header.bufferFillingLevel < dataBandwidth) {
+    buf->header.violation = BUF_MODEL_UNDERFLOW;
     LIBBLU_ERROR_RETURN(
       "Buffer underflow (%zu < %zu) at %" PRIu64 ".\n",
       buf->header.bufferFillingLevel,
@@ -560,6 +586,7 @@ int updateBufModelBuffer(
   /* Check if buffer occupancy after update is greater than its size. */
   if (buf->header.param.bufferSize < buf->header.bufferFillingLevel) {
     /* buf Overflow, this shall never happen */
+    buf->header.violation = BUF_MODEL_OVERFLOW;
     LIBBLU_ERROR_RETURN(
       "Buffer overflow happen in %s (%zu < %zu).\n",
       BUFFER_NAME(buf),
@@ -567,6 +594,7 @@ int updateBufModelBuffer(
       buf->header.bufferFillingLevel
     );
   }
+  updateFillingLevelStatsBufModelBuffer(buf);
 
   /* Set update time */
   buf->header.lastUpdate = timestamp;
@@ -763,7 +791,15 @@ BufModelBufferPtr createLeakingBuffer(
   buf->header.isLinked = false;
   buf->header.bufferInputData = 0;
   buf->header.bufferFillingLevel = 0;
+  buf->header.bufferFillingLevelMax = 0;
+  buf->header.bufferFillingLevelMin = 0;
+  memset(
+    buf->header.bufferFillingLevelHist, 0,
+    sizeof(buf->header.bufferFillingLevelHist)
+  );
+  buf->header.nbUpdates = 0;
   buf->header.lastUpdate = initialTimestamp;
+  buf->header.violation = BUF_MODEL_NO_VIOLATION;
   buf->header.storedFrames = NULL;
   buf->removalBitratePerSec = removalBitrate;
   buf->removalBitrate = (double) removalBitrate / MAIN_CLOCK_27MHZ;
@@ -845,7 +881,15 @@ BufModelBufferPtr createRemovalBuffer(
   buf->header.isLinked = false;
   buf->header.bufferInputData = 0;
   buf->header.bufferFillingLevel = 0;
+  buf->header.bufferFillingLevelMax = 0;
+  buf->header.bufferFillingLevelMin = 0;
+  memset(
+    buf->header.bufferFillingLevelHist, 0,
+    sizeof(buf->header.bufferFillingLevelHist)
+  );
+  buf->header.nbUpdates = 0;
   buf->header.lastUpdate = initialTimestamp;
+  buf->header.violation = BUF_MODEL_NO_VIOLATION;
   buf->header.storedFrames = NULL;
 
   if (NULL == (frmBuf = createCircularBuffer(sizeof(BufModelBufferFrame))))
@@ -1563,6 +1607,239 @@ void printBufModelBufferingChain(const BufModelNode node)
   }
 }
 
+void printPeakLevelsBufModelBufferingChain(
+  const BufModelNode node,
+  unsigned indent
+)
+{
+  BufModelBufferPtr buf;
+  BufModelFilterPtr filter;
+  unsigned i;
+
+  switch (node.type) {
+    case NODE_VOID:
+      break;
+
+    case NODE_BUFFER:
+      buf = node.linkedElement.buffer;
+      lbc_printf(
+        "%*s- %s: %zu / %zu bits (%.1f%%);\n",
+        indent, "",
+        BUFFER_NAME(buf),
+        buf->header.bufferFillingLevelMax,
+        buf->header.param.bufferSize,
+        100.0 * buf->header.bufferFillingLevelMax
+          / MAX(1, buf->header.param.bufferSize)
+      );
+      printPeakLevelsBufModelBufferingChain(buf->header.output, indent);
+      break;
+
+    case NODE_FILTER:
+      filter = node.linkedElement.filter;
+      for (i = 0; i < filter->nbUsedNodes; i++) {
+        const BufModelFilterLbl label = filter->labels[i];
+
+        if (BUF_MODEL_NODE_IS_VOID(filter->nodes[i]))
+          continue; /* Route without buffer (e.g. untracked PIDs) */
+
+        if (
+          BUF_MODEL_FILTER_LABEL_TYPE_NUMERIC == label.type
+          && -1 == label.value.number
+        ) {
+          /* Default route, not identified by a label value, buffers are
+          listed by their names. */
+          printPeakLevelsBufModelBufferingChain(filter->nodes[i], indent);
+          continue;
+        }
+
+        lbc_printf("%*s- ", indent, "");
+        printBufModelFilterLbl(label);
+        lbc_printf(":\n");
+        printPeakLevelsBufModelBufferingChain(filter->nodes[i], indent + 2);
+      }
+  }
+}
+
+size_t percentileFillingLevelBufModelBuffer(
+  const BufModelBufferPtr buf,
+  double percentile
+)
+{
+  uint64_t threshold, count;
+  unsigned i;
+
+  threshold = ceil(buf->header.nbUpdates * percentile / 100);
+
+  count = 0;
+  for (i = 0; i < BUF_MODEL_LEVEL_HIST_SIZE - 1; i++) {
+    count += buf->header.bufferFillingLevelHist[i];
+    if (threshold <= count)
+      break;
+  }
+
+  /* Lower bound of the class, lowest level counted in it */
+  return (i * buf->header.param.bufferSize + 99) / 100;
+}
+
+static int printBufModelFilterLblPath(
+  char * dst,
+  size_t size,
+  const BufModelFilterLbl label
+)
+{
+  unsigned i;
+  int ret, len;
+
+  switch (label.type) {
+    case BUF_MODEL_FILTER_LABEL_TYPE_NUMERIC:
+      return snprintf(dst, size, "0x%X", label.value.number);
+
+    case BUF_MODEL_FILTER_LABEL_TYPE_STRING:
+      return snprintf(dst, size, "%s", label.value.string);
+
+    case BUF_MODEL_FILTER_LABEL_TYPE_LIST:
+      break;
+  }
+
+  /* List, items are separated by '+' */
+  len = 0;
+  for (i = 0; i < label.value.listLength; i++) {
+    if (0 < i) {
+      if ((ret = snprintf(dst + len, size - len, "+")) < 0)
+        return -1;
+      len = MIN(len + ret, (int) size - 1);
+    }
+
+    ret = printBufModelFilterLblPath(
+      dst + len,
+      size - len,
+      (BufModelFilterLbl) {
+        .type = label.value.listItemsType,
+        .value = label.value.list[i]
+      }
+    );
+    if (ret < 0)
+      return -1;
+    len = MIN(len + ret, (int) size - 1);
+  }
+
+  return len;
+}
+
+static int walkBufModelBufferingChainPath(
+  const BufModelNode node,
+  BufModelBufferVisitorFun visitor,
+  void * opaque,
+  char * path,
+  size_t pathLen
+)
+{
+  BufModelBufferPtr buf;
+  BufModelFilterPtr filter;
+  unsigned i;
+  int ret;
+
+  switch (node.type) {
+    case NODE_VOID:
+      break;
+
+    case NODE_BUFFER:
+      buf = node.linkedElement.buffer;
+      snprintf(
+        path + pathLen, STR_BUFSIZE - pathLen,
+        "%s", BUFFER_NAME(buf)
+      );
+      if (visitor(buf, path, opaque) < 0)
+        return -1;
+      return walkBufModelBufferingChainPath(
+        buf->header.output, visitor, opaque, path, pathLen
+      );
+
+    case NODE_FILTER:
+      filter = node.linkedElement.filter;
+      for (i = 0; i < filter->nbUsedNodes; i++) {
+        size_t len = pathLen;
+
+        ret = printBufModelFilterLblPath(
+          path + len, STR_BUFSIZE - len - 1, filter->labels[i]
+        );
+        if (ret < 0)
+          LIBBLU_ERROR_RETURN("Unable to print buffering model path.\n");
+        len = MIN(len + ret, STR_BUFSIZE - 2);
+        path[len++] = '/';
+        path[len] = '\0';
+
+        ret = walkBufModelBufferingChainPath(
+          filter->nodes[i], visitor, opaque, path, len
+        );
+        if (ret < 0)
+          return -1;
+      }
+  }
+
+  return 0;
+}
+
+int walkBufModelBufferingChain(
+  const BufModelNode node,
+  BufModelBufferVisitorFun visitor,
+  void * opaque
+)
+{
+  char path[STR_BUFSIZE];
+
+  path[0] = '\0';
+  return walkBufModelBufferingChainPath(node, visitor, opaque, path, 0);
+}
+
+typedef struct {
+  BufModelViolation violation;
+  char * path;
+  size_t pathSize;
+} BufModelViolationLookup;
+
+static int findViolationVisitor(
+  BufModelBufferPtr buf,
+  const char * path,
+  void * opaque
+)
+{
+  BufModelViolationLookup * lookup = (BufModelViolationLookup *) opaque;
+
+  if (
+    BUF_MODEL_NO_VIOLATION == lookup->violation
+    && BUF_MODEL_NO_VIOLATION != buf->header.violation
+  ) {
+    lookup->violation = buf->header.violation;
+    snprintf(lookup->path, lookup->pathSize, "%s", path);
+  }
+
+  return 0;
+}
+
+int findViolationBufModelBufferingChain(
+  const BufModelNode node,
+  BufModelViolation * violation,
+  char * path,
+  size_t pathSize
+)
+{
+  BufModelViolationLookup lookup = {
+    .violation = BUF_MODEL_NO_VIOLATION,
+    .path = path,
+    .pathSize = pathSize
+  };
+
+  assert(NULL != violation);
+  assert(NULL != path && 0 < pathSize);
+
+  if (walkBufModelBufferingChain(node, findViolationVisitor, &lookup) < 0)
+    return -1;
+
+  *violation = lookup.violation;
+  return 0;
+}
+
 #if 0
 
 int main(void)
@@ -223,6 +223,37 @@ typedef struct {
     not removed from current buffer at frame removal (as if it is copied).   */
 } BufModelBufferFrame;
 
+/** \~english
+ * \brief Number of classes of the buffers filling level histogram, one per
+ * percent of buffer size.
+ */
+#define BUF_MODEL_LEVEL_HIST_SIZE  101
+
+/** \~english
+ * \brief Buffering model violation, compliance error detected while
+ * updating a buffer.
+ */
+typedef enum {
+  BUF_MODEL_NO_VIOLATION,
+  BUF_MODEL_UNDERFLOW,     /**< Data removed before its reception.        */
+  BUF_MODEL_OVERFLOW       /**< Filling level exceeds buffer size.        */
+} BufModelViolation;
+
+static inline const char * bufModelViolationStr(
+  BufModelViolation violation
+)
+{
+  static const char * strings[] = {
+    "no violation",
+    "buffer underflow",
+    "buffer overflow"
+  };
+
+  if (0 <= violation && violation < ARRAY_SIZE(strings))
+    return strings[violation];
+  return "unknown";
+}
+
 /** \~english
  * \brief Common buffers header structure.
  */
@@ -239,8 +270,17 @@ typedef struct {
   size_t bufferFillingLevel;       /**< Buffer filling level in bits. If
     this value exceeds BufferParameters.bufferSize value, an overflow
     situation occurs.                                                        */
+  size_t bufferFillingLevelMax;    /**< Buffer highest filling level in
+    bits reached since its creation.                                         */
+  size_t bufferFillingLevelMin;    /**< Buffer lowest filling level in bits
+    reached since its first update.                                          */
+  uint64_t bufferFillingLevelHist[BUF_MODEL_LEVEL_HIST_SIZE];  /**< Buffer
+    filling level histogram, number of updates per percent of buffer size.   */
+  uint64_t nbUpdates;              /**< Number of buffer updates.            */
 
   uint64_t lastUpdate;             /**< Last buffer updating timestamp.      */
+  BufModelViolation violation;     /**< Violation detected at last update,
+    if any.                                                                  */
 
   CircularBufferPtr storedFrames;  /**< Buffer pending data frames. FIFO
     of #BufferFrame.                                                         */
@@ -1042,4 +1082,82 @@ void printBufModelBufferingChain(
   const BufModelNode node
 );
 
+/** \~english
+ * \brief Return the filling level percentile of supplied buffer.
+ *
+ * \param buf Buffer.
+ * \param percentile Percentile, between 0 and 100.
+ * \return size_t Filling level in bits of the supplied percentage of buffer
+ * updates, rounded down to one percent of buffer size precision (an always
+ * empty buffer reports zero).
+ */
+size_t percentileFillingLevelBufModelBuffer(
+  const BufModelBufferPtr buf,
+  double percentile
+);
+
+/** \~english
+ * \brief Buffering model chain buffers visitor function.
+ *
+ * \param buf Visited buffer.
+ * \param path Buffer path in chain, made of traversed filters labels and
+ * buffer name (e.g. "0x1011/TB").
+ * \param opaque User data.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned, stopping the walk.
+ */
+typedef int (*BufModelBufferVisitorFun) (
+  BufModelBufferPtr buf,
+  const char * path,
+  void * opaque
+);
+
+/** \~english
+ * \brief Call supplied visitor function on each buffer of a buffering
+ * model chain.
+ *
+ * \param node Buffering model entry point node.
+ * \param visitor Visitor function.
+ * \param opaque User data passed to the visitor.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int walkBufModelBufferingChain(
+  const BufModelNode node,
+  BufModelBufferVisitorFun visitor,
+  void * opaque
+);
+
+/** \~english
+ * \brief Look for the buffer of a buffering model chain on which a
+ * violation has been detected.
+ *
+ * \param node Buffering model entry point node.
+ * \param violation On success, set to the violation kind, or to
+ * #BUF_MODEL_NO_VIOLATION if no buffer reports any.
+ * \param path On success, if a violation is found, set to the violated
+ * buffer path in chain (see #BufModelBufferVisitorFun).
+ * \param pathSize Size of the path destination string in bytes.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int findViolationBufModelBufferingChain(
+  const BufModelNode node,
+  BufModelViolation * violation,
+  char * path,
+  size_t pathSize
+);
+
+/** \~english
+ * \brief Print highest filling level reached by each buffer of buffering
+ * model chain on terminal.
+ *
+ * \param node Buffering model entry point node.
+ * \param indent Lines indentation in characters.
+ */
+void printPeakLevelsBufModelBufferingChain(
+  const BufModelNode node,
+  unsigned indent
+);
+
 #endif
\ No newline at end of file
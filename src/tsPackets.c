@@ -461,45 +461,53 @@ int writeTransportPacket(
   size_t * payloadSize
 )
 {
-  uint8_t tp[TP_SIZE];
+  uint8_t * tp;
   size_t hdrSize, pldSize;
 
+  LIBBLU_PROFILE_START(profTimer);
+
   if (header.adaptationFieldControl == 0x00)
     LIBBLU_ERROR_RETURN(
       "Unable to write transport packet, "
       "reserved value 'adaptation_field_control' == 0x00.\n"
     );
 
-  /* transport_packet header */
-  hdrSize = insertPacketHeader(tp, 0, header);
+  hdrSize = computeSizeTPHeader(header);
   assert(hdrSize <= TP_SIZE);
-  assert(hdrSize == computeSizeTPHeader(header));
 
-  /* transport_packet data_byte payload */
   pldSize = TP_SIZE - hdrSize;
   assert(payloadPresenceTPHeader(header) ^ !pldSize);
-  if (0 < pldSize) {
-    if (!payloadPresenceTPHeader(header))
-      LIBBLU_ERROR_RETURN(
-        "Unexpected presence of payload in transport packet (%zu bytes).\n",
-        pldSize
-      );
+  if (0 < pldSize && !payloadPresenceTPHeader(header))
+    LIBBLU_ERROR_RETURN(
+      "Unexpected presence of payload in transport packet (%zu bytes).\n",
+      pldSize
+    );
+
+  /* Generate transport packet directly in output buffer */
+  if (NULL == (tp = reserveBytesBitstreamWriter(output, TP_SIZE)))
+    return -1;
 
+  /* transport_packet header */
+  if (insertPacketHeader(tp, 0, header) != hdrSize)
+    LIBBLU_ERROR_RETURN(
+      "Unexpected transport packet header size.\n"
+    );
+
+  /* transport_packet data_byte payload */
+  if (0 < pldSize)
     insertPayload(tp, hdrSize, stream, pldSize);
-  } else {
+  else {
     if (!isESLibbluStream(stream))
       markAsSuppliedLibbluSystemStream(&stream->sys);
   }
 
-  /* Write generated transport packet */
-  if (writeBytes(output, tp, TP_SIZE) < 0)
-    return -1;
-
   if (NULL != headerSize)
     *headerSize = hdrSize;
   if (NULL != payloadSize)
     *payloadSize = pldSize;
 
   stream->packetNb++;
+
+  LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_TS_PACKETS);
   return 0;
 }
\ No newline at end of file
@@ -70,6 +70,13 @@ uint8_t getHdmvVideoFormat(int screenHorizontalDefinition, int screenVerticalDef
 }
 #endif
 
+static bool hiddenFileParsingProgressionBar = false;
+
+void setHiddenFileParsingProgressionBar(bool hidden)
+{
+  hiddenFileParsingProgressionBar = hidden;
+}
+
 void printFileParsingProgressionBar(BitstreamReaderPtr bitStream)
 {
   unsigned percentage;
@@ -77,7 +84,7 @@ void printFileParsingProgressionBar(BitstreamReaderPtr bitStream)
   static unsigned oldPercentage = 100;
   static uint64_t refBitStreamId = 0;
 
-  if (isDebugEnabled())
+  if (isDebugEnabled() || hiddenFileParsingProgressionBar)
     return; /* Don't print progress bar in debug mode for readability. */
 
   assert(NULL != bitStream);
@@ -17,7 +17,9 @@
 #include "util/crcLookupTables.h"
 #include "util/hashTables.h"
 #include "util/circularBuffer.h"
+#include "util/tasksPool.h"
 #include "util/bitStreamHandling.h"
+#include "util/profiling.h"
 #include "util/textFilesHandling.h"
 #include "util/libraries.h"
 
@@ -369,6 +371,17 @@ typedef struct {
   bool isInterlaced
 ); */
 
+/** \~english
+ * \brief Enable or disable files parsing progression bars.
+ *
+ * \param hidden If true, printFileParsingProgressionBar() prints nothing.
+ *
+ * Bars are hidden while several files are parsed concurrently, the caller
+ * being then in charge of progression reporting. Shall not be changed while
+ * files are parsed.
+ */
+void setHiddenFileParsingProgressionBar(bool hidden);
+
 void printFileParsingProgressionBar(BitstreamReaderPtr bitStream);
 
 /** \~english
@@ -1,3 +1,8 @@
+#if defined(__linux__)
+   /* Required for posix_fadvise() */
+#  define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -8,6 +13,10 @@
 #include <errno.h>
 #include <assert.h>
 
+#if !defined(DISABLE_THREADS)
+#  include <pthread.h>
+#endif
+
 #include "bitStreamHandling.h"
 
 #if defined(ARCH_WIN32)
@@ -16,12 +25,28 @@
 #  include <fileapi.h>
 #else
 #  include <sys/stat.h>
+#  include <fcntl.h>
+#endif
+
+#if !defined(DISABLE_THREADS)
+static pthread_mutex_t identifierMutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
 uint64_t generatedBistreamIdentifier(void)
 {
   static uint64_t id = 0;
-  return id++;
+  uint64_t value;
+
+  /* Bitstreams may be created concurrently by parallel analyzers. */
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_lock(&identifierMutex);
+#endif
+  value = id++;
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_unlock(&identifierMutex);
+#endif
+
+  return value;
 }
 
 BitstreamReaderPtr createBitstreamReader(
@@ -44,7 +69,7 @@ BitstreamReaderPtr createBitstreamReader(
     ); */
   assert(32 < bufferSize);
 
-  if (READ_BUFFER_LEN < bufferSize)
+  if (IO_VBUF_SIZE < bufferSize)
     LIBBLU_ERROR_NRETURN("Specified buffering size is too high.\n");
 
   if (NULL == (bitStream = (BitstreamReaderPtr) malloc(sizeof(BitstreamHandler))))
@@ -53,8 +78,9 @@ BitstreamReaderPtr createBitstreamReader(
   if (NULL == (bitStream->byteArray = (uint8_t *) malloc(bufferSize)))
     LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
 
-  bitStream->bufferLength = bitStream->byteArrayLength = bufferSize;
-  bitStream->byteArrayOff = bufferSize;
+  bitStream->bufferLength = bufferSize;
+  bitStream->byteArrayLength = 0; /* Empty byte-array window */
+  bitStream->byteArrayOff = 0;
   bitStream->bitCount = 8; /* By default, a complete byte can be readed at bit level. */
   bitStream->crcCtx = DEF_CRC_CTX();
   bitStream->fileOffset = 0;
@@ -69,14 +95,23 @@ BitstreamReaderPtr createBitstreamReader(
       errno
     );
 
-  if (NULL == (buffer = (char *) malloc(IO_VBUF_SIZE)))
-    LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
+  if (IO_VBUF_SIZE <= bufferSize) {
+    /* Byte-array buffer is large enough, avoid useless double buffering. */
+    if (setvbuf(bitStream->file, NULL, _IONBF, 0) < 0) {
+      perror("Error");
+      LIBBLU_ERROR_NRETURN("Reading buffer definition error.\n");
+    }
+  }
+  else {
+    if (NULL == (buffer = (char *) malloc(IO_VBUF_SIZE)))
+      LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
 
-  if (setvbuf(bitStream->file, buffer, _IOFBF, IO_VBUF_SIZE) < 0) {
-    perror("Error");
-    LIBBLU_ERROR_NRETURN("Reading buffer definition error.\n");
+    if (setvbuf(bitStream->file, buffer, _IOFBF, IO_VBUF_SIZE) < 0) {
+      perror("Error");
+      LIBBLU_ERROR_NRETURN("Reading buffer definition error.\n");
+    }
+    bitStream->buffer = buffer;
   }
-  bitStream->buffer = buffer;
 
   bitStream->identifier = generatedBistreamIdentifier();
 
@@ -97,19 +132,15 @@ void closeBitstreamReader(BitstreamReaderPtr bitStream)
   free(bitStream);
 }
 
-BitstreamWriterPtr createBitstreamWriter(
-  const lbc * outputFilename,
+static BitstreamWriterPtr initBitstreamWriter(
+  FILE * file,
   const size_t bufferSize
 )
 {
   BitstreamWriterPtr bitStream;
   char * buffer;
 
-  /* if (NULL == outputFilename)
-    LIBBLU_ERROR_NRETURN(
-      "createBitstreamWriter() expect a non-null outputFilename.\n"
-    ); */
-  assert(NULL != outputFilename);
+  assert(NULL != file);
 
   /* if (bufferSize < 32)
     LIBBLU_ERROR_NRETURN(
@@ -131,8 +162,46 @@ BitstreamWriterPtr createBitstreamWriter(
   bitStream->fileSize = 0;
   bitStream->fileOffset = 0;
   bitStream->buffer = NULL;
+  bitStream->file = file;
+
+  if (IO_VBUF_SIZE <= bufferSize) {
+    /* Byte-array buffer is large enough, avoid useless double buffering. */
+    if (setvbuf(bitStream->file, NULL, _IONBF, 0) < 0) {
+      perror("Unable to set writing buffer");
+      LIBBLU_ERROR_NRETURN("Error happen during writing buffer creation.\n");
+    }
+  }
+  else {
+    if (NULL == (buffer = (char *) malloc(IO_VBUF_SIZE)))
+      LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
+
+    if (setvbuf(bitStream->file, buffer, _IOFBF, IO_VBUF_SIZE) < 0) {
+      perror("Unable to set writing buffer");
+      LIBBLU_ERROR_NRETURN("Error happen during writing buffer creation.\n");
+    }
+    bitStream->buffer = buffer;
+  }
+
+  bitStream->identifier = generatedBistreamIdentifier();
 
-  if (NULL == (bitStream->file = lbc_fopen(outputFilename, "wb")))
+  return bitStream;
+}
+
+BitstreamWriterPtr createBitstreamWriter(
+  const lbc * outputFilename,
+  const size_t bufferSize
+)
+{
+  BitstreamWriterPtr bitStream;
+  FILE * file;
+
+  /* if (NULL == outputFilename)
+    LIBBLU_ERROR_NRETURN(
+      "createBitstreamWriter() expect a non-null outputFilename.\n"
+    ); */
+  assert(NULL != outputFilename);
+
+  if (NULL == (file = lbc_fopen(outputFilename, "wb")))
     LIBBLU_ERROR_NRETURN(
       "Unable to open output file '%" PRI_LBCS "', %s (errno: %d).\n",
       outputFilename,
@@ -140,14 +209,79 @@ BitstreamWriterPtr createBitstreamWriter(
       errno
     );
 
-  if (NULL == (buffer = (char *) malloc(IO_VBUF_SIZE)))
-    LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
+  if (NULL == (bitStream = initBitstreamWriter(file, bufferSize)))
+    fclose(file);
+  return bitStream;
+}
 
-  if (setvbuf(bitStream->file, buffer, _IOFBF, IO_VBUF_SIZE) < 0) {
-    perror("Unable to set writing buffer");
-    LIBBLU_ERROR_NRETURN("Error happen during writing buffer creation.\n");
+BitstreamWriterPtr createResumingBitstreamWriter(
+  const lbc * outputFilename,
+  const uint64_t offset,
+  const size_t bufferSize
+)
+{
+  BitstreamWriterPtr bitStream;
+  FILE * file;
+
+  assert(NULL != outputFilename);
+
+  if (NULL == (file = lbc_fopen(outputFilename, "rb+")))
+    LIBBLU_ERROR_NRETURN(
+      "Unable to open output file '%" PRI_LBCS "', %s (errno: %d).\n",
+      outputFilename,
+      strerror(errno),
+      errno
+    );
+
+  if (NULL == (bitStream = initBitstreamWriter(file, bufferSize))) {
+    fclose(file);
+    return NULL;
   }
-  bitStream->buffer = buffer;
+
+  if (lb_fseek(bitStream->file, (int64_t) offset, SEEK_SET) < 0) {
+    closeBitstreamWriter(bitStream);
+    LIBBLU_ERROR_NRETURN(
+      "Unable to seek output file '%" PRI_LBCS "', %s (errno: %d).\n",
+      outputFilename,
+      strerror(errno),
+      errno
+    );
+  }
+  bitStream->fileOffset = offset;
+
+  return bitStream;
+}
+
+BitstreamWriterPtr createStreamBitstreamWriter(
+  FILE * stream,
+  const size_t bufferSize
+)
+{
+  return initBitstreamWriter(stream, bufferSize);
+}
+
+BitstreamWriterPtr createNullBitstreamWriter(
+  const size_t bufferSize
+)
+{
+  BitstreamWriterPtr bitStream;
+
+  assert(32 < bufferSize);
+
+  if (NULL == (bitStream = (BitstreamWriterPtr) malloc(sizeof(BitstreamHandler))))
+    LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
+
+  if (NULL == (bitStream->byteArray = (uint8_t *) malloc(sizeof(uint8_t) * bufferSize)))
+    LIBBLU_ERROR_NRETURN("Memory allocation error.\n");
+
+  bitStream->byteArrayLength = bufferSize;
+  bitStream->byteArrayOff = 0;
+  bitStream->bitCount = 0;
+  bitStream->crcCtx = DEF_CRC_CTX();
+  bitStream->fileSize = 0;
+  bitStream->fileOffset = 0;
+  bitStream->buffer = NULL;
+  bitStream->file = NULL; /* No attached file, data is discarded. */
 
   bitStream->identifier = generatedBistreamIdentifier();
 
@@ -161,7 +295,8 @@ void closeBitstreamWriter(BitstreamWriterPtr bitStream)
 
   flushBitstreamWriter(bitStream);
   free(bitStream->byteArray);
-  fclose(bitStream->file);
+  if (NULL != bitStream->file)
+    fclose(bitStream->file);
   free(bitStream->buffer);
   free(bitStream);
 }
@@ -178,11 +313,11 @@ int fillBitstreamReader(
   readedDataLen = fread(
     bitStream->byteArray,
     sizeof(uint8_t),
-    bitStream->byteArrayLength,
+    bitStream->bufferLength,
     bitStream->file
   );
 
-  if (bitStream->byteArrayLength != readedDataLen) {
+  if (bitStream->bufferLength != readedDataLen) {
     if (ferror(bitStream->file))
       LIBBLU_ERROR_RETURN(
         "Error happen during input file reading, %s (errno: %d).\n",
@@ -193,21 +328,55 @@ int fillBitstreamReader(
     LIBBLU_DEBUG_COM(
       "Unable to completly fill input buffer, reducing its size "
       "(old: %zu, new: %zu, EOF: %s).\n",
-      bitStream->byteArrayLength,
+      bitStream->bufferLength,
       readedDataLen,
       BOOL_INFO(feof(bitStream->file))
     );
-
-    /* Not enouth data to fill entire read buffer,
-    updating buffer virtual length. */
-    bitStream->byteArrayLength = readedDataLen;
   }
+
+  /* Not enouth data may have been readed to fill entire read buffer,
+  updating buffer virtual length. */
+  bitStream->byteArrayLength = readedDataLen;
   bitStream->fileOffset = bitStream->fileOffset + readedDataLen;
   bitStream->byteArrayOff = 0;
 
   return 0;
 }
 
+void adviseBitstreamReader(
+  BitstreamReaderPtr bitStream,
+  int64_t offset,
+  int64_t length
+)
+{
+#if defined(ARCH_LINUX)
+  int ret;
+#endif
+
+  assert(NULL != bitStream);
+
+  if (offset < 0 || length <= 0)
+    return;
+
+#if defined(ARCH_LINUX)
+  ret = posix_fadvise(
+    fileno(bitStream->file),
+    (off_t) offset,
+    (off_t) length,
+    POSIX_FADV_WILLNEED
+  );
+  if (0 != ret)
+    LIBBLU_DEBUG_COM(
+      "Unable to give reading advice on 0x%" PRIX64 "-0x%" PRIX64 " "
+      "file region, %s (errno: %d).\n",
+      offset,
+      offset + length,
+      strerror(ret),
+      ret
+    );
+#endif
+}
+
 int flushBitstreamWriter(
   BitstreamWriterPtr bitStream
 )
@@ -217,12 +386,21 @@ int flushBitstreamWriter(
   if (bitStream->byteArrayOff == 0)
     return 0; /* Empty writing buffer */
 
+  if (NULL == bitStream->file) {
+    /* Null writer, discard data. */
+    bitStream->fileOffset += bitStream->byteArrayOff;
+    bitStream->byteArrayOff = 0;
+    return 0;
+  }
+
+  LIBBLU_PROFILE_START(profTimer);
   readedLen = fwrite(
     bitStream->byteArray,
     sizeof(uint8_t),
     bitStream->byteArrayOff,
     bitStream->file
   );
+  LIBBLU_PROFILE_STOP(profTimer, LIBBLU_PROF_OUTPUT_FLUSH);
 
   if (bitStream->byteArrayOff != readedLen)
     LIBBLU_ERROR_RETURN(
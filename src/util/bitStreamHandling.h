@@ -21,6 +21,7 @@
 #include "common.h"
 #include "macros.h"
 #include "messages.h"
+#include "profiling.h"
 #include "errorCodes.h"
 
 #define IO_VBUF_SIZE 1048576
@@ -169,6 +170,58 @@ static inline BitstreamReaderPtr createBitstreamWriterDefBuf(
   );
 }
 
+/** \~english
+ * \brief Creates a bitstream writing handling structure on supplied existing
+ * file, resuming writing at supplied offset.
+ *
+ * \param outputFilename Bitstream output filename.
+ * \param offset Writing resuming offset in bytes.
+ * \param bufferSize Bitstream writing buffering size (at least 32) in bytes.
+ * \return BitstreamWriterPtr On success, created object is returned.
+ * Otherwise, a NULL pointer is returned.
+ *
+ * File content is kept, data following the offset is overwritten.
+ * Created writer must be passed to #closeBitstreamWriter() after use.
+ */
+BitstreamWriterPtr createResumingBitstreamWriter(
+  const lbc * outputFilename,
+  const uint64_t offset,
+  const size_t bufferSize
+);
+
+/** \~english
+ * \brief Creates a bitstream writing handling structure on supplied opened
+ * stream.
+ *
+ * \param stream Output stream (e.g. a pipe), only written sequentially.
+ * \param bufferSize Bitstream writing buffering size (at least 32) in bytes.
+ * \return BitstreamWriterPtr On success, created object is returned.
+ * Otherwise, a NULL pointer is returned.
+ *
+ * Stream ownership is transfered to the writer, it is closed by
+ * #closeBitstreamWriter().
+ */
+BitstreamWriterPtr createStreamBitstreamWriter(
+  FILE * stream,
+  const size_t bufferSize
+);
+
+/** \~english
+ * \brief Creates a bitstream writing handling structure without attached
+ * file.
+ *
+ * \param bufferSize Bitstream writing buffering size (at least 32) in bytes.
+ * \return BitstreamWriterPtr On success, created object is returned.
+ * Otherwise, a NULL pointer is returned.
+ *
+ * Written data is discarded at each buffer flushing, only the amount of
+ * written bytes is kept (see #tellWritingPos()). Created writer must be
+ * passed to #closeBitstreamWriter() after use.
+ */
+BitstreamWriterPtr createNullBitstreamWriter(
+  const size_t bufferSize
+);
+
 /** \~english
  * \brief Destroy object and close bitstream attached writted file.
  *
@@ -265,6 +318,23 @@ int fillBitstreamReader(
   BitstreamReaderPtr bitStream
 );
 
+/** \~english
+ * \brief Announce future reading of a bitstream reader file region.
+ *
+ * \param bitStream Reading bitstream object.
+ * \param offset Region start offset in bytes.
+ * \param length Region length in bytes.
+ *
+ * Only an hint given to the operating system to prefetch data (using
+ * posix_fadvise() where available), no data is actually readed and failures
+ * are silently ignored.
+ */
+void adviseBitstreamReader(
+  BitstreamReaderPtr bitStream,
+  int64_t offset,
+  int64_t length
+);
+
 int flushBitstreamWriter(
   BitstreamWriterPtr bitStream
 );
@@ -334,8 +404,8 @@ static inline int rewindFile(
     );
 
   bitStream->fileOffset = 0x0;
-  bitStream->byteArrayOff = bitStream->bufferLength;
-  bitStream->byteArrayLength = bitStream->bufferLength;
+  bitStream->byteArrayOff = 0;
+  bitStream->byteArrayLength = 0; /* Empty byte-array window */
 
   return 0;
 }
@@ -348,6 +418,16 @@ static inline int seekPos(
 {
   assert(NULL != bitStream);
 
+  if (whence == SEEK_SET) {
+    int64_t windowOffset = bitStream->fileOffset - bitStream->byteArrayLength;
+
+    if (windowOffset <= offset && offset <= bitStream->fileOffset) {
+      /* Destination is in current byte-array buffer, no need to discard it. */
+      bitStream->byteArrayOff = offset - windowOffset;
+      return 0;
+    }
+  }
+
   if (offset == 0x0 && whence == SEEK_SET)
     return rewindFile(bitStream);
 
@@ -366,8 +446,8 @@ static inline int seekPos(
   }
 
   bitStream->fileOffset = ftell(bitStream->file);
-  bitStream->byteArrayOff = bitStream->bufferLength;
-  bitStream->byteArrayLength = bitStream->bufferLength;
+  bitStream->byteArrayOff = 0;
+  bitStream->byteArrayLength = 0; /* Empty byte-array window */
 
   return 0;
 }
@@ -389,10 +469,7 @@ static inline int nextBytes(
     perform shifting in buffer. */
 
 #if 1
-    shiftingSteps = MIN(
-      bitStream->byteArrayLength - bitStream->byteArrayOff,
-      bitStream->byteArrayOff
-    );
+    shiftingSteps = bitStream->byteArrayLength - bitStream->byteArrayOff;
 
     memmove(
       bitStream->byteArray,
@@ -404,13 +481,12 @@ static inline int nextBytes(
     readedDataLen = fread(
       bitStream->byteArray + shiftingSteps,
       sizeof(uint8_t),
-      bitStream->byteArrayLength - shiftingSteps,
+      bitStream->bufferLength - shiftingSteps,
       bitStream->file
     );
+    bitStream->byteArrayLength = shiftingSteps + readedDataLen;
 
-    if (readedDataLen != bitStream->byteArrayLength - shiftingSteps) {
-      bitStream->byteArrayLength = shiftingSteps + readedDataLen;
-
+    if (readedDataLen != bitStream->bufferLength - shiftingSteps) {
       if (ferror(bitStream->file)) {
         perror("Reading error");
         LIBBLU_ERROR_RETURN(
@@ -767,14 +843,69 @@ static inline int readByte(
 static inline int readBytes(
   BitstreamReaderPtr bitStream,
   uint8_t * data,
-  const size_t dataLen
+  size_t dataLen
 )
 {
-  size_t i;
+  if (bitStream->bitCount != 8 || IN_USE_BITSTREAM_CRC(bitStream)) {
+    /* Bit-level or CRC computed reading, byte-per-byte operation. */
+    size_t i;
 
-  for (i = 0; i < dataLen; i++) {
-    if (readByte(bitStream, data++) < 0)
-      return -1;
+    for (i = 0; i < dataLen; i++) {
+      if (readByte(bitStream, (NULL != data) ? data + i : NULL) < 0)
+        return -1;
+    }
+
+    return 0;
+  }
+
+  while (0 < dataLen) {
+    size_t copiedSize;
+
+    if (bitStream->byteArrayLength <= bitStream->byteArrayOff) {
+      if (NULL != data && bitStream->bufferLength <= dataLen) {
+        /* Large request, read directly into destination
+        (avoiding the copy through the byte-array buffer). */
+        size_t readedDataLen = fread(
+          data, sizeof(uint8_t), dataLen, bitStream->file
+        );
+
+        bitStream->fileOffset += readedDataLen;
+        bitStream->byteArrayOff = 0;
+        bitStream->byteArrayLength = 0;
+
+        if (readedDataLen != dataLen) {
+          if (ferror(bitStream->file))
+            LIBBLU_ERROR_RETURN(
+              "Error happen during input file reading, %s (errno: %d).\n",
+              strerror(errno),
+              errno
+            );
+          LIBBLU_ERROR_RETURN(
+            "Unable to read bytes, prematurate end of file reached.\n"
+          );
+        }
+        return 0;
+      }
+
+      if (fillBitstreamReader(bitStream) < 0)
+        return -1;
+      if (!bitStream->byteArrayLength)
+        LIBBLU_ERROR_RETURN(
+          "Unable to read bytes, prematurate end of file reached.\n"
+        );
+    }
+
+    copiedSize = MIN(
+      dataLen,
+      bitStream->byteArrayLength - bitStream->byteArrayOff
+    );
+
+    if (NULL != data) {
+      memcpy(data, bitStream->byteArray + bitStream->byteArrayOff, copiedSize);
+      data += copiedSize;
+    }
+    bitStream->byteArrayOff += copiedSize;
+    dataLen -= copiedSize;
   }
 
   return 0;
@@ -861,11 +992,24 @@ static inline int skipBytes(
   size_t length
 )
 {
-  while (0 < (length--))
-    if (readByte(bitStream, NULL) < 0)
-      return -1;
+  int64_t dstOffset;
 
-  return 0;
+  if (bitStream->bitCount != 8 || IN_USE_BITSTREAM_CRC(bitStream)) {
+    while (0 < (length--))
+      if (readByte(bitStream, NULL) < 0)
+        return -1;
+
+    return 0;
+  }
+
+  /* Byte aligned without CRC, skipped bytes does not need to be readed. */
+  dstOffset = tellPos(bitStream) + length;
+  if (bitStream->fileSize < dstOffset)
+    LIBBLU_ERROR_RETURN(
+      "Unable to skip bytes, prematurate end of file reached.\n"
+    );
+
+  return seekPos(bitStream, dstOffset, SEEK_SET);
 }
 
 static inline int paddingByte(
@@ -931,26 +1075,67 @@ static inline int writeByte(
 static inline int writeBytes(
   BitstreamWriterPtr bitStream,
   const uint8_t * data,
-  const size_t dataLen
+  size_t dataLen
 )
 {
-  size_t i;
-
   assert(NULL != bitStream);
   assert(NULL != data);
 
-  for (i = 0; i < dataLen; i++) {
+  while (0 < dataLen) {
+    size_t copiedSize;
+
     if (bitStream->byteArrayOff >= bitStream->byteArrayLength) {
       if (flushBitstreamWriter(bitStream) < 0)
         return -1;
     }
 
-    bitStream->byteArray[bitStream->byteArrayOff++] = data[i];
+    copiedSize = MIN(
+      dataLen,
+      bitStream->byteArrayLength - bitStream->byteArrayOff
+    );
+
+    memcpy(bitStream->byteArray + bitStream->byteArrayOff, data, copiedSize);
+    bitStream->byteArrayOff += copiedSize;
+    data += copiedSize;
+    dataLen -= copiedSize;
   }
 
   return 0;
 }
 
+/** \~english
+ * \brief Reserve a contiguous area in writing buffer.
+ *
+ * \param bitStream Destination bitstream.
+ * \param size Size of the reserved area in bytes (shall not exceed writing
+ * buffer size).
+ * \return uint8_t* Upon success, a pointer to the reserved area is returned.
+ * This area is considered as written and must be completely filled by caller
+ * before any other writing operation. Otherwise, a NULL pointer is returned.
+ *
+ * Allows to build data directly in output buffer, without intermediate copy.
+ */
+static inline uint8_t * reserveBytesBitstreamWriter(
+  BitstreamWriterPtr bitStream,
+  size_t size
+)
+{
+  uint8_t * area;
+
+  assert(NULL != bitStream);
+  assert(size <= bitStream->byteArrayLength);
+
+  if (bitStream->byteArrayLength - bitStream->byteArrayOff < size) {
+    if (flushBitstreamWriter(bitStream) < 0)
+      return NULL;
+  }
+
+  area = bitStream->byteArray + bitStream->byteArrayOff;
+  bitStream->byteArrayOff += size;
+
+  return area;
+}
+
 static inline int writeUint64(
   BitstreamWriterPtr bitStream,
   uint64_t value
@@ -1,3 +1,8 @@
+#if defined(__linux__)
+   /* Required for fdopen() and clock_gettime() */
+#  define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
@@ -296,8 +301,62 @@ free_return:
 
 #include <errno.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
+FILE * lb_detach_stdout(
+  void
+)
+{
+  FILE * stream;
+  int fd;
+
+  fflush(stdout);
+  if ((fd = dup(STDOUT_FILENO)) < 0)
+    goto free_return;
+  if (dup2(STDERR_FILENO, STDOUT_FILENO) < 0)
+    goto free_return;
+  if (NULL == (stream = fdopen(fd, "wb")))
+    goto free_return;
+
+  return stream;
+
+free_return:
+  LIBBLU_ERROR_NRETURN(
+    "Unable to detach standard output, %s (errno: %d).\n",
+    strerror(errno),
+    errno
+  );
+}
+
+int lb_get_monotonic_time(
+  double * time
+)
+{
+  struct timespec ts;
+
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Unable to get monotonic clock value, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+  *time = ts.tv_sec + ts.tv_nsec / 1e9;
+
+  return 0;
+}
+
+unsigned lb_get_nb_processors(
+  void
+)
+{
+  long nb;
+
+  if ((nb = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+    return 1;
+  return (unsigned) nb;
+}
+
 int lb_get_wd(
   char * buf,
   size_t size
@@ -321,6 +380,62 @@ int lb_get_wd(
 
 #elif defined(ARCH_WIN32)
 
+#include <errno.h>
+#include <io.h>
+#include <fcntl.h>
+
+FILE * lb_detach_stdout(
+  void
+)
+{
+  FILE * stream;
+  int fd;
+
+  fflush(stdout);
+  if ((fd = _dup(_fileno(stdout))) < 0)
+    goto free_return;
+  if (_dup2(_fileno(stderr), _fileno(stdout)) < 0)
+    goto free_return;
+  if (_setmode(fd, _O_BINARY) < 0)
+    goto free_return;
+  if (NULL == (stream = _fdopen(fd, "wb")))
+    goto free_return;
+
+  return stream;
+
+free_return:
+  LIBBLU_ERROR_NRETURN(
+    "Unable to detach standard output, %s (errno: %d).\n",
+    strerror(errno),
+    errno
+  );
+}
+
+int lb_get_monotonic_time(
+  double * time
+)
+{
+  LARGE_INTEGER freq, counter;
+
+  if (!QueryPerformanceFrequency(&freq) || !QueryPerformanceCounter(&counter))
+    LIBBLU_ERROR_RETURN("Unable to get monotonic clock value.\n");
+  *time = (double) counter.QuadPart / freq.QuadPart;
+
+  return 0;
+}
+
+unsigned lb_get_nb_processors(
+  void
+)
+{
+  SYSTEM_INFO info;
+
+  GetSystemInfo(&info);
+  if (info.dwNumberOfProcessors < 1)
+    return 1;
+  return (unsigned) info.dwNumberOfProcessors;
+}
+
 int lb_get_wd(
   char * buf,
   size_t size
@@ -382,5 +497,5 @@ int lb_wget_wd(
 }
 
 #else
-#  error No portable implementation of lb_get_wd() for this system.
+#  error No portable implementation of lb_get_wd(), lb_detach_stdout() and lb_get_monotonic_time() for this system.
 #endif
\ No newline at end of file
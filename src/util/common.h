@@ -51,28 +51,77 @@ int lb_close_iconv(
 
 #endif
 
-static inline uint32_t fnv1aStrHash(
-  const char * key
+/** \~english
+ * \brief 32 bits FNV-1a hash initial value (offset basis).
+ */
+#define FNV1A_32_OFFSET_BASIS  2166136261u
+
+/** \~english
+ * \brief 64 bits FNV-1a hash initial value (offset basis).
+ */
+#define FNV1A_64_OFFSET_BASIS  UINT64_C(0xCBF29CE484222325)
+
+/** \~english
+ * \brief Update a 32 bits FNV-1a hash with a data buffer.
+ *
+ * \param hash Current hash value, FNV1A_32_OFFSET_BASIS to start a new one.
+ * \param data Hashed data.
+ * \param size Size of hashed data in bytes.
+ * \return uint32_t Updated hash value.
+ */
+static inline uint32_t fnv1aBufHash(
+  uint32_t hash,
+  const void * data,
+  size_t size
 )
 {
-  /* 32 bits FNV-1a hash */
-  size_t length, i;
-  uint32_t hash;
+  const uint8_t * bytes = (const uint8_t *) data;
+  size_t i;
 
-  if (NULL == key)
-    return 0;
+  for (i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
 
-  length = strlen(key);
+  return hash;
+}
 
-  hash = 2166136261u;
-  for (i = 0; i < length; i++) {
-    hash ^= ((uint8_t *) key)[i];
-    hash *= 16777619;
+/** \~english
+ * \brief Update a 64 bits FNV-1a hash with a data buffer.
+ *
+ * \param hash Current hash value, FNV1A_64_OFFSET_BASIS to start a new one.
+ * \param data Hashed data.
+ * \param size Size of hashed data in bytes.
+ * \return uint64_t Updated hash value.
+ */
+static inline uint64_t fnv1a64BufHash(
+  uint64_t hash,
+  const void * data,
+  size_t size
+)
+{
+  const uint8_t * bytes = (const uint8_t *) data;
+  size_t i;
+
+  for (i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= UINT64_C(0x100000001B3);
   }
 
   return hash;
 }
 
+static inline uint32_t fnv1aStrHash(
+  const char * key
+)
+{
+  /* 32 bits FNV-1a hash */
+  if (NULL == key)
+    return 0;
+
+  return fnv1aBufHash(FNV1A_32_OFFSET_BASIS, key, strlen(key));
+}
+
 #if defined(ARCH_WIN32)
 
 static inline uint32_t wfnv1aStrHash(
@@ -80,25 +129,12 @@ static inline uint32_t wfnv1aStrHash(
 )
 {
   /* 32 bits FNV-1a hash */
-  size_t length, i;
-  uint32_t hash;
-
   if (NULL == key)
     return 0;
 
-  length = wcslen(key);
-
-  hash = 2166136261u;
-  for (i = 0; i < length; i++) {
-    size_t j;
-
-    for (j = 0; j < sizeof(wchar_t); j++) {
-      hash ^= ((uint8_t *) (key + i))[j];
-      hash *= 16777619;
-    }
-  }
-
-  return hash;
+  return fnv1aBufHash(
+    FNV1A_32_OFFSET_BASIS, key, wcslen(key) * sizeof(wchar_t)
+  );
 }
 
 #endif
@@ -225,6 +261,49 @@ static inline bool lb_data_equal(
   return 0 == memcmp(dat1, dat2, size);
 }
 
+/** \~english
+ * \brief Write a value as a big-endian field.
+ *
+ * \param dst Destination array, at least size bytes long.
+ * \param value Written value, truncated to size bytes.
+ * \param size Field size in bytes (up to 8).
+ */
+static inline void lb_put_be_value(
+  uint8_t * dst,
+  uint64_t value,
+  unsigned size
+)
+{
+  unsigned i;
+
+  assert(size <= 8);
+
+  for (i = 0; i < size; i++)
+    dst[i] = (value >> (8 * (size - i - 1))) & 0xFF;
+}
+
+/** \~english
+ * \brief Read a big-endian field value.
+ *
+ * \param src Source array, at least size bytes long.
+ * \param size Field size in bytes (up to 8).
+ * \return uint64_t Field value.
+ */
+static inline uint64_t lb_get_be_value(
+  const uint8_t * src,
+  unsigned size
+)
+{
+  uint64_t value;
+  unsigned i;
+
+  assert(size <= 8);
+
+  for (value = 0, i = 0; i < size; i++)
+    value = (value << 8) | src[i];
+  return value;
+}
+
 static inline void lb_str_cat(
   char ** dst,
   const char * src
@@ -488,6 +567,40 @@ static inline uint32_t lb_compute_crc32(
   return crc;
 }
 
+/** \~english
+ * \brief Detach the standard output from program messages.
+ *
+ * \return FILE* Upon success, a binary stream writing on the original
+ * standard output is returned and the program standard output is redirected
+ * to the standard error. Otherwise, a NULL pointer is returned.
+ *
+ * Used to write binary data on standard output without interleaving of
+ * program messages.
+ */
+FILE * lb_detach_stdout(
+  void
+);
+
+/** \~english
+ * \brief Get the current value of a monotonic wall-clock.
+ *
+ * \param time Destination time, in seconds from an unspecified origin.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int lb_get_monotonic_time(
+  double * time
+);
+
+/** \~english
+ * \brief Get the number of online processors.
+ *
+ * \return unsigned Number of processors available, at least one.
+ */
+unsigned lb_get_nb_processors(
+  void
+);
+
 /** \~english
  * \brief
  *
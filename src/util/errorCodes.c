@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdarg.h>
@@ -6,6 +7,10 @@
 #include <ctype.h>
 #include <assert.h>
 
+#if !defined(DISABLE_THREADS)
+#  include <pthread.h>
+#endif
+
 #include "errorCodes.h"
 
 static const struct {
@@ -365,12 +370,132 @@ void echoMessageFdVa(
     lbc_vfprintf(fd, format, args);
 }
 
+/* ### Messages buffering : ################################################ */
+
+#define LIBBLU_MESSAGES_BUFFER_MSG_SIZE  1024
+
+#if !defined(DISABLE_THREADS)
+static pthread_key_t messagesBufferKey;
+static pthread_once_t messagesBufferKeyOnce = PTHREAD_ONCE_INIT;
+
+static void createMessagesBufferKey(
+  void
+)
+{
+  pthread_key_create(&messagesBufferKey, NULL);
+}
+
+void setMessagesBufferLibblu(
+  LibbluMessagesBuffer * buf
+)
+{
+  pthread_once(&messagesBufferKeyOnce, createMessagesBufferKey);
+  pthread_setspecific(messagesBufferKey, buf);
+}
+
+static LibbluMessagesBuffer * getMessagesBuffer(
+  void
+)
+{
+  pthread_once(&messagesBufferKeyOnce, createMessagesBufferKey);
+  return (LibbluMessagesBuffer *) pthread_getspecific(messagesBufferKey);
+}
+#else
+static LibbluMessagesBuffer * messagesBuffer = NULL;
+
+void setMessagesBufferLibblu(
+  LibbluMessagesBuffer * buf
+)
+{
+  messagesBuffer = buf;
+}
+
+static LibbluMessagesBuffer * getMessagesBuffer(
+  void
+)
+{
+  return messagesBuffer;
+}
+#endif
+
+static int appendMessagesBuffer(
+  LibbluMessagesBuffer * buf,
+  LibbluStatus status,
+  const lbc * format,
+  va_list args
+)
+{
+  lbc message[LIBBLU_MESSAGES_BUFFER_MSG_SIZE];
+  size_t size;
+  lbc * copy;
+
+  if (buf->nbAllocatedEntries <= buf->nbEntries) {
+    unsigned newLength;
+    void * newArray;
+
+    newLength = GROW_ALLOCATION(buf->nbAllocatedEntries, 8);
+    newArray = realloc(buf->entries, newLength * sizeof(*buf->entries));
+    if (NULL == newArray)
+      return -1;
+
+    buf->entries = newArray;
+    buf->nbAllocatedEntries = newLength;
+  }
+
+  /* Messages exceeding buffer size are truncated. */
+  lbc_vsnprintf(message, LIBBLU_MESSAGES_BUFFER_MSG_SIZE, format, args);
+  message[LIBBLU_MESSAGES_BUFFER_MSG_SIZE - 1] = lbc_char('\0');
+
+  size = (lbc_strlen(message) + 1) * sizeof(lbc);
+  if (NULL == (copy = (lbc *) malloc(size)))
+    return -1;
+  memcpy(copy, message, size);
+
+  buf->entries[buf->nbEntries].status = status;
+  buf->entries[buf->nbEntries].message = copy;
+  buf->nbEntries++;
+
+  return 0;
+}
+
+void printLibbluMessagesBuffer(
+  const LibbluMessagesBuffer * buf
+)
+{
+  unsigned i;
+
+  assert(NULL != buf);
+
+  for (i = 0; i < buf->nbEntries; i++)
+    echoMessage(
+      buf->entries[i].status,
+      lbc_str("%" PRI_LBCS),
+      buf->entries[i].message
+    );
+}
+
+/* ### Messages echoing : ################################################## */
+
 void echoMessageVa(
   LibbluStatus status,
   const lbc * format,
   va_list args
 )
 {
+  LibbluMessagesBuffer * buf = getMessagesBuffer();
+
+  if (NULL != buf && (status < LIBBLU_DEBUG_GLB || enabledStatus[status])) {
+    va_list argsCopy;
+    int ret;
+
+    va_copy(argsCopy, args);
+    ret = appendMessagesBuffer(buf, status, format, argsCopy);
+    va_end(argsCopy);
+    if (0 <= ret)
+      return;
+    /* Unable to buffer, message is printed directly. */
+  }
+
   if (LIBBLU_FATAL_ERROR <= status)
     echoMessageFdVa(stderr, status, format, args);
   else
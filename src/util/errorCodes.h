@@ -12,6 +12,8 @@
 
 #include "macros.h"
 
+#include <stdlib.h>
+
 #define LIBBLU_ECHO(status, format, ...)                                      \
   echoMessage(status, lbc_str(format), ##__VA_ARGS__)
 
@@ -197,6 +199,62 @@ void echoMessage(
   ...
 );
 
+/** \~english
+ * \brief Buffered messages.
+ *
+ * Used to keep messages echoed by a worker thread, printed afterwards
+ * without interleaving with other threads ones.
+ */
+typedef struct {
+  struct {
+    LibbluStatus status;
+    lbc * message;
+  } * entries;
+
+  unsigned nbEntries;
+  unsigned nbAllocatedEntries;
+} LibbluMessagesBuffer;
+
+static inline void initLibbluMessagesBuffer(
+  LibbluMessagesBuffer * dst
+)
+{
+  *dst = (LibbluMessagesBuffer) {
+    .entries = NULL
+  };
+}
+
+static inline void cleanLibbluMessagesBuffer(
+  LibbluMessagesBuffer buf
+)
+{
+  unsigned i;
+
+  for (i = 0; i < buf.nbEntries; i++)
+    free(buf.entries[i].message);
+  free(buf.entries);
+}
+
+/** \~english
+ * \brief Redirect messages echoed by the calling thread.
+ *
+ * \param buf Destination buffer, or NULL to restore direct printing.
+ *
+ * Messages are buffered only if they would have been printed.
+ */
+void setMessagesBufferLibblu(
+  LibbluMessagesBuffer * buf
+);
+
+/** \~english
+ * \brief Print buffered messages in their echoing order.
+ *
+ * \param buf Printed buffer.
+ */
+void printLibbluMessagesBuffer(
+  const LibbluMessagesBuffer * buf
+);
+
 void printListLibbbluStatus(
   unsigned indent
 );
@@ -56,6 +56,7 @@ void setFunHashTable(
     datFreeFun = free;
 
   table->keyHashFun = keyHashFun;
+  table->keyCompFun = keyCompFun;
   table->datFreeFun = datFreeFun;
 }
 
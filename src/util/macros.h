@@ -64,6 +64,15 @@
 #  error "Unknown architecture"
 #endif
 
+/* 64 bits file offsets : */
+#if defined(ARCH_WIN32)
+#  define lb_fseek  _fseeki64
+#  define lb_ftell  _ftelli64
+#else
+#  define lb_fseek  fseek
+#  define lb_ftell  ftell
+#endif
+
 
 /* Fields sizes : */
 
@@ -96,6 +105,7 @@
 #  define lbc_asprintf(s, format, ...)                                        \
   lb_wasprintf(s, lbc_str(format), ##__VA_ARGS__)
 #  define lbc_vfprintf  vfwprintf
+#  define lbc_vsnprintf  vsnwprintf
 #  define lbc_deb_printf  wprintf
 
 #  define lbc_strlen  wcslen
@@ -118,6 +128,8 @@
 #  define lbc_getwd  lb_wget_wd
 #  define lbc_access_fp(f, m)                                                 \
   lb_waccess_fp(f, lbc_str(m))
+#  define lbc_remove  _wremove
+#  define lbc_rename  _wrename
 
 #  define lbc_fnv1aStrHash wfnv1aStrHash
 
@@ -158,6 +170,7 @@
 #  define lbc_snprintf  snprintf
 #  define lbc_asprintf  lb_asprintf
 #  define lbc_vfprintf vfprintf
+#  define lbc_vsnprintf  vsnprintf
 #  define lbc_deb_printf  printf
 
 #  define lbc_strlen  strlen
@@ -178,6 +191,8 @@
 #  define lbc_chdir  chdir
 #  define lbc_getwd  lb_get_wd
 #  define lbc_access_fp  lb_access_fp
+#  define lbc_remove  remove
+#  define lbc_rename  rename
 
 #  define lbc_fnv1aStrHash fnv1aStrHash
 
@@ -473,9 +488,10 @@
  * size difference is greater than #DIFF_TRIGGER_REALLOC_OPTIMIZATION
  * bytes, minimizing memory usage at cost of memory reallocations.
  *
- * This parameter is enabled by default.
+ * This parameter is disabled by default (avoiding reallocations of the PES
+ * buffers while muxing variable bitrate streams).
  */
-#define USE_OPTIMIZED_REALLOCATION                                            1
+#define USE_OPTIMIZED_REALLOCATION                                            0
 
 /** \~english
  * \brief Allows alternative optimized bit per bit file reading.
@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "profiling.h"
+
+#if !defined(DISABLE_PROFILING)
+
+bool libbluProfilingEnabled = false;
+LibbluProfilingCounter libbluProfilingCounters[LIBBLU_PROF_NB_PHASES];
+
+static bool profilingRequested = false;
+static uint64_t profilingStartTimer;
+static double profilingStartTime;
+
+static const char * phaseNames[LIBBLU_PROF_NB_PHASES] = {
+  "esms_parsing",
+  "payload_reads",
+  "pes_assembly",
+  "ts_packets",
+  "t_std",
+  "heap",
+  "output_flush"
+};
+
+static const char * phaseLabels[LIBBLU_PROF_NB_PHASES] = {
+  "ESMS parsing",
+  "Payload reads",
+  "PES assembly",
+  "TS packetisation",
+  "T-STD check/update",
+  "Heap operations",
+  "Output flushes"
+};
+
+uint64_t readClockLibbluProfiling(
+  void
+)
+{
+  double time;
+
+  if (lb_get_monotonic_time(&time) < 0)
+    return 0;
+  return (uint64_t) (time * 1e9);
+}
+
+int enableLibbluProfiling(
+  void
+)
+{
+  profilingRequested = true;
+  return 0;
+}
+
+bool isEnabledLibbluProfiling(
+  void
+)
+{
+  return profilingRequested;
+}
+
+int startLibbluProfiling(
+  void
+)
+{
+  memset(libbluProfilingCounters, 0, sizeof(libbluProfilingCounters));
+
+  profilingStartTimer = readTimerLibbluProfiling();
+  if (lb_get_monotonic_time(&profilingStartTime) < 0)
+    return -1;
+
+  /* Counters are only updated during the profiled period. */
+  libbluProfilingEnabled = true;
+  return 0;
+}
+
+void stopLibbluProfiling(
+  void
+)
+{
+  libbluProfilingEnabled = false;
+}
+
+static int writeJsonLibbluProfiling(
+  const lbc * filepath,
+  double elapsed,
+  double ticksPerSecond
+)
+{
+  FILE * file;
+  unsigned i;
+
+  if (NULL == (file = lbc_fopen(filepath, "w")))
+    LIBBLU_ERROR_RETURN(
+      "Unable to open profiling output file '%" PRI_LBCS "', "
+      "%s (errno: %d).\n",
+      filepath,
+      strerror(errno),
+      errno
+    );
+
+  fprintf(file, "{\n");
+#if defined(LIBBLU_PROFILING_USE_TSC)
+  fprintf(file, "  \"timer\": \"tsc\",\n");
+#else
+  fprintf(file, "  \"timer\": \"monotonic\",\n");
+#endif
+  fprintf(file, "  \"elapsed_seconds\": %.6f,\n", elapsed);
+  fprintf(file, "  \"phases\": [\n");
+  for (i = 0; i < LIBBLU_PROF_NB_PHASES; i++) {
+    fprintf(
+      file,
+      "    {\"name\": \"%s\", \"calls\": %" PRIu64 ", "
+      "\"seconds\": %.6f}%s\n",
+      phaseNames[i],
+      libbluProfilingCounters[i].calls,
+      libbluProfilingCounters[i].ticks / ticksPerSecond,
+      (i + 1 < LIBBLU_PROF_NB_PHASES) ? "," : ""
+    );
+  }
+  fprintf(file, "  ]\n");
+  fprintf(file, "}\n");
+
+  if (fclose(file) < 0)
+    LIBBLU_ERROR_RETURN(
+      "Unable to write profiling output file, %s (errno: %d).\n",
+      strerror(errno),
+      errno
+    );
+
+  return 0;
+}
+
+int reportLibbluProfiling(
+  const lbc * jsonFilepath
+)
+{
+  uint64_t elapsedTicks;
+  double endTime, elapsed, ticksPerSecond;
+  unsigned i;
+
+  stopLibbluProfiling();
+
+  elapsedTicks = readTimerLibbluProfiling() - profilingStartTimer;
+  if (lb_get_monotonic_time(&endTime) < 0)
+    return -1;
+  elapsed = endTime - profilingStartTime;
+
+  /* Timer calibration against wall-clock */
+  ticksPerSecond = (0 < elapsed && 0 < elapsedTicks) ? elapsedTicks / elapsed : 1e9;
+
+  lbc_printf("== Profiling summary ==================================================================\n");
+  lbc_printf(
+    "Profiled period: %.3f s (nested phases are included in their parent).\n",
+    elapsed
+  );
+  for (i = 0; i < LIBBLU_PROF_NB_PHASES; i++) {
+    double seconds = libbluProfilingCounters[i].ticks / ticksPerSecond;
+    uint64_t calls = libbluProfilingCounters[i].calls;
+
+    lbc_printf(
+      " - %-20s: %10.3f ms (%5.1f%%), %10" PRIu64 " calls, %8.1f ns/call;\n",
+      phaseLabels[i],
+      seconds * 1e3,
+      (0 < elapsed) ? seconds / elapsed * 100 : 0.0,
+      calls,
+      (0 < calls) ? seconds / calls * 1e9 : 0.0
+    );
+  }
+
+  if (NULL != jsonFilepath) {
+    if (writeJsonLibbluProfiling(jsonFilepath, elapsed, ticksPerSecond) < 0)
+      return -1;
+  }
+
+  return 0;
+}
+
+#else
+
+int enableLibbluProfiling(
+  void
+)
+{
+  LIBBLU_ERROR_RETURN("Profiling unsupported in this build.\n");
+}
+
+bool isEnabledLibbluProfiling(
+  void
+)
+{
+  return false;
+}
+
+int startLibbluProfiling(
+  void
+)
+{
+  return 0;
+}
+
+void stopLibbluProfiling(
+  void
+)
+{
+}
+
+int reportLibbluProfiling(
+  const lbc * jsonFilepath
+)
+{
+  (void) jsonFilepath;
+  return 0;
+}
+
+#endif
@@ -0,0 +1,153 @@
+/** \~english
+ * \file profiling.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Muxing hot-path profiling counters.
+ *
+ * Time spent in each main muxing phase is accumulated using a cycle
+ * counter (TSC on x86, monotonic clock otherwise), converted to seconds
+ * by calibration against the wall-clock over the profiled period.
+ * Counters are only updated when profiling is enabled at runtime
+ * (--profile) and are entirely removed from build if DISABLE_PROFILING is
+ * defined. Counters are not thread-safe, the profiled period shall only
+ * cover single-threaded muxing.
+ */
+
+#ifndef __LIBBLU_MUXER__UTIL__PROFILING_H__
+#define __LIBBLU_MUXER__UTIL__PROFILING_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "macros.h"
+
+#if !defined(DISABLE_PROFILING) && (defined(__x86_64__) || defined(__i386__))
+#  include <x86intrin.h>
+#  define LIBBLU_PROFILING_USE_TSC
+#endif
+
+/** \~english
+ * \brief Profiled muxing phases.
+ *
+ * Phases may be nested, e.g. payload reads are part of the PES assembly
+ * and output flushes part of the TS packetisation.
+ */
+typedef enum {
+  LIBBLU_PROF_ESMS_PARSING,    /**< ESMS PES packets script parsing.        */
+  LIBBLU_PROF_PAYLOAD_READS,   /**< PES payloads reading from sources.      */
+  LIBBLU_PROF_PES_ASSEMBLY,    /**< PES packets data building.              */
+  LIBBLU_PROF_TS_PACKETS,      /**< Transport packets writing.              */
+  LIBBLU_PROF_T_STD,           /**< T-STD buffering model check/update.     */
+  LIBBLU_PROF_HEAP,            /**< Streams timing heaps operations.        */
+  LIBBLU_PROF_OUTPUT_FLUSH,    /**< Writing buffers flushes.                */
+
+  LIBBLU_PROF_NB_PHASES
+} LibbluProfilingPhase;
+
+#if !defined(DISABLE_PROFILING)
+
+typedef struct {
+  uint64_t ticks;  /**< Accumulated timer ticks.                            */
+  uint64_t calls;  /**< Number of profiled calls.                           */
+} LibbluProfilingCounter;
+
+extern bool libbluProfilingEnabled;
+extern LibbluProfilingCounter libbluProfilingCounters[LIBBLU_PROF_NB_PHASES];
+
+uint64_t readClockLibbluProfiling(
+  void
+);
+
+static inline uint64_t readTimerLibbluProfiling(
+  void
+)
+{
+#if defined(LIBBLU_PROFILING_USE_TSC)
+  return __rdtsc();
+#else
+  return readClockLibbluProfiling();
+#endif
+}
+
+static inline void addLibbluProfiling(
+  LibbluProfilingPhase phase,
+  uint64_t startTimer
+)
+{
+  libbluProfilingCounters[phase].ticks += readTimerLibbluProfiling() - startTimer;
+  libbluProfilingCounters[phase].calls++;
+}
+
+/** \~english
+ * \brief Start the timing of a profiled phase, declaring a timer variable.
+ */
+#  define LIBBLU_PROFILE_START(timer)                                         \
+  uint64_t timer = (libbluProfilingEnabled) ? readTimerLibbluProfiling() : 0
+
+/** \~english
+ * \brief Stop the timing of a profiled phase started with
+ * #LIBBLU_PROFILE_START().
+ */
+#  define LIBBLU_PROFILE_STOP(timer, phase)                                   \
+  do {                                                                        \
+    if (libbluProfilingEnabled)                                               \
+      addLibbluProfiling(phase, timer);                                       \
+  } while (0)
+
+#else
+
+#  define LIBBLU_PROFILE_START(timer)
+#  define LIBBLU_PROFILE_STOP(timer, phase)  do {} while (0)
+
+#endif
+
+/** \~english
+ * \brief Enable profiling.
+ *
+ * \return int Upon success, a zero value is returned. Otherwise, if
+ * profiling is not available in this build, a negative value is returned.
+ */
+int enableLibbluProfiling(
+  void
+);
+
+bool isEnabledLibbluProfiling(
+  void
+);
+
+/** \~english
+ * \brief Reset counters and start the profiled period.
+ *
+ * Counters are updated from this call up to reportLibbluProfiling().
+ *
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int startLibbluProfiling(
+  void
+);
+
+/** \~english
+ * \brief End the profiled period without reporting, counters are no longer
+ * updated.
+ */
+void stopLibbluProfiling(
+  void
+);
+
+/** \~english
+ * \brief End the profiled period, print the profiling summary and write
+ * the JSON summary if requested.
+ *
+ * \param jsonFilepath Optional JSON summary output filepath (may be NULL).
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int reportLibbluProfiling(
+  const lbc * jsonFilepath
+);
+
+#endif
@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "tasksPool.h"
+
+/** \~english
+ * \brief Maximum number of threads used by a tasks pool.
+ */
+#define TASKS_POOL_MAX_NB_THREADS  64
+
+static int processSequentiallyTasksPool(
+  TasksPoolFun fun,
+  void * arg,
+  unsigned nbTasks
+)
+{
+  unsigned i;
+
+  for (i = 0; i < nbTasks; i++) {
+    if (fun(arg, i) < 0)
+      return -1;
+  }
+
+  return 0;
+}
+
+#if !defined(DISABLE_THREADS)
+
+typedef struct {
+  TasksPoolFun fun;
+  void * arg;
+  unsigned nbTasks;
+
+  pthread_mutex_t mutex;
+  unsigned nextTask;  /**< Next task to dispatch.                            */
+  bool failed;        /**< A task failed, no more task is dispatched.        */
+} TasksPool;
+
+static void * workerTasksPool(
+  void * poolPtr
+)
+{
+  TasksPool * pool = (TasksPool *) poolPtr;
+
+  for (;;) {
+    unsigned taskIdx;
+
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->failed || pool->nbTasks <= pool->nextTask) {
+      pthread_mutex_unlock(&pool->mutex);
+      break;
+    }
+    taskIdx = pool->nextTask++;
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (pool->fun(pool->arg, taskIdx) < 0) {
+      pthread_mutex_lock(&pool->mutex);
+      pool->failed = true;
+      pthread_mutex_unlock(&pool->mutex);
+    }
+  }
+
+  return NULL;
+}
+
+int processTasksPool(
+  TasksPoolFun fun,
+  void * arg,
+  unsigned nbTasks,
+  unsigned nbThreads
+)
+{
+  pthread_t threads[TASKS_POOL_MAX_NB_THREADS];
+  unsigned nbStartedThreads, i;
+  TasksPool pool;
+
+  assert(NULL != fun);
+
+  if (0 == nbThreads)
+    nbThreads = lb_get_nb_processors();
+  nbThreads = MIN(MIN(nbThreads, nbTasks), TASKS_POOL_MAX_NB_THREADS);
+
+  if (nbThreads <= 1)
+    return processSequentiallyTasksPool(fun, arg, nbTasks);
+
+  pool = (TasksPool) {
+    .fun = fun,
+    .arg = arg,
+    .nbTasks = nbTasks
+  };
+  if (0 != pthread_mutex_init(&pool.mutex, NULL))
+    return processSequentiallyTasksPool(fun, arg, nbTasks);
+
+  /* The calling thread is one of the workers */
+  for (nbStartedThreads = 0; nbStartedThreads < nbThreads - 1; ) {
+    pthread_t * thread = &threads[nbStartedThreads];
+
+    if (0 != pthread_create(thread, NULL, workerTasksPool, &pool))
+      break; /* Continue with already started threads */
+    nbStartedThreads++;
+  }
+
+  workerTasksPool(&pool);
+
+  for (i = 0; i < nbStartedThreads; i++)
+    pthread_join(threads[i], NULL);
+  pthread_mutex_destroy(&pool.mutex);
+
+  return (pool.failed) ? -1 : 0;
+}
+
+#else
+
+int processTasksPool(
+  TasksPoolFun fun,
+  void * arg,
+  unsigned nbTasks,
+  unsigned nbThreads
+)
+{
+  assert(NULL != fun);
+  (void) nbThreads;
+
+  return processSequentiallyTasksPool(fun, arg, nbTasks);
+}
+
+#endif
+
+/* ### Tasks progression : ################################################# */
+
+int initTasksPoolProgress(
+  TasksPoolProgress * progress,
+  unsigned nbTasks
+)
+{
+  assert(NULL != progress);
+
+  *progress = (TasksPoolProgress) {
+    .nbTasks = nbTasks
+  };
+
+  if (0 < nbTasks) {
+    progress->values = (unsigned *) calloc(nbTasks, sizeof(unsigned));
+    if (NULL == progress->values)
+      LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+  }
+
+#if !defined(DISABLE_THREADS)
+  if (0 != pthread_mutex_init(&progress->mutex, NULL))
+    LIBBLU_ERROR_FRETURN("Unable to create tasks progression mutex.\n");
+  if (0 != pthread_cond_init(&progress->updated, NULL)) {
+    pthread_mutex_destroy(&progress->mutex);
+    LIBBLU_ERROR_FRETURN("Unable to create tasks progression condition.\n");
+  }
+#endif
+
+  return 0;
+
+#if !defined(DISABLE_THREADS)
+free_return:
+  free(progress->values);
+  progress->values = NULL;
+  return -1;
+#endif
+}
+
+void cleanTasksPoolProgress(
+  TasksPoolProgress * progress
+)
+{
+  if (NULL == progress)
+    return;
+
+#if !defined(DISABLE_THREADS)
+  pthread_cond_destroy(&progress->updated);
+  pthread_mutex_destroy(&progress->mutex);
+#endif
+  free(progress->values);
+}
+
+void setTasksPoolProgress(
+  TasksPoolProgress * progress,
+  unsigned taskIdx,
+  unsigned value
+)
+{
+  assert(NULL != progress);
+  assert(taskIdx < progress->nbTasks);
+
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_lock(&progress->mutex);
+  assert(progress->values[taskIdx] <= value);
+  progress->values[taskIdx] = value;
+  pthread_cond_broadcast(&progress->updated);
+  pthread_mutex_unlock(&progress->mutex);
+#else
+  assert(progress->values[taskIdx] <= value);
+  progress->values[taskIdx] = value;
+#endif
+}
+
+unsigned waitTasksPoolProgress(
+  TasksPoolProgress * progress,
+  unsigned taskIdx,
+  unsigned value
+)
+{
+  unsigned current;
+
+  assert(NULL != progress);
+  assert(taskIdx < progress->nbTasks);
+
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_lock(&progress->mutex);
+  while ((current = progress->values[taskIdx]) < value)
+    pthread_cond_wait(&progress->updated, &progress->mutex);
+  pthread_mutex_unlock(&progress->mutex);
+#else
+  /* Tasks are processed sequentially, awaited one is completed */
+  current = progress->values[taskIdx];
+  assert(value <= current);
+#endif
+
+  return current;
+}
@@ -0,0 +1,134 @@
+/** \~english
+ * \file tasksPool.h
+ *
+ * \author Massimo "Masstock" EYNARD
+ * \version 0.5
+ *
+ * \brief Independent tasks parallel processing module.
+ *
+ * Tasks are identified by their index and dispatched in increasing order
+ * to a set of worker threads (the calling thread being one of them).
+ * Processing results shall be stored by tasks in distinct per-index
+ * locations, their merging is left to the caller once all tasks are
+ * completed, allowing deterministic results whatever the scheduling.
+ *
+ * Tasks may depend on the progression of lower index tasks, reported and
+ * awaited using a #TasksPoolProgress. Since tasks are dispatched in
+ * increasing order, an awaited task is always already started.
+ *
+ * If the program is compiled without threads support (DISABLE_THREADS),
+ * tasks are processed sequentially by the calling thread.
+ */
+
+#ifndef __LIBBLU_MUXER__UTIL__TASKS_POOL_H__
+#define __LIBBLU_MUXER__UTIL__TASKS_POOL_H__
+
+#include "common.h"
+#include "errorCodes.h"
+
+#if !defined(DISABLE_THREADS)
+#  include <pthread.h>
+#endif
+
+/** \~english
+ * \brief Task processing function.
+ *
+ * \param arg Caller supplied argument, shared by all tasks.
+ * \param taskIdx Processed task index.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ *
+ * Function may be called concurrently for different task indexes.
+ */
+typedef int (*TasksPoolFun) (
+  void * arg,
+  unsigned taskIdx
+);
+
+/** \~english
+ * \brief Process a set of independent tasks.
+ *
+ * \param fun Task processing function.
+ * \param arg Argument supplied to each function call.
+ * \param nbTasks Number of tasks, indexed from 0 to nbTasks-1.
+ * \param nbThreads Maximum number of threads used, including the calling
+ * one. If zero, the number of online processors is used.
+ * \return int Upon success, a zero value is returned. Otherwise, if at least
+ * one task failed, a negative value is returned.
+ *
+ * After a task failure, remaining non-started tasks are skipped.
+ */
+int processTasksPool(
+  TasksPoolFun fun,
+  void * arg,
+  unsigned nbTasks,
+  unsigned nbThreads
+);
+
+/* ### Tasks progression : ################################################# */
+
+/** \~english
+ * \brief Tasks progression tracker.
+ *
+ * Each task owns a monotonically increasing progression value, set by the
+ * task itself and awaited by following ones.
+ */
+typedef struct {
+  unsigned * values;  /**< Per-task progression values.                     */
+  unsigned nbTasks;   /**< Number of tracked tasks.                          */
+
+#if !defined(DISABLE_THREADS)
+  pthread_mutex_t mutex;
+  pthread_cond_t updated;
+#endif
+} TasksPoolProgress;
+
+/** \~english
+ * \brief Initialize a tasks progression tracker.
+ *
+ * \param progress Initialized object.
+ * \param nbTasks Number of tracked tasks, all progressions being set to 0.
+ * \return int Upon success, a zero value is returned. Otherwise, a negative
+ * value is returned.
+ */
+int initTasksPoolProgress(
+  TasksPoolProgress * progress,
+  unsigned nbTasks
+);
+
+void cleanTasksPoolProgress(
+  TasksPoolProgress * progress
+);
+
+/** \~english
+ * \brief Update the progression of a task.
+ *
+ * \param progress Used tracker.
+ * \param taskIdx Updated task index.
+ * \param value New progression value, shall not be lower than previous.
+ */
+void setTasksPoolProgress(
+  TasksPoolProgress * progress,
+  unsigned taskIdx,
+  unsigned value
+);
+
+/** \~english
+ * \brief Wait until a task progression reaches given value.
+ *
+ * \param progress Used tracker.
+ * \param taskIdx Awaited task index.
+ * \param value Minimal awaited progression value.
+ * \return unsigned Awaited task current progression value, at least equal
+ * to value.
+ *
+ * Awaited task shall always be able to reach the value, even on failure,
+ * otherwise the calling task is blocked forever.
+ */
+unsigned waitTasksPoolProgress(
+  TasksPoolProgress * progress,
+  unsigned taskIdx,
+  unsigned value
+);
+
+#endif
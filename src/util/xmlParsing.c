@@ -901,6 +901,179 @@ int getIfExistsUnsignedFromExprIgsXmlFile(
   return ret;
 }
 
+/* ### Nodes walking : ##################################################### */
+
+static bool isNamedElementNode(
+  const xmlNodePtr node,
+  const char * name
+)
+{
+  if (XML_ELEMENT_NODE != node->type)
+    return false;
+  return NULL == name || xmlStrEqual(node->name, (const xmlChar *) name);
+}
+
+xmlNodePtr getChildNodeIgsXmlFile(
+  const xmlNodePtr node,
+  const char * name
+)
+{
+  xmlNodePtr child;
+
+  if (NULL == node)
+    return NULL;
+
+  for (child = node->children; NULL != child; child = child->next) {
+    if (isNamedElementNode(child, name))
+      return child;
+  }
+
+  return NULL;
+}
+
+xmlNodePtr getNextSiblingNodeIgsXmlFile(
+  const xmlNodePtr node,
+  const char * name
+)
+{
+  xmlNodePtr sibling;
+
+  assert(NULL != node);
+
+  for (sibling = node->next; NULL != sibling; sibling = sibling->next) {
+    if (isNamedElementNode(sibling, name))
+      return sibling;
+  }
+
+  return NULL;
+}
+
+unsigned getNbChildNodesIgsXmlFile(
+  const xmlNodePtr node,
+  const char * name
+)
+{
+  xmlNodePtr child;
+  unsigned nb;
+
+  nb = 0;
+  child = getChildNodeIgsXmlFile(node, name);
+  for (; NULL != child; child = getNextSiblingNodeIgsXmlFile(child, name))
+    nb++;
+
+  return nb;
+}
+
+int getIfExistsStringFromNodeIgsXmlFile(
+  XmlCtxPtr ctx,
+  const xmlNodePtr node,
+  xmlChar ** string,
+  const xmlChar * def,
+  const char * field
+)
+{
+  xmlNodePtr child;
+
+  *string = NULL;
+
+  if (NULL != node && '@' == field[0]) {
+    /* Attribute value */
+    if (NULL != (*string = xmlGetProp(node, (const xmlChar *) &field[1]))) {
+      ctx->lastParsedNodeLine = node->line;
+      return 0;
+    }
+  }
+  else if (NULL != (child = getChildNodeIgsXmlFile(node, field))) {
+    /* Child element value */
+    ctx->lastParsedNodeLine = child->line;
+    *string = xmlNodeListGetString(child->doc, child->children, XML_TRUE);
+    return 0; /* Empty elements values are NULL, as with XPath requests */
+  }
+
+  /* Copy default string: */
+  if (NULL != def && NULL == (*string = xmlStrdup(def)))
+    LIBBLU_ERROR_RETURN("Memory allocation error.\n");
+
+  return 0;
+}
+
+int getIfExistsBooleanFromNodeIgsXmlFile(
+  XmlCtxPtr ctx,
+  const xmlNodePtr node,
+  bool * dst,
+  bool def,
+  const char * field
+)
+{
+  xmlChar * string;
+
+  if (getIfExistsStringFromNodeIgsXmlFile(ctx, node, &string, NULL, field) < 0)
+    return -1;
+
+  if (NULL == string)
+    *dst = def; /* Does not exists */
+  else {
+    if (xmlStrEqual(string, (xmlChar *) "true"))
+      *dst = true;
+    else if (xmlStrEqual(string, (xmlChar *) "false"))
+      *dst = false;
+    else {
+      LIBBLU_ERROR(
+        "Unable to parse XML node value '%s' from field '%s' as a boolean "
+        "value (expect 'true' or 'false', line: %u).\n",
+        (char *) string,
+        field,
+        ctx->lastParsedNodeLine
+      );
+      xmlFree(string);
+      return -1;
+    }
+  }
+
+  xmlFree(string);
+  return 0;
+}
+
+int getIfExistsUint64FromNodeIgsXmlFile(
+  XmlCtxPtr ctx,
+  const xmlNodePtr node,
+  uint64_t * dst,
+  uint64_t def,
+  const char * field
+)
+{
+  xmlChar * string;
+
+  if (getIfExistsStringFromNodeIgsXmlFile(ctx, node, &string, NULL, field) < 0)
+    return -1;
+
+  if (NULL == string)
+    *dst = def; /* Does not exists */
+  else {
+    unsigned long long value;
+    char * end;
+
+    value = strtoull((char *) string, &end, 0);
+
+    if (NULL == end || '\0' != *end) {
+      LIBBLU_ERROR(
+        "Unable to parse XML node value '%s' from field '%s' as an integer "
+        "(line: %u).\n",
+        (char *) string,
+        field,
+        ctx->lastParsedNodeLine
+      );
+      xmlFree(string);
+      return -1;
+    }
+
+    *dst = value;
+  }
+
+  xmlFree(string);
+  return 0;
+}
+
 /* ######################################################################### */
 
 void printNbObjectsFromExprErrorIgsXmlFile(
@@ -612,6 +612,105 @@ int getIfExistsUnsignedFromExprIgsXmlFile(
   ...
 );
 
+/* ### Nodes walking : ##################################################### */
+
+/** \~english
+ * \brief Return first child element of given name.
+ *
+ * \param node Parent node (can be NULL).
+ * \param name Child element name, or NULL to match any element.
+ * \return xmlNodePtr Child element (or NULL pointer if none).
+ *
+ * Unlike XPath expressions, node walking functions only visit direct
+ * children of given node and do not modify the document tree.
+ */
+xmlNodePtr getChildNodeIgsXmlFile(
+  const xmlNodePtr node,
+  const char * name
+);
+
+/** \~english
+ * \brief Return next sibling element of given name.
+ *
+ * \param node Current node.
+ * \param name Sibling element name, or NULL to match any element.
+ * \return xmlNodePtr Sibling element (or NULL pointer if none).
+ */
+xmlNodePtr getNextSiblingNodeIgsXmlFile(
+  const xmlNodePtr node,
+  const char * name
+);
+
+/** \~english
+ * \brief Return the number of child elements of given name.
+ *
+ * \param node Parent node (can be NULL).
+ * \param name Child elements name, or NULL to match any element.
+ * \return unsigned Number of matching child elements.
+ */
+unsigned getNbChildNodesIgsXmlFile(
+  const xmlNodePtr node,
+  const char * name
+);
+
+/** \~english
+ * \brief Fetch a string field of given node (or use default value).
+ *
+ * \param ctx Context to use.
+ * \param node Field parent node (can be NULL, default value is then used).
+ * \param string String result of request.
+ * \param def Default string pointer used if field is absent (can be NULL).
+ * \param field Field name, either "@attribute" or "child" element value.
+ * \return int A zero value on success, otherwise a negative value.
+ *
+ * String pointer must be freed after use using #freeXmlCharPtr().
+ * Context last parsed line is updated to the field line if present.
+ */
+int getIfExistsStringFromNodeIgsXmlFile(
+  XmlCtxPtr ctx,
+  const xmlNodePtr node,
+  xmlChar ** string,
+  const xmlChar * def,
+  const char * field
+);
+
+/** \~english
+ * \brief Fetch a boolean field of given node (or use default value).
+ *
+ * \param ctx Context to use.
+ * \param node Field parent node (can be NULL, default value is then used).
+ * \param dst Boolean result destination.
+ * \param def Default value used if field is absent.
+ * \param field Field name, either "@attribute" or "child" element value.
+ * \return int A zero value on success, otherwise a negative value.
+ */
+int getIfExistsBooleanFromNodeIgsXmlFile(
+  XmlCtxPtr ctx,
+  const xmlNodePtr node,
+  bool * dst,
+  bool def,
+  const char * field
+);
+
+/** \~english
+ * \brief Fetch an unsigned 64 bits integer field of given node (or use
+ * default value).
+ *
+ * \param ctx Context to use.
+ * \param node Field parent node (can be NULL, default value is then used).
+ * \param dst Integer result destination.
+ * \param def Default value used if field is absent.
+ * \param field Field name, either "@attribute" or "child" element value.
+ * \return int A zero value on success, otherwise a negative value.
+ */
+int getIfExistsUint64FromNodeIgsXmlFile(
+  XmlCtxPtr ctx,
+  const xmlNodePtr node,
+  uint64_t * dst,
+  uint64_t def,
+  const char * field
+);
+
 /* ######################################################################### */
 
 /** \~english